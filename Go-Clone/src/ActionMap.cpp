@@ -0,0 +1,107 @@
+#include "ActionMap.h"
+
+#include <algorithm>
+
+#include "Log.h"
+
+ActionMap::ActionMap() {
+}
+
+ActionMap::~ActionMap() {
+}
+
+uint32_t ActionMap::AddAction(const std::string& name) {
+	uint32_t action = GetAction(name);
+	if (action != noAction) {
+		return action;
+	}
+	if (names.size() >= maxActions) {
+		LOG_WARNING("There's no room for the action {}.", name);
+		return noAction;
+	}
+	names.push_back(name);
+	return static_cast<uint32_t>(names.size() - 1);
+}
+
+uint32_t ActionMap::GetAction(const std::string& name) const {
+	std::vector<std::string>::const_iterator it = std::find(names.begin(), names.end(), name);
+	return it == names.end() ? noAction : static_cast<uint32_t>(it - names.begin());
+}
+
+const std::string& ActionMap::GetActionName(uint32_t action) const {
+	static const std::string none;
+	return action < names.size() ? names[action] : none;
+}
+
+void ActionMap::Bind(uint32_t action, std::initializer_list<sf::Keyboard::Key> keys, std::initializer_list<sf::Mouse::Button> buttons) {
+	if (action >= names.size()) {
+		return;
+	}
+	Binding binding;
+	binding.action = action;
+	for (sf::Keyboard::Key key : keys) {
+		if (key >= 0 && key < sf::Keyboard::Key::KeyCount) {
+			binding.keys.set(key);
+		}
+	}
+	for (sf::Mouse::Button button : buttons) {
+		if (button >= 0 && button < sf::Mouse::Button::ButtonCount) {
+			binding.buttons.set(button);
+		}
+	}
+	if (binding.keys.none() && binding.buttons.none()) {
+		LOG_WARNING("Ignoring an empty binding for {}.", names[action]);
+		return;
+	}
+	bindings.push_back(binding);
+}
+
+void ActionMap::Unbind(uint32_t action) {
+	bindings.erase(std::remove_if(bindings.begin(), bindings.end(), [action](const Binding& binding) { return binding.action == action; }), bindings.end());
+}
+
+void ActionMap::Evaluate(const Input& input) {
+	const Input::KeySet& keys = input.GetKeys();
+	Input::KeySet keysDown = input.GetKeysDown();
+	const Input::ButtonSet& buttons = input.GetMouseButtons();
+	const Input::ButtonSet& buttonsDown = input.GetMouseButtonsDown();
+	// Anything that went down during the update counts as touched, even if it was let go again, so taps aren't missed.
+	Input::KeySet keysTouched = keys | keysDown;
+	Input::ButtonSet buttonsTouched = buttons | buttonsDown;
+
+	// The actions held last update are kept from the last call, rather than worked out again from the input before.
+	ActionSet wasHeld = held;
+	held.reset();
+	down.reset();
+	for (const Binding& binding : bindings) {
+		bool touched = (keysTouched & binding.keys) == binding.keys && (buttonsTouched & binding.buttons) == binding.buttons;
+		if (!touched) {
+			continue;
+		}
+		if ((keys & binding.keys) == binding.keys && (buttons & binding.buttons) == binding.buttons) {
+			held.set(binding.action);
+		}
+		// A binding starts when the last of its parts goes down, so holding Ctrl and then pressing F starts Ctrl + F, but holding
+		// both doesn't keep starting it.
+		if ((keysDown & binding.keys).any() || (buttonsDown & binding.buttons).any()) {
+			down.set(binding.action);
+		}
+	}
+	up = (wasHeld | down) & ~held;
+}
+
+bool ActionMap::IsActionDown(uint32_t action) const {
+	return action < maxActions && down[action];
+}
+
+bool ActionMap::IsActionUp(uint32_t action) const {
+	return action < maxActions && up[action];
+}
+
+bool ActionMap::IsAction(uint32_t action) const {
+	return action < maxActions && held[action];
+}
+
+const ActionMap::ActionSet& ActionMap::GetActionsDown() const {
+	return down;
+}
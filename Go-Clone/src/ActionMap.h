@@ -0,0 +1,122 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "Input.h"
+
+/// <summary>
+/// Turns raw input into named actions, so gameplay asks whether "ToggleFullscreen" happened rather than which key it's on.
+/// Each binding is compiled into a mask of keys and a mask of mouse buttons that must all be held, which covers single keys, chords
+/// (Ctrl + F) and clicks alike. Every binding is checked once per frame in Evaluate(), and the results are kept as one bit per
+/// action, so a query is a single bit test however many components ask.
+/// </summary>
+class ActionMap {
+	public:
+	/// <summary>
+	/// The most actions a map can hold.
+	/// </summary>
+	static const uint32_t maxActions = 64;
+
+	/// <summary>
+	/// Returned by GetAction() for a name that hasn't been added.
+	/// </summary>
+	static const uint32_t noAction = maxActions;
+
+	/// <summary>
+	/// One bit per action.
+	/// </summary>
+	typedef std::bitset<maxActions> ActionSet;
+
+	ActionMap();
+	~ActionMap();
+
+	/// <summary>
+	/// Adds an action. Adding a name that's already there gives back the same action.
+	/// </summary>
+	/// <param name="name">The name of the action.</param>
+	/// <returns>The ID of the action, or noAction if the map is full.</returns>
+	uint32_t AddAction(const std::string& name);
+
+	/// <summary>
+	/// Looks up an action by name. Components should do this once when they wake up and keep the ID.
+	/// </summary>
+	/// <param name="name">The name of the action.</param>
+	/// <returns>The ID of the action, or noAction if there isn't one by that name.</returns>
+	uint32_t GetAction(const std::string& name) const;
+
+	/// <summary>
+	/// Returns the name an action was added with.
+	/// </summary>
+	/// <param name="action">The ID of the action.</param>
+	/// <returns>The name of the action.</returns>
+	const std::string& GetActionName(uint32_t action) const;
+
+	/// <summary>
+	/// Binds an action to a set of keys and mouse buttons that must all be held together. An action can have any number of bindings,
+	/// and happens if any of them do.
+	/// </summary>
+	/// <param name="action">The ID of the action.</param>
+	/// <param name="keys">The keys in the binding.</param>
+	/// <param name="buttons">The mouse buttons in the binding.</param>
+	void Bind(uint32_t action, std::initializer_list<sf::Keyboard::Key> keys, std::initializer_list<sf::Mouse::Button> buttons = {});
+
+	/// <summary>
+	/// Removes every binding of an action.
+	/// </summary>
+	/// <param name="action">The ID of the action.</param>
+	void Unbind(uint32_t action);
+
+	/// <summary>
+	/// Works out every action from the last update. This should be called once per frame, straight after Input::UpdateState().
+	/// </summary>
+	/// <param name="input">The input to read.</param>
+	void Evaluate(const Input& input);
+
+	/// <summary>
+	/// Gets whether an action started in the last update, which is when the last part of one of its bindings went down.
+	/// </summary>
+	/// <param name="action">The ID of the action.</param>
+	/// <returns>Whether the action started.</returns>
+	bool IsActionDown(uint32_t action) const;
+
+	/// <summary>
+	/// Gets whether an action stopped in the last update, including one that started and stopped within it.
+	/// </summary>
+	/// <param name="action">The ID of the action.</param>
+	/// <returns>Whether the action stopped.</returns>
+	bool IsActionUp(uint32_t action) const;
+
+	/// <summary>
+	/// Gets whether an action is held as of the last update.
+	/// </summary>
+	/// <param name="action">The ID of the action.</param>
+	/// <returns>Whether the action is held.</returns>
+	bool IsAction(uint32_t action) const;
+
+	/// <summary>
+	/// Gets every action that started in the last update.
+	/// </summary>
+	/// <returns>One bit per action.</returns>
+	const ActionSet& GetActionsDown() const;
+
+	private:
+	/// <summary>
+	/// A binding, compiled into what needs to be held for it.
+	/// </summary>
+	struct Binding {
+		Input::KeySet keys;
+		Input::ButtonSet buttons;
+		uint32_t action;
+	};
+
+	std::vector<std::string> names;
+	std::vector<Binding> bindings;
+
+	ActionSet held;
+	ActionSet down;
+	ActionSet up;
+};
@@ -0,0 +1,43 @@
+#include "Asset.h"
+
+Asset::Asset(const std::string& path, EType type) : path(path), type(type), state(EQueued) {
+	width = 0;
+	height = 0;
+	format = Texture::ERGBA;
+}
+
+Asset::~Asset() {
+}
+
+const std::string& Asset::GetPath() const {
+	return path;
+}
+
+Asset::EType Asset::GetType() const {
+	return type;
+}
+
+Asset::EState Asset::GetState() const {
+	return static_cast<EState>(state.load());
+}
+
+bool Asset::IsReady() const {
+	return GetState() == EReady;
+}
+
+bool Asset::HasFailed() const {
+	return GetState() == EFailed;
+}
+
+std::shared_ptr<Mesh> Asset::GetMesh() const {
+	return IsReady() ? mesh : nullptr;
+}
+
+std::shared_ptr<Texture> Asset::GetTexture() const {
+	return IsReady() ? texture : nullptr;
+}
+
+const std::vector<uint8_t>& Asset::GetFontData() const {
+	static const std::vector<uint8_t> empty;
+	return IsReady() ? fontData : empty;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+#include "Texture.h"
+
+/// <summary>
+/// Something loaded from disk by the AssetLoader. Assets are shared between everything that asks for the same path, and are dropped
+/// once nothing holds them any more. Nothing can be read from an asset until IsReady() returns true, since it's being decoded on
+/// another thread (and then uploaded on the render thread) until then.
+/// </summary>
+class Asset {
+	public:
+	/// <summary>
+	/// What kind of file the asset is.
+	/// </summary>
+	enum EType {
+		/// <summary>
+		/// A Wavefront OBJ mesh. Only positions, normals and faces are read.
+		/// </summary>
+		EMesh,
+		/// <summary>
+		/// A binary PPM (RGB) or PGM (greyscale) image.
+		/// </summary>
+		ETexture,
+		/// <summary>
+		/// A font file. It's only read into memory here; the glyphs are made from it later.
+		/// </summary>
+		EFont
+	};
+
+	/// <summary>
+	/// How far along loading is.
+	/// </summary>
+	enum EState {
+		/// <summary>
+		/// Waiting for a loading thread.
+		/// </summary>
+		EQueued,
+		/// <summary>
+		/// Being read and decoded on a loading thread.
+		/// </summary>
+		EDecoding,
+		/// <summary>
+		/// Decoded, and waiting for its turn to be uploaded on the render thread.
+		/// </summary>
+		EDecoded,
+		/// <summary>
+		/// Loaded and uploaded, so it can be used.
+		/// </summary>
+		EReady,
+		/// <summary>
+		/// The file couldn't be read or decoded. It stays this way.
+		/// </summary>
+		EFailed
+	};
+
+	/// <summary>
+	/// Creates an asset that hasn't been loaded. Use AssetLoader::Load() rather than making these directly.
+	/// </summary>
+	/// <param name="path">The path of the file.</param>
+	/// <param name="type">What kind of file it is.</param>
+	Asset(const std::string& path, EType type);
+	~Asset();
+
+	Asset(const Asset&) = delete;
+	Asset& operator=(const Asset&) = delete;
+
+	/// <summary>
+	/// Returns the path of the file.
+	/// </summary>
+	/// <returns>The path of the file.</returns>
+	const std::string& GetPath() const;
+
+	/// <summary>
+	/// Returns what kind of file the asset is.
+	/// </summary>
+	/// <returns>What kind of file the asset is.</returns>
+	EType GetType() const;
+
+	/// <summary>
+	/// Returns how far along loading is.
+	/// </summary>
+	/// <returns>How far along loading is.</returns>
+	EState GetState() const;
+
+	/// <summary>
+	/// Returns whether the asset can be used.
+	/// </summary>
+	/// <returns>Whether the asset can be used.</returns>
+	bool IsReady() const;
+
+	/// <summary>
+	/// Returns whether the asset failed to load.
+	/// </summary>
+	/// <returns>Whether the asset failed to load.</returns>
+	bool HasFailed() const;
+
+	/// <summary>
+	/// Returns the mesh, if this is a mesh asset.
+	/// </summary>
+	/// <returns>The mesh, or nullptr if it isn't ready or isn't a mesh.</returns>
+	std::shared_ptr<Mesh> GetMesh() const;
+
+	/// <summary>
+	/// Returns the texture, if this is a texture asset.
+	/// </summary>
+	/// <returns>The texture, or nullptr if it isn't ready or isn't a texture.</returns>
+	std::shared_ptr<Texture> GetTexture() const;
+
+	/// <summary>
+	/// Returns the contents of the font file, if this is a font asset.
+	/// </summary>
+	/// <returns>The font file, which is empty if it isn't ready or isn't a font.</returns>
+	const std::vector<uint8_t>& GetFontData() const;
+
+	private:
+	friend class AssetLoader;
+
+	std::string path;
+	EType type;
+
+	/// <summary>
+	/// The current EState. Everything below is written before this moves on, so it's safe to read once this says so.
+	/// </summary>
+	std::atomic<int> state;
+
+	std::shared_ptr<Mesh> mesh;
+	std::shared_ptr<Texture> texture;
+	std::vector<uint8_t> fontData;
+
+	/// <summary>
+	/// What the loading thread decoded. The mesh or texture is made from this on the render thread, which then takes it over.
+	/// </summary>
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	uint32_t width;
+	uint32_t height;
+	Texture::EFormat format;
+	std::vector<uint8_t> pixels;
+};
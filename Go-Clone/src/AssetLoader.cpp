@@ -0,0 +1,363 @@
+#include "AssetLoader.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+#include <glm/geometric.hpp>
+
+#include "Log.h"
+
+/// <summary>
+/// Skips spaces and tabs, but not the end of the line.
+/// </summary>
+static void SkipSpaces(const char*& cursor, const char* end) {
+	while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+		++cursor;
+	}
+}
+
+/// <summary>
+/// Reads the next word on the line into the buffer, which is always null terminated. Mapped files aren't, so strtof() and the like
+/// can't be pointed at them directly.
+/// </summary>
+static bool ReadWord(const char*& cursor, const char* end, char* buffer, size_t bufferSize) {
+	SkipSpaces(cursor, end);
+	size_t length = 0;
+	while (cursor < end && !std::isspace(static_cast<unsigned char>(*cursor))) {
+		if (length + 1 < bufferSize) {
+			buffer[length++] = *cursor;
+		}
+		++cursor;
+	}
+	buffer[length] = '\0';
+	return length != 0;
+}
+
+static bool ReadFloat(const char*& cursor, const char* end, float& value) {
+	char buffer[64];
+	if (!ReadWord(cursor, end, buffer, sizeof(buffer))) {
+		return false;
+	}
+	char* parsedEnd;
+	value = std::strtof(buffer, &parsedEnd);
+	return parsedEnd != buffer;
+}
+
+/// <summary>
+/// Moves to the start of the next line.
+/// </summary>
+static void NextLine(const char*& cursor, const char* end) {
+	while (cursor < end && *cursor != '\n') {
+		++cursor;
+	}
+	if (cursor < end) {
+		++cursor;
+	}
+}
+
+/// <summary>
+/// Turns an OBJ index (which starts at 1, or counts back from the end if negative) into one that starts at 0.
+/// </summary>
+static bool ResolveIndex(long index, size_t count, uint32_t& resolved) {
+	long value = index > 0 ? index - 1 : static_cast<long>(count) + index;
+	if (index == 0 || value < 0 || value >= static_cast<long>(count)) {
+		return false;
+	}
+	resolved = static_cast<uint32_t>(value);
+	return true;
+}
+
+AssetLoader::AssetLoader(size_t threadCount) {
+	decoding = 0;
+	stopping = false;
+	if (threadCount == 0) {
+		threadCount = 1;
+	}
+	for (size_t i = 0; i < threadCount; ++i) {
+		threads.push_back(std::thread(&AssetLoader::Work, this));
+	}
+}
+
+AssetLoader::~AssetLoader() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+std::shared_ptr<Asset> AssetLoader::Load(const std::string& path, Asset::EType type) {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::weak_ptr<Asset>& cached = assets[path];
+	std::shared_ptr<Asset> asset = cached.lock();
+	if (asset != nullptr) {
+		if (asset->GetType() != type) {
+			LOG_WARNING("{} is already loaded as a different kind of asset.", path);
+		}
+		return asset;
+	}
+
+	asset = std::make_shared<Asset>(path, type);
+	cached = asset;
+	decodeQueue.push_back(asset);
+	wake.notify_one();
+	return asset;
+}
+
+size_t AssetLoader::UploadPending(size_t byteBudget) {
+	size_t ready = 0;
+	size_t uploaded = 0;
+	while (true) {
+		std::shared_ptr<Asset> asset;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (uploadQueue.empty() || (ready != 0 && uploaded >= byteBudget)) {
+				break;
+			}
+			asset = uploadQueue.front().lock();
+			uploadQueue.pop_front();
+		}
+		if (asset == nullptr) {
+			continue;
+		}
+
+		if (asset->GetType() == Asset::EMesh) {
+			asset->mesh = std::make_shared<Mesh>(asset->vertices, asset->indices);
+			asset->mesh->Prepare();
+			uploaded += asset->mesh->GetUploadSize();
+		} else if (asset->GetType() == Asset::ETexture) {
+			asset->texture = std::make_shared<Texture>(asset->width, asset->height, asset->format, asset->pixels);
+			asset->texture->Prepare();
+			uploaded += asset->pixels.size();
+		}
+		// The mesh or texture keeps its own copy now.
+		std::vector<Vertex>().swap(asset->vertices);
+		std::vector<uint32_t>().swap(asset->indices);
+		std::vector<uint8_t>().swap(asset->pixels);
+		asset->state = Asset::EReady;
+		++ready;
+	}
+	return ready;
+}
+
+size_t AssetLoader::GetPendingCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return decodeQueue.size() + decoding + uploadQueue.size();
+}
+
+void AssetLoader::Work() {
+	while (true) {
+		std::shared_ptr<Asset> asset;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this]() {
+				return stopping || !decodeQueue.empty();
+			});
+			if (stopping) {
+				return;
+			}
+			asset = decodeQueue.front().lock();
+			decodeQueue.pop_front();
+			if (asset == nullptr) {
+				continue;
+			}
+			++decoding;
+		}
+
+		asset->state = Asset::EDecoding;
+		bool decoded = false;
+		{
+			MappedFile file(asset->GetPath());
+			if (!file.IsOpen()) {
+				LOG_ERROR("Couldn't open {}.", asset->GetPath());
+			} else if (!Decode(*asset, file)) {
+				LOG_ERROR("Couldn't read {}.", asset->GetPath());
+			} else {
+				decoded = true;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		--decoding;
+		if (decoded) {
+			asset->state = Asset::EDecoded;
+			uploadQueue.push_back(asset);
+		} else {
+			std::vector<Vertex>().swap(asset->vertices);
+			std::vector<uint32_t>().swap(asset->indices);
+			std::vector<uint8_t>().swap(asset->pixels);
+			asset->state = Asset::EFailed;
+		}
+	}
+}
+
+bool AssetLoader::Decode(Asset& asset, const MappedFile& file) {
+	const char* begin = reinterpret_cast<const char*>(file.GetData());
+	const char* end = begin + file.GetSize();
+	switch (asset.GetType()) {
+		case Asset::EMesh:
+			return DecodeMesh(asset, begin, end);
+		case Asset::ETexture:
+			return DecodeTexture(asset, begin, end);
+		case Asset::EFont:
+			asset.fontData.assign(file.GetData(), file.GetData() + file.GetSize());
+			return !asset.fontData.empty();
+	}
+	return false;
+}
+
+bool AssetLoader::DecodeMesh(Asset& asset, const char* begin, const char* end) {
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3> normals;
+	std::vector<Vertex>& vertices = asset.vertices;
+	std::vector<uint32_t>& indices = asset.indices;
+	// Each distinct pair of position and normal becomes one vertex. A missing normal is stored as 0 and filled in at the end.
+	std::unordered_map<uint64_t, uint32_t> vertexLookup;
+	bool anyMissingNormals = false;
+
+	std::vector<uint32_t> face;
+	const char* cursor = begin;
+	while (cursor < end) {
+		char keyword[8];
+		if (!ReadWord(cursor, end, keyword, sizeof(keyword))) {
+			NextLine(cursor, end);
+			continue;
+		}
+
+		if (std::strcmp(keyword, "v") == 0 || std::strcmp(keyword, "vn") == 0) {
+			glm::vec3 value;
+			if (!ReadFloat(cursor, end, value.x) || !ReadFloat(cursor, end, value.y) || !ReadFloat(cursor, end, value.z)) {
+				return false;
+			}
+			(keyword[1] == 'n' ? normals : positions).push_back(value);
+		} else if (std::strcmp(keyword, "f") == 0) {
+			face.clear();
+			char corner[64];
+			while (ReadWord(cursor, end, corner, sizeof(corner))) {
+				// Corners are position, position/uv, position//normal or position/uv/normal.
+				char* part = corner;
+				uint32_t position;
+				if (!ResolveIndex(std::strtol(part, &part, 10), positions.size(), position)) {
+					return false;
+				}
+				uint32_t normal = 0;
+				bool hasNormal = false;
+				if (*part == '/') {
+					++part;
+					std::strtol(part, &part, 10);
+					if (*part == '/') {
+						++part;
+						hasNormal = ResolveIndex(std::strtol(part, &part, 10), normals.size(), normal);
+					}
+				}
+
+				uint64_t key = (static_cast<uint64_t>(position) << 32) | (hasNormal ? normal + 1 : 0);
+				auto found = vertexLookup.find(key);
+				if (found == vertexLookup.end()) {
+					found = vertexLookup.insert(std::make_pair(key, static_cast<uint32_t>(vertices.size()))).first;
+					vertices.push_back(Vertex{positions[position], hasNormal ? normals[normal] : glm::vec3(0.0f)});
+				}
+				anyMissingNormals = anyMissingNormals || !hasNormal;
+				face.push_back(found->second);
+			}
+			for (size_t i = 2; i < face.size(); ++i) {
+				indices.insert(indices.end(), {face[0], face[i - 1], face[i]});
+			}
+		}
+		// Anything else (texture coordinates, groups, materials) isn't used.
+		NextLine(cursor, end);
+	}
+
+	if (indices.empty()) {
+		return false;
+	}
+
+	if (anyMissingNormals) {
+		// The face normals are summed unnormalised, so bigger faces count for more.
+		std::vector<bool> missing(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			missing[i] = vertices[i].normal == glm::vec3(0.0f);
+		}
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			glm::vec3 a = vertices[indices[i]].position;
+			glm::vec3 faceNormal = glm::cross(vertices[indices[i + 1]].position - a, vertices[indices[i + 2]].position - a);
+			for (size_t corner = 0; corner < 3; ++corner) {
+				if (missing[indices[i + corner]]) {
+					vertices[indices[i + corner]].normal += faceNormal;
+				}
+			}
+		}
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			if (missing[i] && vertices[i].normal != glm::vec3(0.0f)) {
+				vertices[i].normal = glm::normalize(vertices[i].normal);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool AssetLoader::DecodeTexture(Asset& asset, const char* begin, const char* end) {
+	const char* cursor = begin;
+	char word[16];
+	if (!ReadWord(cursor, end, word, sizeof(word)) || (std::strcmp(word, "P6") != 0 && std::strcmp(word, "P5") != 0)) {
+		return false;
+	}
+	bool colour = word[1] == '6';
+
+	// The header is the width, height and largest value, with comments allowed anywhere between them.
+	unsigned long header[3];
+	for (int i = 0; i < 3; ++i) {
+		while (true) {
+			while (cursor < end && std::isspace(static_cast<unsigned char>(*cursor))) {
+				++cursor;
+			}
+			if (cursor < end && *cursor == '#') {
+				NextLine(cursor, end);
+			} else {
+				break;
+			}
+		}
+		if (!ReadWord(cursor, end, word, sizeof(word))) {
+			return false;
+		}
+		header[i] = std::strtoul(word, nullptr, 10);
+	}
+	// Exactly one whitespace character comes before the pixels.
+	++cursor;
+
+	uint32_t width = static_cast<uint32_t>(header[0]);
+	uint32_t height = static_cast<uint32_t>(header[1]);
+	size_t channels = colour ? 3 : 1;
+	if (width == 0 || height == 0 || header[2] == 0 || header[2] > 255 || cursor > end
+		|| static_cast<size_t>(end - cursor) < static_cast<size_t>(width) * height * channels) {
+		return false;
+	}
+
+	// The file goes from the top row down, but textures go from the bottom up. Colour images get an opaque alpha channel too.
+	size_t pixelSize = colour ? 4 : 1;
+	std::vector<uint8_t>& pixels = asset.pixels;
+	pixels.resize(static_cast<size_t>(width) * height * pixelSize);
+	const uint8_t* source = reinterpret_cast<const uint8_t*>(cursor);
+	for (uint32_t row = 0; row < height; ++row) {
+		const uint8_t* sourceRow = source + static_cast<size_t>(height - 1 - row) * width * channels;
+		uint8_t* destinationRow = &pixels[static_cast<size_t>(row) * width * pixelSize];
+		for (uint32_t x = 0; x < width; ++x) {
+			for (size_t channel = 0; channel < channels; ++channel) {
+				destinationRow[x * pixelSize + channel] = static_cast<uint8_t>(sourceRow[x * channels + channel] * 255 / header[2]);
+			}
+			if (colour) {
+				destinationRow[x * pixelSize + 3] = 255;
+			}
+		}
+	}
+	asset.width = width;
+	asset.height = height;
+	asset.format = colour ? Texture::ERGBA : Texture::ESingleChannel;
+	return true;
+}
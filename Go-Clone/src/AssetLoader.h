@@ -0,0 +1,122 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Asset.h"
+#include "MappedFile.h"
+
+/// <summary>
+/// Loads assets in the background. Files are mapped and decoded on loading threads, and the decoded data is handed back to the render
+/// thread, which uploads a limited amount each frame so that a burst of loading doesn't cause a long frame.
+/// Asking for a path that's already loaded (or loading) gives back the same asset.
+/// </summary>
+class AssetLoader {
+	public:
+	/// <summary>
+	/// Starts the loading threads.
+	/// </summary>
+	/// <param name="threadCount">How many loading threads to run. At least one is always started.</param>
+	AssetLoader(size_t threadCount = 1);
+	~AssetLoader();
+
+	AssetLoader(const AssetLoader&) = delete;
+	AssetLoader& operator=(const AssetLoader&) = delete;
+
+	/// <summary>
+	/// The number of bytes UploadPending() sends per frame if it isn't told otherwise.
+	/// </summary>
+	static const size_t defaultUploadBudget = 4 * 1024 * 1024;
+
+	/// <summary>
+	/// Returns the asset for the given path, queueing it to be loaded if nothing has it already.
+	/// </summary>
+	/// <param name="path">The path of the file.</param>
+	/// <param name="type">What kind of file it is. If the path is already loaded as something else, the other asset is given back.</param>
+	/// <returns>The shared asset. This isn't usable until IsReady() returns true.</returns>
+	std::shared_ptr<Asset> Load(const std::string& path, Asset::EType type);
+
+	/// <summary>
+	/// Uploads decoded assets until the given number of bytes have been sent. This should be called once per frame on the render thread.
+	/// At least one asset is always uploaded if any are waiting, so an asset bigger than the budget still gets through.
+	/// </summary>
+	/// <param name="byteBudget">Roughly how many bytes to upload.</param>
+	/// <returns>How many assets became ready.</returns>
+	size_t UploadPending(size_t byteBudget = defaultUploadBudget);
+
+	/// <summary>
+	/// Returns how many assets haven't finished loading, including those waiting to be uploaded.
+	/// </summary>
+	/// <returns>How many assets haven't finished loading.</returns>
+	size_t GetPendingCount() const;
+
+	private:
+	/// <summary>
+	/// What each loading thread runs until the loader is destroyed.
+	/// </summary>
+	void Work();
+
+	/// <summary>
+	/// Decodes the given file into the asset, depending on its type. Only CPU data is made here; the mesh or texture itself is made
+	/// when it's uploaded, so that everything on the graphics card belongs to the render thread.
+	/// </summary>
+	/// <param name="asset">The asset to fill in.</param>
+	/// <param name="file">The mapped file.</param>
+	/// <returns>Whether the file could be decoded.</returns>
+	static bool Decode(Asset& asset, const MappedFile& file);
+
+	/// <summary>
+	/// Reads a Wavefront OBJ file into the asset's vertices and indices. Faces with more than three corners are split into fans,
+	/// and corners without a normal are given the average of the faces around them.
+	/// </summary>
+	static bool DecodeMesh(Asset& asset, const char* begin, const char* end);
+
+	/// <summary>
+	/// Reads a binary PPM or PGM file into the asset's pixels.
+	/// </summary>
+	static bool DecodeTexture(Asset& asset, const char* begin, const char* end);
+
+	std::vector<std::thread> threads;
+
+	/// <summary>
+	/// Guards everything below.
+	/// </summary>
+	mutable std::mutex mutex;
+
+	/// <summary>
+	/// Wakes a loading thread when something is queued, or when the loader is stopping.
+	/// </summary>
+	std::condition_variable wake;
+
+	/// <summary>
+	/// Assets waiting to be decoded. Only weak pointers are kept, so an asset nobody wants any more is skipped.
+	/// </summary>
+	std::deque<std::weak_ptr<Asset>> decodeQueue;
+
+	/// <summary>
+	/// Assets waiting to be uploaded.
+	/// </summary>
+	std::deque<std::weak_ptr<Asset>> uploadQueue;
+
+	/// <summary>
+	/// Every asset that's been asked for, by path. The loader doesn't own them, so they go away with their last user.
+	/// </summary>
+	std::map<std::string, std::weak_ptr<Asset>> assets;
+
+	/// <summary>
+	/// How many assets are being decoded right now.
+	/// </summary>
+	size_t decoding;
+
+	/// <summary>
+	/// Whether the loading threads should finish.
+	/// </summary>
+	bool stopping;
+};
@@ -0,0 +1,134 @@
+#include "BenchmarkScene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "Asset.h"
+#include "ComponentTypes.h"
+#include "GameObject.h"
+#include "Material.h"
+#include "Mesh.h"
+#include "MeshLOD.h"
+#include "MeshRenderer.h"
+#include "TextLabel.h"
+#include "Transform.h"
+
+/// <summary>
+/// Spins an object around its vertical axis at a steady rate.
+/// </summary>
+class BenchmarkSpin : public Updateable {
+	public:
+	BenchmarkSpin(GameObject* object) : Updateable(object) {}
+
+	void Update() override {
+		GetGameObject()->GetComponent<Transform>()->Rotate().y += 0.02f;
+	}
+};
+
+/// <summary>
+/// The width of the area the grid is spread over, which is about what the camera can see.
+/// </summary>
+static const float gridWidth = 3.0f;
+
+BenchmarkScene::BenchmarkScene(uint32_t objectCount, uint32_t depth, uint32_t fanOut, float animatedRatio, std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material) : objectCount(objectCount), depth(depth), fanOut(fanOut), animatedRatio(animatedRatio), mesh(mesh), material(material) {
+	labelled = false;
+	madeCount = 0;
+	animatedCount = 0;
+}
+
+BenchmarkScene::~BenchmarkScene() {
+}
+
+void BenchmarkScene::SetMeshAsset(std::shared_ptr<Asset> asset) {
+	meshAsset = asset;
+}
+
+void BenchmarkScene::SetLOD(std::shared_ptr<MeshLOD> newLOD) {
+	lod = newLOD;
+}
+
+void BenchmarkScene::SetLabelled(bool newLabelled) {
+	labelled = newLabelled;
+}
+
+void BenchmarkScene::Build() {
+	// Working out how big a full tree is tells us how many trees the grid needs.
+	uint64_t treeSize = 0;
+	uint64_t levelSize = 1;
+	for (uint32_t level = 0; level < depth && treeSize < objectCount; ++level) {
+		treeSize += levelSize;
+		levelSize *= fanOut;
+	}
+	uint32_t treeCount = static_cast<uint32_t>((objectCount + treeSize - 1) / std::max<uint64_t>(treeSize, 1));
+	uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(treeCount))));
+	float spacing = gridWidth / std::max(columns, 1u);
+
+	for (uint32_t tree = 0; tree < treeCount && madeCount < objectCount; ++tree) {
+		std::shared_ptr<GameObject> object = AddObject(nullptr);
+		std::shared_ptr<Transform> transform = object->GetComponent<Transform>();
+		transform->Translate() = glm::vec3((tree % columns + 0.5f) * spacing - gridWidth / 2.0f, (tree / columns + 0.5f) * spacing - gridWidth / 2.0f, 0.0f);
+		transform->Scale() = glm::vec3(spacing * 0.2f);
+		AddChildren(object, 0);
+	}
+}
+
+uint32_t BenchmarkScene::GetObjectCount() const {
+	return madeCount;
+}
+
+uint32_t BenchmarkScene::GetAnimatedCount() const {
+	return animatedCount;
+}
+
+std::shared_ptr<GameObject> BenchmarkScene::AddObject(std::shared_ptr<GameObject> parent) {
+	std::shared_ptr<GameObject> object = parent != nullptr ? GameObject::Create<GameObject>(parent) : GameObject::Create<GameObject>();
+	std::shared_ptr<Transform> transform = object->AddComponent<Transform>();
+	transform->Scale() = glm::vec3(1.0f);
+
+	std::shared_ptr<MeshRenderer> renderer = object->AddComponent<MeshRenderer>();
+	renderer->SetMesh(mesh);
+	renderer->SetMaterial(material);
+	if (meshAsset != nullptr) {
+		renderer->SetMeshAsset(meshAsset);
+	}
+	if (lod != nullptr) {
+		renderer->SetLOD(lod);
+	}
+	// Alternating between dark and light makes it easy to see whether everything was drawn.
+	renderer->SetColor(madeCount % 2 == 0 ? glm::vec3(0.15f) : glm::vec3(0.85f));
+
+	if (labelled) {
+		// The number sits just in front of the object, in the opposite shade so it stands out.
+		std::shared_ptr<TextLabel> label = object->AddComponent<TextLabel>();
+		label->SetText(std::to_string(madeCount + 1));
+		label->SetSize(0.8f);
+		label->SetColor(madeCount % 2 == 0 ? glm::vec4(0.9f, 0.9f, 0.9f, 1.0f) : glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
+		label->SetOffset(glm::vec3(0.0f, 0.0f, 1.05f));
+		label->SetBillboard(true);
+	}
+
+	// This spreads the animated objects evenly, rather than animating the first ones made.
+	if (std::floor((madeCount + 1) * animatedRatio) > std::floor(madeCount * animatedRatio)) {
+		object->AddComponent<BenchmarkSpin>();
+		++animatedCount;
+	}
+	++madeCount;
+	return object;
+}
+
+void BenchmarkScene::AddChildren(std::shared_ptr<GameObject> parent, uint32_t level) {
+	if (level + 1 >= depth) {
+		return;
+	}
+	const float pi = 3.14159265358979f;
+	for (uint32_t child = 0; child < fanOut && madeCount < objectCount; ++child) {
+		std::shared_ptr<GameObject> object = AddObject(parent);
+		std::shared_ptr<Transform> transform = object->GetComponent<Transform>();
+		// Children circle their parent at a smaller size, which keeps each tree about the size of its grid cell.
+		float angle = 2.0f * pi * child / fanOut;
+		transform->Translate() = glm::vec3(std::cos(angle) * 2.0f, std::sin(angle) * 2.0f, 0.0f);
+		transform->Scale() = glm::vec3(0.4f);
+		AddChildren(object, level + 1);
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+class Asset;
+class GameObject;
+class Material;
+class Mesh;
+class MeshLOD;
+
+/// <summary>
+/// Fills the scene with generated objects, so that the cost of rendering can be measured at different sizes and shapes of scene graph.
+/// The objects are laid out as a grid of trees, where every object except those on the last level has the same number of children.
+/// The same settings always make the same scene.
+/// </summary>
+class BenchmarkScene {
+	public:
+	/// <summary>
+	/// Sets up the scene to be built.
+	/// </summary>
+	/// <param name="objectCount">How many objects to make.</param>
+	/// <param name="depth">How many levels deep each tree goes. 1 means every object is on the grid.</param>
+	/// <param name="fanOut">How many children each object has.</param>
+	/// <param name="animatedRatio">The fraction of objects that spin every frame, from 0 to 1.</param>
+	/// <param name="mesh">The mesh every object draws.</param>
+	/// <param name="material">The material every object draws with.</param>
+	BenchmarkScene(uint32_t objectCount, uint32_t depth, uint32_t fanOut, float animatedRatio, std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material);
+	~BenchmarkScene();
+
+	/// <summary>
+	/// Gives every object a more detailed mesh to swap to once it's loaded. This should be called before Build().
+	/// </summary>
+	/// <param name="asset">A mesh asset.</param>
+	void SetMeshAsset(std::shared_ptr<Asset> asset);
+
+	/// <summary>
+	/// Gives every object levels of detail to pick from, instead of always drawing the mesh. This should be called before Build().
+	/// </summary>
+	/// <param name="newLOD">The levels of detail, or nullptr to always draw the mesh.</param>
+	void SetLOD(std::shared_ptr<MeshLOD> newLOD);
+
+	/// <summary>
+	/// Labels every object with its number, like the move numbers on a game record. This should be called before Build().
+	/// </summary>
+	/// <param name="newLabelled">Whether objects are labelled.</param>
+	void SetLabelled(bool newLabelled);
+
+	/// <summary>
+	/// Adds the objects to the scene, under the root object.
+	/// </summary>
+	void Build();
+
+	/// <summary>
+	/// Returns how many objects have been made.
+	/// </summary>
+	/// <returns>How many objects have been made.</returns>
+	uint32_t GetObjectCount() const;
+
+	/// <summary>
+	/// Returns how many of the objects that have been made spin every frame.
+	/// </summary>
+	/// <returns>How many objects spin.</returns>
+	uint32_t GetAnimatedCount() const;
+
+	private:
+	/// <summary>
+	/// Makes a single object. Objects are spread between animated and static evenly, in the order they're made.
+	/// </summary>
+	/// <param name="parent">The object to put it under, or nullptr for the root.</param>
+	/// <returns>The new object.</returns>
+	std::shared_ptr<GameObject> AddObject(std::shared_ptr<GameObject> parent);
+
+	/// <summary>
+	/// Makes the children of an object, and their children, until the tree is full or there are enough objects.
+	/// </summary>
+	/// <param name="parent">The object to make children for.</param>
+	/// <param name="level">The level of the parent, where 0 is the grid.</param>
+	void AddChildren(std::shared_ptr<GameObject> parent, uint32_t level);
+
+	uint32_t objectCount;
+	uint32_t depth;
+	uint32_t fanOut;
+	float animatedRatio;
+	std::shared_ptr<Mesh> mesh;
+	std::shared_ptr<Material> material;
+	std::shared_ptr<Asset> meshAsset;
+	std::shared_ptr<MeshLOD> lod;
+	bool labelled;
+
+	/// <summary>
+	/// How many objects have been made.
+	/// </summary>
+	uint32_t madeCount;
+
+	/// <summary>
+	/// How many of the objects that have been made spin.
+	/// </summary>
+	uint32_t animatedCount;
+};
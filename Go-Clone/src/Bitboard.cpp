@@ -0,0 +1,17 @@
+#include "Bitboard.h"
+
+uint32_t Bitboard::Select(uint32_t index) const {
+	for (uint32_t i = 0; i < wordCount; ++i) {
+		uint32_t count = PopCount(words[i]);
+		if (index >= count) {
+			index -= count;
+			continue;
+		}
+		uint64_t word = words[i];
+		for (; index > 0; --index) {
+			word &= word - 1;
+		}
+		return i * 64 + CountTrailingZeros(word);
+	}
+	return maxPoints;
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// One bit for every point on a board, up to 19x19. Point y * size + x is bit (y * size + x) % 64 of word (y * size + x) / 64.
+/// Every operation works a whole word at a time over a fixed number of words, so the compiler can unroll and vectorise them, and a
+/// bitboard is small enough to copy around freely. Bits past the last point on the board must always be left clear.
+/// Making and setting bits can be done when compiling, so the masks for each size of board are built into the program.
+/// </summary>
+class Bitboard {
+	public:
+	/// <summary>
+	/// The most points a bitboard can hold, which is a 19x19 board.
+	/// </summary>
+	static const uint32_t maxPoints = 361;
+
+	/// <summary>
+	/// How many words the bits are kept in.
+	/// </summary>
+	static const uint32_t wordCount = (maxPoints + 63) / 64;
+
+	/// <summary>
+	/// Makes a bitboard with every bit clear.
+	/// </summary>
+	constexpr Bitboard() : words() {}
+
+	constexpr bool Get(uint32_t point) const {
+		return (words[point >> 6] >> (point & 63)) & 1;
+	}
+
+	constexpr void Set(uint32_t point) {
+		words[point >> 6] |= uint64_t(1) << (point & 63);
+	}
+
+	constexpr void Reset(uint32_t point) {
+		words[point >> 6] &= ~(uint64_t(1) << (point & 63));
+	}
+
+	/// <summary>
+	/// Returns whether no bits are set.
+	/// </summary>
+	bool IsEmpty() const {
+		uint64_t any = 0;
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			any |= words[i];
+		}
+		return any == 0;
+	}
+
+	/// <summary>
+	/// Returns how many bits are set.
+	/// </summary>
+	uint32_t Count() const {
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			count += PopCount(words[i]);
+		}
+		return count;
+	}
+
+	/// <summary>
+	/// Returns the lowest point that's set, or maxPoints if none are.
+	/// </summary>
+	uint32_t First() const {
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			if (words[i] != 0) {
+				return i * 64 + CountTrailingZeros(words[i]);
+			}
+		}
+		return maxPoints;
+	}
+
+	/// <summary>
+	/// Returns the point of the given set bit, counting from the lowest, or maxPoints if there aren't that many.
+	/// </summary>
+	uint32_t Select(uint32_t index) const;
+
+	/// <summary>
+	/// Calls the function with every point that's set, from the lowest. Each word is scanned by clearing its lowest bit, so empty
+	/// stretches cost nothing.
+	/// </summary>
+	template <typename Function>
+	void ForEach(Function function) const {
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			uint64_t word = words[i];
+			while (word != 0) {
+				function(i * 64 + CountTrailingZeros(word));
+				word &= word - 1;
+			}
+		}
+	}
+
+	Bitboard operator&(const Bitboard& other) const {
+		Bitboard result;
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			result.words[i] = words[i] & other.words[i];
+		}
+		return result;
+	}
+
+	Bitboard operator|(const Bitboard& other) const {
+		Bitboard result;
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			result.words[i] = words[i] | other.words[i];
+		}
+		return result;
+	}
+
+	Bitboard operator^(const Bitboard& other) const {
+		Bitboard result;
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			result.words[i] = words[i] ^ other.words[i];
+		}
+		return result;
+	}
+
+	Bitboard& operator&=(const Bitboard& other) {
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			words[i] &= other.words[i];
+		}
+		return *this;
+	}
+
+	Bitboard& operator|=(const Bitboard& other) {
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			words[i] |= other.words[i];
+		}
+		return *this;
+	}
+
+	Bitboard& operator^=(const Bitboard& other) {
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			words[i] ^= other.words[i];
+		}
+		return *this;
+	}
+
+	/// <summary>
+	/// Returns the bits set here that aren't set in the other. There's no plain complement, since it would set the bits past the board.
+	/// </summary>
+	Bitboard AndNot(const Bitboard& other) const {
+		Bitboard result;
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			result.words[i] = words[i] & ~other.words[i];
+		}
+		return result;
+	}
+
+	bool operator==(const Bitboard& other) const {
+		uint64_t difference = 0;
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			difference |= words[i] ^ other.words[i];
+		}
+		return difference == 0;
+	}
+
+	bool operator!=(const Bitboard& other) const {
+		return !(*this == other);
+	}
+
+	/// <summary>
+	/// Returns whether any bit is set in both.
+	/// </summary>
+	bool Intersects(const Bitboard& other) const {
+		uint64_t any = 0;
+		for (uint32_t i = 0; i < wordCount; ++i) {
+			any |= words[i] & other.words[i];
+		}
+		return any != 0;
+	}
+
+	/// <summary>
+	/// Moves every bit up to a higher point. Bits moved past the last word are lost.
+	/// </summary>
+	/// <param name="count">How many points to move by, from 1 to 63.</param>
+	Bitboard ShiftUp(uint32_t count) const {
+		Bitboard result;
+		result.words[0] = words[0] << count;
+		for (uint32_t i = 1; i < wordCount; ++i) {
+			result.words[i] = (words[i] << count) | (words[i - 1] >> (64 - count));
+		}
+		return result;
+	}
+
+	/// <summary>
+	/// Moves every bit down to a lower point. Bits moved below point 0 are lost.
+	/// </summary>
+	/// <param name="count">How many points to move by, from 1 to 63.</param>
+	Bitboard ShiftDown(uint32_t count) const {
+		Bitboard result;
+		for (uint32_t i = 0; i + 1 < wordCount; ++i) {
+			result.words[i] = (words[i] >> count) | (words[i + 1] << (64 - count));
+		}
+		result.words[wordCount - 1] = words[wordCount - 1] >> count;
+		return result;
+	}
+
+	static uint32_t PopCount(uint64_t word) {
+#ifdef _MSC_VER
+		return static_cast<uint32_t>(__popcnt64(word));
+#else
+		return static_cast<uint32_t>(__builtin_popcountll(word));
+#endif
+	}
+
+	/// <summary>
+	/// Returns the position of the lowest set bit. The word mustn't be 0.
+	/// </summary>
+	static uint32_t CountTrailingZeros(uint64_t word) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(__builtin_ctzll(word));
+#endif
+	}
+
+	uint64_t words[wordCount];
+};
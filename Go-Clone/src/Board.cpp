@@ -0,0 +1,394 @@
+#include "Board.h"
+
+#include <utility>
+
+#include "Log.h"
+#include "Zobrist.h"
+
+std::shared_ptr<Board> Board::Create(uint32_t size) {
+	switch (size) {
+		case 9:
+			return std::make_shared<SizedBoard<9>>();
+		case 13:
+			return std::make_shared<SizedBoard<13>>();
+		case 19:
+			return std::make_shared<SizedBoard<19>>();
+		default:
+			LOG_WARNING("A {}x{} board isn't supported, using 19x19.", size, size);
+			return std::make_shared<SizedBoard<19>>();
+	}
+}
+
+Board::Board(uint32_t size, const Bitboard& onBoard) : size(size), onBoard(onBoard), hash(0) {
+}
+
+Board::~Board() {
+}
+
+template <uint32_t N>
+SizedBoard<N>::SizedBoard() : Board(N, geometry.GetPoints()) {
+	Clear();
+}
+
+template <uint32_t N>
+std::shared_ptr<Board> SizedBoard<N>::Clone() const {
+	return std::make_shared<SizedBoard<N>>(*this);
+}
+
+template <uint32_t N>
+void SizedBoard<N>::CopyFrom(const Board& other) {
+	*this = static_cast<const SizedBoard<N>&>(other);
+}
+
+template <uint32_t N>
+void SizedBoard<N>::Clear() {
+	stones[0] = Bitboard();
+	stones[1] = Bitboard();
+	points.fill(EPlayer::ENone);
+	chainOf.fill(0);
+	nextStone.fill(0);
+	chains.fill(Chain());
+	hash = 0;
+	playable[0] = geometry.GetPoints();
+	playable[1] = geometry.GetPoints();
+}
+
+template <uint32_t N>
+bool SizedBoard<N>::IsSuicide(uint32_t point, EPlayer player) const {
+	bool suicide = true;
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		EPlayer owner = points[neighbour];
+		if (owner == EPlayer::ENone) {
+			suicide = false;
+			return;
+		}
+		const Chain& chain = chains[chainOf[neighbour]];
+		bool lastLiberty = chain.IsInAtari() && chain.GetAtariPoint() == point;
+		// Joining a chain with another liberty is safe, and so is taking the last liberty of the other colour's chain.
+		if ((owner == player) != lastLiberty) {
+			suicide = false;
+		}
+	});
+	return suicide;
+}
+
+template <uint32_t N>
+bool SizedBoard<N>::IsSelfAtari(uint32_t point, EPlayer player) const {
+	// This only needs to know whether there are two liberties, so it keeps the first two it finds and stops.
+	uint32_t found[2];
+	uint32_t foundCount = 0;
+	auto addLiberty = [&](uint32_t liberty) {
+		if (liberty == point || foundCount == 2 || (foundCount == 1 && found[0] == liberty)) {
+			return;
+		}
+		found[foundCount++] = liberty;
+	};
+
+	// The chains the stone would join, so that stones captured next to them can be counted as liberties.
+	uint32_t joining[4];
+	uint32_t joiningCount = 0;
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		EPlayer owner = points[neighbour];
+		if (owner == EPlayer::ENone) {
+			addLiberty(neighbour);
+		} else if (owner == player) {
+			joining[joiningCount++] = chainOf[neighbour];
+		}
+	});
+
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		if (foundCount == 2 || points[neighbour] == player || points[neighbour] == EPlayer::ENone) {
+			return;
+		}
+		const Chain& chain = chains[chainOf[neighbour]];
+		if (!chain.IsInAtari() || chain.GetAtariPoint() != point) {
+			return;
+		}
+		// Every captured stone next to the new stone or a chain it joins becomes a liberty.
+		ForEachStone(neighbour, [&](uint32_t stone) {
+			geometry.ForEachNeighbour(stone, [&](uint32_t next) {
+				if (next == point) {
+					addLiberty(stone);
+				} else if (points[next] == player) {
+					for (uint32_t i = 0; i < joiningCount; ++i) {
+						if (chainOf[next] == joining[i]) {
+							addLiberty(stone);
+						}
+					}
+				}
+			});
+		});
+	});
+
+	for (uint32_t i = 0; i < joiningCount && foundCount < 2; ++i) {
+		if (chains[joining[i]].IsInAtari()) {
+			// Its only liberty is the point being played on.
+			continue;
+		}
+		ForEachStone(joining[i], [&](uint32_t stone) {
+			geometry.ForEachNeighbour(stone, [&](uint32_t liberty) {
+				if (points[liberty] == EPlayer::ENone) {
+					addLiberty(liberty);
+				}
+			});
+		});
+	}
+	return foundCount < 2;
+}
+
+template <uint32_t N>
+uint64_t SizedBoard<N>::GetHashAfter(uint32_t point, EPlayer player) const {
+	uint64_t after = hash ^ Zobrist::GetStoneKey(player, point);
+	EPlayer opponent = GetOpponent(player);
+	// A chain can touch the point on more than one side, but it's only taken off once.
+	uint32_t capturedChains[4];
+	uint32_t capturedCount = 0;
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		if (points[neighbour] != opponent) {
+			return;
+		}
+		uint32_t chain = chainOf[neighbour];
+		if (!chains[chain].IsInAtari() || chains[chain].GetAtariPoint() != point) {
+			return;
+		}
+		for (uint32_t i = 0; i < capturedCount; ++i) {
+			if (capturedChains[i] == chain) {
+				return;
+			}
+		}
+		capturedChains[capturedCount++] = chain;
+		ForEachStone(chain, [&](uint32_t stone) {
+			after ^= Zobrist::GetStoneKey(opponent, stone);
+		});
+	});
+	return after;
+}
+
+template <uint32_t N>
+Bitboard SizedBoard<N>::Play(uint32_t point, EPlayer player, Change& change) {
+	change.point = static_cast<uint16_t>(point);
+	change.player = player;
+	change.stepCount = 0;
+	change.previousChainOf = chainOf[point];
+	change.previousNextStone = nextStone[point];
+	change.previousChain = chains[point];
+
+	// Whether a point is suicide only depends on whether its neighbours are empty, and which of the chains next to it are in atari.
+	// So the only points that can change are those next to a stone that's come or gone, and the last liberties of chains that have
+	// gone into or out of atari.
+	Bitboard affected;
+	affected.Set(point);
+	PlaceStone(point, player);
+	uint32_t chain = point;
+	Bitboard captured;
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		affected.Set(neighbour);
+		EPlayer owner = points[neighbour];
+		if (owner == player) {
+			uint32_t other = chainOf[neighbour];
+			if (other != chain) {
+				uint32_t kept = MergeChains(chain, other);
+				change.steps[change.stepCount++] = { { static_cast<uint16_t>(kept), static_cast<uint16_t>(kept == chain ? other : chain) } };
+				chain = kept;
+			}
+		} else if (owner != EPlayer::ENone && chains[chainOf[neighbour]].pseudoLiberties == 0) {
+			change.steps[change.stepCount++] = { { chainOf[neighbour], static_cast<uint16_t>(noPoint) } };
+			RemoveChain(chainOf[neighbour], captured, affected);
+		}
+	});
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		if (points[neighbour] != EPlayer::ENone && chains[chainOf[neighbour]].IsInAtari()) {
+			affected.Set(chains[chainOf[neighbour]].GetAtariPoint());
+		}
+	});
+	UpdatePlayable(affected | captured);
+	return captured;
+}
+
+template <uint32_t N>
+void SizedBoard<N>::Undo(const Change& change) {
+	// The points taking the move back can change are the ones playing it changed, which are next to a stone that's come or gone,
+	// or the last liberty of a chain that's in atari on one side of the move or the other. The atari points are gathered here and
+	// again once the move is gone.
+	uint32_t point = change.point;
+	Bitboard affected;
+	AddAtariPoints(point, affected);
+
+	// Each step is taken back in the opposite order, so the chains are just as they were when it was taken.
+	for (uint32_t i = change.stepCount; i-- > 0;) {
+		if (change.steps[i][1] == noPoint) {
+			RestoreChain(change.steps[i][0], GetOpponent(change.player));
+		} else {
+			SplitChains(change.steps[i][0], change.steps[i][1]);
+		}
+	}
+
+	stones[static_cast<uint32_t>(change.player) - 1].Reset(point);
+	points[point] = EPlayer::ENone;
+	hash ^= Zobrist::GetStoneKey(change.player, point);
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		if (points[neighbour] != EPlayer::ENone) {
+			chains[chainOf[neighbour]].AddLiberty(point);
+		}
+	});
+	chainOf[point] = change.previousChainOf;
+	nextStone[point] = change.previousNextStone;
+	chains[point] = change.previousChain;
+
+	AddAtariPoints(point, affected);
+	for (uint32_t i = 0; i < change.stepCount; ++i) {
+		if (change.steps[i][1] == noPoint) {
+			ForEachStone(change.steps[i][0], [&](uint32_t stone) {
+				AddAtariPoints(stone, affected);
+			});
+		}
+	}
+	UpdatePlayable(affected);
+}
+
+template <uint32_t N>
+Bitboard SizedBoard<N>::GetChain(uint32_t point) const {
+	Bitboard chain;
+	if (points[point] != EPlayer::ENone) {
+		ForEachStone(point, [&chain](uint32_t stone) {
+			chain.Set(stone);
+		});
+	}
+	return chain;
+}
+
+template <uint32_t N>
+void SizedBoard<N>::PlaceStone(uint32_t point, EPlayer player) {
+	stones[static_cast<uint32_t>(player) - 1].Set(point);
+	points[point] = player;
+	hash ^= Zobrist::GetStoneKey(player, point);
+	chainOf[point] = static_cast<uint16_t>(point);
+	nextStone[point] = static_cast<uint16_t>(point);
+	Chain& chain = chains[point];
+	chain.stoneCount = 1;
+	chain.pseudoLiberties = 0;
+	chain.libertySum = 0;
+	chain.libertySquareSum = 0;
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		if (points[neighbour] == EPlayer::ENone) {
+			chain.AddLiberty(neighbour);
+		} else {
+			chains[chainOf[neighbour]].RemoveLiberty(point);
+		}
+	});
+}
+
+template <uint32_t N>
+uint32_t SizedBoard<N>::MergeChains(uint32_t first, uint32_t second) {
+	if (chains[first].stoneCount < chains[second].stoneCount) {
+		std::swap(first, second);
+	}
+	ForEachStone(second, [&](uint32_t stone) {
+		chainOf[stone] = static_cast<uint16_t>(first);
+	});
+	// Swapping where the two rings go next splices them into one.
+	std::swap(nextStone[first], nextStone[second]);
+	Chain& into = chains[first];
+	const Chain& from = chains[second];
+	into.stoneCount += from.stoneCount;
+	into.pseudoLiberties += from.pseudoLiberties;
+	into.libertySum += from.libertySum;
+	into.libertySquareSum += from.libertySquareSum;
+	return first;
+}
+
+template <uint32_t N>
+void SizedBoard<N>::RemoveChain(uint32_t chain, Bitboard& captured, Bitboard& affected) {
+	EPlayer player = points[chain];
+	Bitboard& playerStones = stones[static_cast<uint32_t>(player) - 1];
+	ForEachStone(chain, [&](uint32_t stone) {
+		playerStones.Reset(stone);
+		points[stone] = EPlayer::ENone;
+		hash ^= Zobrist::GetStoneKey(player, stone);
+		captured.Set(stone);
+	});
+	// The whole chain is gone before any liberties are handed out, so none go to stones being taken off.
+	ForEachStone(chain, [&](uint32_t stone) {
+		geometry.ForEachNeighbour(stone, [&](uint32_t neighbour) {
+			if (points[neighbour] == EPlayer::ENone) {
+				affected.Set(neighbour);
+				return;
+			}
+			// A chain that was in atari isn't any more, so its last liberty may have stopped being suicide.
+			Chain& next = chains[chainOf[neighbour]];
+			if (next.IsInAtari()) {
+				affected.Set(next.GetAtariPoint());
+			}
+			next.AddLiberty(stone);
+		});
+	});
+}
+
+template <uint32_t N>
+void SizedBoard<N>::AddAtariPoints(uint32_t point, Bitboard& affected) const {
+	affected.Set(point);
+	geometry.ForEachNeighbour(point, [&](uint32_t neighbour) {
+		affected.Set(neighbour);
+		if (points[neighbour] != EPlayer::ENone && chains[chainOf[neighbour]].IsInAtari()) {
+			affected.Set(chains[chainOf[neighbour]].GetAtariPoint());
+		}
+	});
+}
+
+template <uint32_t N>
+void SizedBoard<N>::UpdatePlayable(const Bitboard& affected) {
+	affected.ForEach([this](uint32_t point) {
+		if (points[point] != EPlayer::ENone) {
+			playable[0].Reset(point);
+			playable[1].Reset(point);
+			return;
+		}
+		if (IsSuicide(point, EPlayer::EWhite)) {
+			playable[0].Reset(point);
+		} else {
+			playable[0].Set(point);
+		}
+		if (IsSuicide(point, EPlayer::EBlack)) {
+			playable[1].Reset(point);
+		} else {
+			playable[1].Set(point);
+		}
+	});
+}
+
+template <uint32_t N>
+void SizedBoard<N>::SplitChains(uint32_t first, uint32_t second) {
+	std::swap(nextStone[first], nextStone[second]);
+	ForEachStone(second, [&](uint32_t stone) {
+		chainOf[stone] = static_cast<uint16_t>(second);
+	});
+	// Nothing touches the joined chain's old entry while it's joined, so it still has what was added.
+	Chain& into = chains[first];
+	const Chain& from = chains[second];
+	into.stoneCount -= from.stoneCount;
+	into.pseudoLiberties -= from.pseudoLiberties;
+	into.libertySum -= from.libertySum;
+	into.libertySquareSum -= from.libertySquareSum;
+}
+
+template <uint32_t N>
+void SizedBoard<N>::RestoreChain(uint32_t chain, EPlayer player) {
+	// The liberties were handed out once the whole chain was gone, so they're taken back before any of it comes back.
+	ForEachStone(chain, [&](uint32_t stone) {
+		geometry.ForEachNeighbour(stone, [&](uint32_t neighbour) {
+			if (points[neighbour] != EPlayer::ENone) {
+				chains[chainOf[neighbour]].RemoveLiberty(stone);
+			}
+		});
+	});
+	Bitboard& playerStones = stones[static_cast<uint32_t>(player) - 1];
+	ForEachStone(chain, [&](uint32_t stone) {
+		playerStones.Set(stone);
+		points[stone] = player;
+		hash ^= Zobrist::GetStoneKey(player, stone);
+	});
+}
+
+template class SizedBoard<9>;
+template class SizedBoard<13>;
+template class SizedBoard<19>;
@@ -0,0 +1,577 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "Bitboard.h"
+#include "Constants.h"
+
+/// <summary>
+/// Everything about a size of board that doesn't change during a game: the masks used to move bitboards around without wrapping
+/// from one edge to the other, the bitboard operations built on them, and the points next to each point. It's all worked out when
+/// compiling, so with the size known, shifts are by constants and neighbours are looked up rather than worked out.
+/// </summary>
+template <uint32_t N>
+class BoardGeometry {
+	public:
+	/// <summary>
+	/// The width of the board.
+	/// </summary>
+	static const uint32_t size = N;
+
+	/// <summary>
+	/// The number of points on the board.
+	/// </summary>
+	static const uint32_t pointCount = N * N;
+
+	/// <summary>
+	/// Ends each point's list of neighbours, standing in for the edge of the board.
+	/// </summary>
+	static const uint16_t edge = Bitboard::maxPoints;
+
+	constexpr BoardGeometry() : points(), notLeft(), notRight(), neighbours() {
+		for (uint32_t y = 0; y < N; ++y) {
+			for (uint32_t x = 0; x < N; ++x) {
+				uint32_t point = y * N + x;
+				points.Set(point);
+				uint32_t count = 0;
+				if (x != 0) {
+					notLeft.Set(point);
+					neighbours[point][count++] = static_cast<uint16_t>(point - 1);
+				}
+				if (x + 1 != N) {
+					notRight.Set(point);
+					neighbours[point][count++] = static_cast<uint16_t>(point + 1);
+				}
+				if (y != 0) {
+					neighbours[point][count++] = static_cast<uint16_t>(point - N);
+				}
+				if (y + 1 != N) {
+					neighbours[point][count++] = static_cast<uint16_t>(point + N);
+				}
+				for (; count < 5; ++count) {
+					neighbours[point][count] = edge;
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// Returns every point on the board.
+	/// </summary>
+	const Bitboard& GetPoints() const {
+		return points;
+	}
+
+	/// <summary>
+	/// Returns every point that's next to one in the given set, not including the set itself unless they're next to each other.
+	/// </summary>
+	Bitboard Neighbours(const Bitboard& set) const {
+		Bitboard result = (set & notRight).ShiftUp(1);
+		result |= (set & notLeft).ShiftDown(1);
+		result |= set.ShiftUp(N);
+		result |= set.ShiftDown(N);
+		return result & points;
+	}
+
+	/// <summary>
+	/// Grows the seed through every point it's connected to within the mask, such as a chain of stones or a region of empty points.
+	/// Each step grows the whole front at once, so it takes as many steps as the region is long rather than one per point.
+	/// </summary>
+	/// <param name="seed">Where to start. Only the parts within the mask are kept.</param>
+	/// <param name="mask">The points that can be grown into.</param>
+	/// <returns>Every point in the mask connected to the seed.</returns>
+	Bitboard Fill(const Bitboard& seed, const Bitboard& mask) const {
+		Bitboard filled = seed & mask;
+		while (true) {
+			Bitboard grown = (filled | Neighbours(filled)) & mask;
+			if (grown == filled) {
+				return filled;
+			}
+			filled = grown;
+		}
+	}
+
+	/// <summary>
+	/// Calls the function with each point next to the given one, of which there are two to four.
+	/// </summary>
+	template <typename Function>
+	void ForEachNeighbour(uint32_t point, Function function) const {
+		for (const uint16_t* neighbour = neighbours[point]; *neighbour != edge; ++neighbour) {
+			function(*neighbour);
+		}
+	}
+
+	private:
+	Bitboard points;
+
+	/// <summary>
+	/// Every point except those in the first column.
+	/// </summary>
+	Bitboard notLeft;
+
+	/// <summary>
+	/// Every point except those in the last column.
+	/// </summary>
+	Bitboard notRight;
+
+	/// <summary>
+	/// The points next to each point, followed by the edge. There's always room for the edge, even in the middle of the board.
+	/// </summary>
+	uint16_t neighbours[N * N][5];
+};
+
+/// <summary>
+/// The stones on a Go board, of any size. The rules are compiled separately for each size as a SizedBoard, and a game picks one when
+/// it starts, so the size is a constant everywhere the rules loop over points. What's kept the same way for every size, such as the
+/// bitboards of stones and the hash, is kept here and can be looked at without going through the size's version.
+/// </summary>
+class Board {
+	public:
+	/// <summary>
+	/// The widest board there can be.
+	/// </summary>
+	static const uint32_t maxSize = 19;
+
+	/// <summary>
+	/// Stands for no point, such as when there's no ko.
+	/// </summary>
+	static const uint32_t noPoint = Bitboard::maxPoints;
+
+	/// <summary>
+	/// What's kept about each chain, under the point that's its ID.
+	/// </summary>
+	struct Chain {
+		Chain() : stoneCount(0), pseudoLiberties(0), libertySum(0), libertySquareSum(0) {}
+
+		uint16_t stoneCount;
+		uint16_t pseudoLiberties;
+		uint32_t libertySum;
+		uint32_t libertySquareSum;
+
+		void AddLiberty(uint32_t point) {
+			++pseudoLiberties;
+			libertySum += point;
+			libertySquareSum += point * point;
+		}
+
+		void RemoveLiberty(uint32_t point) {
+			--pseudoLiberties;
+			libertySum -= point;
+			libertySquareSum -= point * point;
+		}
+
+		bool IsInAtari() const {
+			return pseudoLiberties != 0 && static_cast<uint64_t>(libertySum) * libertySum == static_cast<uint64_t>(pseudoLiberties) * libertySquareSum;
+		}
+
+		uint32_t GetAtariPoint() const {
+			return libertySum / pseudoLiberties;
+		}
+	};
+
+	/// <summary>
+	/// Everything a move changed that can't be worked out from the board afterwards, so that it can be taken back exactly. This is
+	/// the same size however much the move captured: stones taken off the board are left linked in their rings, so a captured chain
+	/// is put back from its ID alone. Which points can be played on isn't kept, since the few that a move changes are worked out
+	/// again when it's taken back.
+	/// </summary>
+	struct Change {
+		uint16_t point;
+		EPlayer player;
+
+		/// <summary>
+		/// How many of the steps were taken.
+		/// </summary>
+		uint8_t stepCount;
+
+		/// <summary>
+		/// The merges and captures, in the order they happened. A merge keeps the chain that was kept and the chain joined to it,
+		/// and a capture keeps the chain taken off and noPoint.
+		/// </summary>
+		std::array<std::array<uint16_t, 2>, 4> steps;
+
+		/// <summary>
+		/// What was under the point before it was played on, which a captured chain's ring may still need.
+		/// </summary>
+		uint16_t previousChainOf;
+		uint16_t previousNextStone;
+		Chain previousChain;
+	};
+
+	/// <summary>
+	/// Makes an empty board, with the rules compiled for its size.
+	/// </summary>
+	/// <param name="size">The width of the board. Only 9, 13 and 19 are supported; anything else gives 19.</param>
+	/// <returns>The board.</returns>
+	static std::shared_ptr<Board> Create(uint32_t size);
+
+	virtual ~Board();
+
+	/// <summary>
+	/// Makes a copy of the board.
+	/// </summary>
+	/// <returns>The copy.</returns>
+	virtual std::shared_ptr<Board> Clone() const = 0;
+
+	/// <summary>
+	/// Makes this board a copy of another, in place, which saves allocating a new one.
+	/// </summary>
+	/// <param name="other">The board to copy. It has to be the same size as this one.</param>
+	virtual void CopyFrom(const Board& other) = 0;
+
+	/// <summary>
+	/// Takes every stone off the board.
+	/// </summary>
+	virtual void Clear() = 0;
+
+	/// <summary>
+	/// Returns the width of the board.
+	/// </summary>
+	/// <returns>The width of the board.</returns>
+	uint32_t GetSize() const {
+		return size;
+	}
+
+	/// <summary>
+	/// Returns the number of points on the board.
+	/// </summary>
+	/// <returns>The number of points.</returns>
+	uint32_t GetPointCount() const {
+		return size * size;
+	}
+
+	/// <summary>
+	/// Returns every point on the board.
+	/// </summary>
+	/// <returns>The points.</returns>
+	const Bitboard& GetPoints() const {
+		return onBoard;
+	}
+
+	/// <summary>
+	/// Returns who has a stone on a point.
+	/// </summary>
+	/// <param name="point">The point.</param>
+	/// <returns>The colour of the stone, or ENone if the point is empty.</returns>
+	virtual EPlayer Get(uint32_t point) const = 0;
+
+	/// <summary>
+	/// Returns whether playing on a point would leave the stone with no liberties, once anything it captures is taken off.
+	/// </summary>
+	/// <param name="point">An empty point.</param>
+	/// <param name="player">Who is playing.</param>
+	/// <returns>Whether the move is suicide.</returns>
+	virtual bool IsSuicide(uint32_t point, EPlayer player) const = 0;
+
+	/// <summary>
+	/// Returns every point a colour could play on without it being suicide. This is kept up to date as moves are played, by only
+	/// looking again at the points a move could have changed, so it costs nothing to ask for. Ko isn't taken into account.
+	/// </summary>
+	/// <param name="player">The colour. This mustn't be ENone.</param>
+	/// <returns>The points that can be played on.</returns>
+	const Bitboard& GetPlayable(EPlayer player) const {
+		return playable[static_cast<uint32_t>(player) - 1];
+	}
+
+	/// <summary>
+	/// Returns whether playing on a point would leave the chain it joins with a single liberty. Unlike the other checks, this can
+	/// look at the liberties of the chains it joins, but stops as soon as it finds a second.
+	/// </summary>
+	/// <param name="point">An empty point, which mustn't be suicide.</param>
+	/// <param name="player">Who is playing.</param>
+	/// <returns>Whether the move puts its own chain in atari.</returns>
+	virtual bool IsSelfAtari(uint32_t point, EPlayer player) const = 0;
+
+	/// <summary>
+	/// Plays a stone, joining it to the chains next to it and taking off any chains of the other colour left without liberties.
+	/// This doesn't check that the move is legal; the point must be empty and the move mustn't be suicide.
+	/// </summary>
+	/// <param name="point">The point to play on.</param>
+	/// <param name="player">Who is playing.</param>
+	/// <returns>The stones captured.</returns>
+	Bitboard Play(uint32_t point, EPlayer player) {
+		Change change;
+		return Play(point, player, change);
+	}
+
+	/// <summary>
+	/// Plays a stone, keeping what it changed so it can be taken back with Undo().
+	/// </summary>
+	/// <param name="point">The point to play on.</param>
+	/// <param name="player">Who is playing.</param>
+	/// <param name="change">Set to what the move changed.</param>
+	/// <returns>The stones captured.</returns>
+	virtual Bitboard Play(uint32_t point, EPlayer player, Change& change) = 0;
+
+	/// <summary>
+	/// Takes back the last move played, putting back anything it captured. Moves have to be taken back in the opposite order they
+	/// were played in. This takes as long as the move did.
+	/// </summary>
+	/// <param name="change">What the move changed, from Play().</param>
+	virtual void Undo(const Change& change) = 0;
+
+	/// <summary>
+	/// Returns the Zobrist hash of the stones on the board, which is kept up to date as stones are played and captured.
+	/// </summary>
+	/// <returns>The hash of the stones.</returns>
+	uint64_t GetHash() const {
+		return hash;
+	}
+
+	/// <summary>
+	/// Returns what the hash of the stones would be after a move, including anything it captures, without playing it.
+	/// </summary>
+	/// <param name="point">An empty point.</param>
+	/// <param name="player">Who is playing.</param>
+	/// <returns>The hash after the move.</returns>
+	virtual uint64_t GetHashAfter(uint32_t point, EPlayer player) const = 0;
+
+	/// <summary>
+	/// Returns every stone of a colour.
+	/// </summary>
+	/// <param name="player">The colour. This mustn't be ENone.</param>
+	/// <returns>The stones.</returns>
+	const Bitboard& GetStones(EPlayer player) const {
+		return stones[static_cast<uint32_t>(player) - 1];
+	}
+
+	/// <summary>
+	/// Returns every empty point.
+	/// </summary>
+	/// <returns>The empty points.</returns>
+	Bitboard GetEmpty() const {
+		return onBoard.AndNot(stones[0] | stones[1]);
+	}
+
+	/// <summary>
+	/// Returns every point that's next to one in the given set, not including the set itself unless they're next to each other.
+	/// </summary>
+	virtual Bitboard Neighbours(const Bitboard& set) const = 0;
+
+	/// <summary>
+	/// Grows the seed through every point it's connected to within the mask, such as a chain of stones or a region of empty points.
+	/// </summary>
+	/// <param name="seed">Where to start. Only the parts within the mask are kept.</param>
+	/// <param name="mask">The points that can be grown into.</param>
+	/// <returns>Every point in the mask connected to the seed.</returns>
+	virtual Bitboard Fill(const Bitboard& seed, const Bitboard& mask) const = 0;
+
+	/// <summary>
+	/// Returns an ID for the chain the stone on a point is part of, which is the same for every stone in the chain.
+	/// </summary>
+	/// <param name="point">A point with a stone on it.</param>
+	/// <returns>The ID of the chain, which is one of its points.</returns>
+	virtual uint32_t GetChainID(uint32_t point) const = 0;
+
+	/// <summary>
+	/// Returns how many stones are in the chain the stone on a point is part of.
+	/// </summary>
+	/// <param name="point">A point with a stone on it.</param>
+	/// <returns>The number of stones.</returns>
+	virtual uint32_t GetChainSize(uint32_t point) const = 0;
+
+	/// <summary>
+	/// Returns whether the chain the stone on a point is part of has a single liberty.
+	/// </summary>
+	/// <param name="point">A point with a stone on it.</param>
+	/// <returns>Whether the chain is in atari.</returns>
+	virtual bool IsInAtari(uint32_t point) const = 0;
+
+	/// <summary>
+	/// Returns the last liberty of a chain in atari.
+	/// </summary>
+	/// <param name="point">A point with a stone on it, whose chain is in atari.</param>
+	/// <returns>The last liberty.</returns>
+	virtual uint32_t GetAtariPoint(uint32_t point) const = 0;
+
+	/// <summary>
+	/// Returns the chain the stone on a point is part of, which is every stone of its colour connected to it.
+	/// </summary>
+	/// <param name="point">A point with a stone on it.</param>
+	/// <returns>The chain, or nothing if the point is empty.</returns>
+	virtual Bitboard GetChain(uint32_t point) const = 0;
+
+	/// <summary>
+	/// Returns the empty points next to a chain.
+	/// </summary>
+	/// <param name="chain">The chain.</param>
+	/// <returns>The liberties of the chain.</returns>
+	Bitboard GetLiberties(const Bitboard& chain) const {
+		return Neighbours(chain) & GetEmpty();
+	}
+
+	/// <summary>
+	/// Counts the liberties of the chain the stone on a point is part of. This walks the chain; use IsInAtari() where a count of
+	/// one is all that matters.
+	/// </summary>
+	/// <param name="point">A point with a stone on it.</param>
+	/// <returns>The number of liberties, or 0 if the point is empty.</returns>
+	uint32_t CountLiberties(uint32_t point) const {
+		return GetLiberties(GetChain(point)).Count();
+	}
+
+	protected:
+	Board(uint32_t size, const Bitboard& onBoard);
+
+	uint32_t size;
+	Bitboard onBoard;
+
+	/// <summary>
+	/// White's stones, then black's.
+	/// </summary>
+	std::array<Bitboard, 2> stones;
+
+	uint64_t hash;
+
+	/// <summary>
+	/// The points each colour can play on without it being suicide, white's then black's.
+	/// </summary>
+	std::array<Bitboard, 2> playable;
+};
+
+/// <summary>
+/// The rules for one size of board. Everything is sized to the board, and every loop over points or neighbours has the size as a
+/// constant. Only 9, 13 and 19 are compiled, in Board.cpp.
+/// Chains are tracked as stones are played and captured, so the rules never need to flood fill. Each chain's stones are linked in a
+/// ring, and the chain keeps its pseudo-liberties: every side of a stone that touches an empty point, counted once per side. Along
+/// with the count, the sum and sum of squares of those points are kept, which are enough to tell in constant time whether a chain
+/// is captured (no pseudo-liberties) or in atari (all of them are the same point, which is the only way the sum squared can equal
+/// the count times the sum of squares).
+/// The board has nothing to free, so it can be copied freely.
+/// </summary>
+template <uint32_t N>
+class SizedBoard : public Board {
+	public:
+	/// <summary>
+	/// The shapes of a board this size, worked out when compiling.
+	/// </summary>
+	static constexpr BoardGeometry<N> geometry = BoardGeometry<N>();
+
+	/// <summary>
+	/// Makes an empty board.
+	/// </summary>
+	SizedBoard();
+
+	std::shared_ptr<Board> Clone() const override;
+	void CopyFrom(const Board& other) override;
+	void Clear() override;
+
+	EPlayer Get(uint32_t point) const override {
+		return points[point];
+	}
+
+	bool IsSuicide(uint32_t point, EPlayer player) const override;
+	bool IsSelfAtari(uint32_t point, EPlayer player) const override;
+	using Board::Play;
+	Bitboard Play(uint32_t point, EPlayer player, Change& change) override;
+	void Undo(const Change& change) override;
+	uint64_t GetHashAfter(uint32_t point, EPlayer player) const override;
+
+	Bitboard Neighbours(const Bitboard& set) const override {
+		return geometry.Neighbours(set);
+	}
+
+	Bitboard Fill(const Bitboard& seed, const Bitboard& mask) const override {
+		return geometry.Fill(seed, mask);
+	}
+
+	uint32_t GetChainID(uint32_t point) const override {
+		return chainOf[point];
+	}
+
+	uint32_t GetChainSize(uint32_t point) const override {
+		return chains[chainOf[point]].stoneCount;
+	}
+
+	bool IsInAtari(uint32_t point) const override {
+		return chains[chainOf[point]].IsInAtari();
+	}
+
+	uint32_t GetAtariPoint(uint32_t point) const override {
+		return chains[chainOf[point]].GetAtariPoint();
+	}
+
+	Bitboard GetChain(uint32_t point) const override;
+
+	/// <summary>
+	/// Calls the function with each stone in the chain the stone on a point is part of.
+	/// </summary>
+	template <typename Function>
+	void ForEachStone(uint32_t point, Function function) const {
+		uint32_t stone = point;
+		do {
+			function(stone);
+			stone = nextStone[stone];
+		} while (stone != point);
+	}
+
+	private:
+	/// <summary>
+	/// Puts a stone on an empty point as a chain of its own, and updates the pseudo-liberties around it.
+	/// </summary>
+	void PlaceStone(uint32_t point, EPlayer player);
+
+	/// <summary>
+	/// Joins two chains, relabelling the smaller one.
+	/// </summary>
+	/// <returns>The ID of the joined chain.</returns>
+	uint32_t MergeChains(uint32_t first, uint32_t second);
+
+	/// <summary>
+	/// Takes a chain off the board, giving its points back as liberties to the chains around it.
+	/// </summary>
+	/// <param name="chain">The ID of the chain.</param>
+	/// <param name="captured">The captured stones are added to this.</param>
+	/// <param name="affected">Points that may have stopped being suicide are added to this.</param>
+	void RemoveChain(uint32_t chain, Bitboard& captured, Bitboard& affected);
+
+	/// <summary>
+	/// Adds a point, its neighbours and the last liberty of any chain next to it that's in atari to a set of points to update.
+	/// </summary>
+	void AddAtariPoints(uint32_t point, Bitboard& affected) const;
+
+	/// <summary>
+	/// Works out again whether each of the given points can be played on.
+	/// </summary>
+	void UpdatePlayable(const Bitboard& affected);
+
+	/// <summary>
+	/// Splits a chain back into the two chains MergeChains() made it from.
+	/// </summary>
+	/// <param name="first">The ID of the joined chain.</param>
+	/// <param name="second">The ID of the chain that was joined to it.</param>
+	void SplitChains(uint32_t first, uint32_t second);
+
+	/// <summary>
+	/// Puts a chain taken off by RemoveChain() back on the board, taking back the liberties it gave the chains around it.
+	/// </summary>
+	/// <param name="chain">The ID of the chain.</param>
+	/// <param name="player">The colour of the chain.</param>
+	void RestoreChain(uint32_t chain, EPlayer player);
+
+	std::array<EPlayer, N * N> points;
+
+	/// <summary>
+	/// The ID of the chain each stone is part of. Empty points are left as they were.
+	/// </summary>
+	std::array<uint16_t, N * N> chainOf;
+
+	/// <summary>
+	/// The next stone in each stone's chain, going round in a ring.
+	/// </summary>
+	std::array<uint16_t, N * N> nextStone;
+
+	/// <summary>
+	/// Each chain, under its ID.
+	/// </summary>
+	std::array<Chain, N * N> chains;
+};
+
+template <uint32_t N>
+constexpr BoardGeometry<N> SizedBoard<N>::geometry;
+
+extern template class SizedBoard<9>;
+extern template class SizedBoard<13>;
+extern template class SizedBoard<19>;
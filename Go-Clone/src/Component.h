@@ -9,7 +9,7 @@
 class Component {
 	public:
 	Component(class GameObject* gameObject);
-	~Component();
+	virtual ~Component();
 
 	/// <summary>
 	/// Destroys the component and removes it from the object it is connected to.
@@ -30,7 +30,7 @@ class Component {
 	/// </summary>
 	/// <returns>Whether the component can be casted to the given type or not.</returns>
 	template<typename T> bool CanCast() {
-		return static_cast<T*>(this) != nullptr;
+		return dynamic_cast<T*>(this) != nullptr;
 	}
 
 	/// <summary>
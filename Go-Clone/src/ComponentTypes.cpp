@@ -3,7 +3,9 @@
 #include "GameObject.h"
 #include "GoGame.h"
 
-ComponentType::ComponentType(GameObject* gameObject) : Component(gameObject) {}
+ComponentType::ComponentType(GameObject* gameObject) : Component(gameObject) {
+	active = true;
+}
 
 bool ComponentType::IsActive() const {
 	return active;
@@ -22,4 +24,13 @@ Updateable::Updateable(GameObject* gameObject) : ComponentType(gameObject) {}
 
 LateUpdateable::LateUpdateable(GameObject* gameObject) : ComponentType(gameObject) {}
 
-Renderable::Renderable(GameObject* gameObject) : ComponentType(gameObject) {}
\ No newline at end of file
+Renderable::Renderable(GameObject* gameObject) : ComponentType(gameObject) {}
+
+void Renderable::Submit(RenderQueue& queue, const glm::mat4& model) {
+	DrawCommand command = {};
+	command.sortKey = queue.MakeKey(RenderQueue::ECustom, 0, 0, model);
+	command.renderable = this;
+	command.model = model;
+	command.color = glm::vec4(1.0f);
+	queue.Push(command);
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <glm/mat4x4.hpp>
+
 #include "Component.h"
+#include "RenderQueue.h"
 
 //? Should I shift this into a .cpp file or just leave it in the header?
 /// <summary>
@@ -77,7 +80,16 @@ class Renderable : public ComponentType {
 	Renderable(class GameObject* gameObject);
 
 	/// <summary>
-	/// A function that is called specifically to draw something.
+	/// A function that is called specifically to draw something. The modelview matrix is already set up for the object when this is called.
 	/// </summary>
 	virtual void Render() = 0;
+
+	/// <summary>
+	/// Adds whatever this needs drawn this frame to the queue. This is called while walking the scene graph, before anything is drawn,
+	/// so it shouldn't touch OpenGL. The scene graph may be walked on several threads at once, so this also shouldn't change anything
+	/// outside of the queue. By default, this queues a command that calls Render() in scene graph order.
+	/// </summary>
+	/// <param name="queue">The queue to add commands to.</param>
+	/// <param name="model">The world matrix of the object.</param>
+	virtual void Submit(RenderQueue& queue, const glm::mat4& model);
 };
\ No newline at end of file
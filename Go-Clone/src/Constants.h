@@ -1,10 +1,20 @@
 #pragma once
 
+#include <cstdint>
+
 /// <summary>
 /// An enum used to indicate a player. Can be used for tiles and current turn.
+/// It's a single byte so that a board's worth of them is small.
 /// </summary>
-enum class EPlayer {
+enum class EPlayer : uint8_t {
 	ENone,
 	EWhite,
 	EBlack
-};
\ No newline at end of file
+};
+
+/// <summary>
+/// Returns the other player. ENone stays as it is.
+/// </summary>
+inline EPlayer GetOpponent(EPlayer player) {
+	return player == EPlayer::EWhite ? EPlayer::EBlack : player == EPlayer::EBlack ? EPlayer::EWhite : EPlayer::ENone;
+}
\ No newline at end of file
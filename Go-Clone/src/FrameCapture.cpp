@@ -0,0 +1,139 @@
+#include "FrameCapture.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+#include <SFML/OpenGL.hpp>
+
+#include "Log.h"
+
+/// <summary>
+/// Returns the CRC-32 lookup table that PNG chunks use.
+/// </summary>
+static const std::array<uint32_t, 256>& CRCTable() {
+	static std::array<uint32_t, 256> table = {};
+	static bool built = false;
+	if (!built) {
+		for (uint32_t i = 0; i < 256; ++i) {
+			uint32_t value = i;
+			for (int bit = 0; bit < 8; ++bit) {
+				value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+			}
+			table[i] = value;
+		}
+		built = true;
+	}
+	return table;
+}
+
+/// <summary>
+/// Adds a big endian 32-bit number to the end of the data.
+/// </summary>
+static void AppendBigEndian(std::vector<uint8_t>& data, uint32_t value) {
+	data.push_back(static_cast<uint8_t>(value >> 24));
+	data.push_back(static_cast<uint8_t>(value >> 16));
+	data.push_back(static_cast<uint8_t>(value >> 8));
+	data.push_back(static_cast<uint8_t>(value));
+}
+
+/// <summary>
+/// Writes a PNG chunk, which is its length, type, data and a CRC of the type and data.
+/// </summary>
+static void WriteChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+	std::vector<uint8_t> chunk;
+	chunk.reserve(data.size() + 12);
+	AppendBigEndian(chunk, static_cast<uint32_t>(data.size()));
+	chunk.insert(chunk.end(), type, type + 4);
+	chunk.insert(chunk.end(), data.begin(), data.end());
+
+	const std::array<uint32_t, 256>& table = CRCTable();
+	uint32_t crc = 0xFFFFFFFFu;
+	for (size_t i = 4; i < chunk.size(); ++i) {
+		crc = table[(crc ^ chunk[i]) & 0xFF] ^ (crc >> 8);
+	}
+	AppendBigEndian(chunk, crc ^ 0xFFFFFFFFu);
+	file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+}
+
+std::vector<uint8_t> FrameCapture::ReadFramebuffer(uint32_t width, uint32_t height) {
+	std::vector<uint8_t> pixels(width * height * 4);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	// GL reads from the bottom row up, but images are stored from the top down.
+	size_t rowSize = width * 4;
+	for (uint32_t row = 0; row < height / 2; ++row) {
+		std::swap_ranges(pixels.begin() + row * rowSize, pixels.begin() + (row + 1) * rowSize, pixels.begin() + (height - 1 - row) * rowSize);
+	}
+	return pixels;
+}
+
+bool FrameCapture::SavePNG(const std::string& path, uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels) {
+	if (pixels.size() < static_cast<size_t>(width) * height * 4) {
+		LOG_ERROR("Not enough pixels to save {}.", path);
+		return false;
+	}
+	std::ofstream file(path, std::ios::binary);
+	if (!file) {
+		LOG_ERROR("Couldn't open {} to save a frame.", path);
+		return false;
+	}
+
+	const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+	std::vector<uint8_t> header;
+	AppendBigEndian(header, width);
+	AppendBigEndian(header, height);
+	// 8 bits per channel, RGBA, then the default compression, filter and interlace methods.
+	header.push_back(8);
+	header.push_back(6);
+	header.push_back(0);
+	header.push_back(0);
+	header.push_back(0);
+	WriteChunk(file, "IHDR", header);
+
+	// Every row starts with its filter type, which is always 0 (none) here.
+	size_t rowSize = width * 4;
+	std::vector<uint8_t> raw;
+	raw.reserve((rowSize + 1) * height);
+	for (uint32_t row = 0; row < height; ++row) {
+		raw.push_back(0);
+		raw.insert(raw.end(), pixels.begin() + row * rowSize, pixels.begin() + (row + 1) * rowSize);
+	}
+
+	// The zlib stream is made of stored deflate blocks, which can each hold up to 65535 bytes.
+	std::vector<uint8_t> compressed;
+	compressed.reserve(raw.size() + raw.size() / 65535 * 5 + 11);
+	compressed.push_back(0x78);
+	compressed.push_back(0x01);
+	size_t position = 0;
+	do {
+		size_t blockSize = std::min<size_t>(raw.size() - position, 65535);
+		bool last = position + blockSize == raw.size();
+		compressed.push_back(last ? 1 : 0);
+		compressed.push_back(static_cast<uint8_t>(blockSize));
+		compressed.push_back(static_cast<uint8_t>(blockSize >> 8));
+		compressed.push_back(static_cast<uint8_t>(~blockSize));
+		compressed.push_back(static_cast<uint8_t>(~blockSize >> 8));
+		compressed.insert(compressed.end(), raw.begin() + position, raw.begin() + position + blockSize);
+		position += blockSize;
+	} while (position < raw.size());
+
+	uint32_t adlerA = 1;
+	uint32_t adlerB = 0;
+	for (uint8_t byte : raw) {
+		adlerA = (adlerA + byte) % 65521;
+		adlerB = (adlerB + adlerA) % 65521;
+	}
+	AppendBigEndian(compressed, (adlerB << 16) | adlerA);
+	WriteChunk(file, "IDAT", compressed);
+
+	WriteChunk(file, "IEND", std::vector<uint8_t>());
+	return static_cast<bool>(file);
+}
+
+bool FrameCapture::Capture(const std::string& path, uint32_t width, uint32_t height) {
+	return SavePNG(path, width, height, ReadFramebuffer(width, height));
+}
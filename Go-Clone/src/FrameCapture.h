@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Saves what's been rendered to image files, for looking at runs that had no window and for comparing renders between builds.
+/// </summary>
+class FrameCapture {
+	public:
+	/// <summary>
+	/// Reads the current framebuffer back from the graphics card. This waits for all drawing to finish.
+	/// </summary>
+	/// <param name="width">The width of the framebuffer.</param>
+	/// <param name="height">The height of the framebuffer.</param>
+	/// <returns>The pixels as 8-bit RGBA, with the top row first.</returns>
+	static std::vector<uint8_t> ReadFramebuffer(uint32_t width, uint32_t height);
+
+	/// <summary>
+	/// Saves pixels as a PNG file. The image data isn't compressed, since nothing here links zlib, but any PNG reader can open it.
+	/// </summary>
+	/// <param name="path">The file to write.</param>
+	/// <param name="width">The width of the image.</param>
+	/// <param name="height">The height of the image.</param>
+	/// <param name="pixels">The pixels as 8-bit RGBA, with the top row first.</param>
+	/// <returns>Whether the file was written.</returns>
+	static bool SavePNG(const std::string& path, uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels);
+
+	/// <summary>
+	/// Reads the current framebuffer back and saves it as a PNG file.
+	/// </summary>
+	/// <param name="path">The file to write.</param>
+	/// <param name="width">The width of the framebuffer.</param>
+	/// <param name="height">The height of the framebuffer.</param>
+	/// <returns>Whether the file was written.</returns>
+	static bool Capture(const std::string& path, uint32_t width, uint32_t height);
+};
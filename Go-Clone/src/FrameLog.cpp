@@ -0,0 +1,104 @@
+#include "FrameLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+#include "Log.h"
+
+FrameLog::FrameLog() {
+}
+
+FrameLog::~FrameLog() {
+}
+
+void FrameLog::Record(const FrameSample& sample) {
+	samples.push_back(sample);
+}
+
+const std::vector<FrameSample>& FrameLog::GetSamples() const {
+	return samples;
+}
+
+bool FrameLog::WriteCSV(const std::string& path) const {
+	std::ofstream file(path);
+	if (!file) {
+		LOG_ERROR("Couldn't open {} to write the frame timings.", path);
+		return false;
+	}
+	file << "frame,frame_ms,update_ms,traversal_ms,draw_ms,finish_ms,commands,draw_calls,triangles,state_calls_issued,state_calls_filtered\n";
+	for (const FrameSample& sample : samples) {
+		file << sample.frame << ','
+			<< sample.frameTime << ','
+			<< sample.updateTime << ','
+			<< sample.traversalTime << ','
+			<< sample.drawTime << ','
+			<< sample.finishTime << ','
+			<< sample.commands << ','
+			<< sample.drawCalls << ','
+			<< sample.triangles << ','
+			<< sample.stateCallsIssued << ','
+			<< sample.stateCallsFiltered << '\n';
+	}
+	return static_cast<bool>(file);
+}
+
+void FrameLog::PrintSummary(std::ostream& out) const {
+	if (samples.size() < 2) {
+		out << "Not enough frames were run to summarise.\n";
+		return;
+	}
+
+	// Each timing is pulled out into its own list so they can be ranked separately.
+	const size_t timingCount = 5;
+	const char* names[timingCount] = {"frame", "update", "traversal", "draw", "finish"};
+	std::vector<double> timings[timingCount];
+	double commands = 0.0;
+	double drawCalls = 0.0;
+	double triangles = 0.0;
+	double stateCallsIssued = 0.0;
+	double stateCallsFiltered = 0.0;
+	for (size_t i = 1; i < samples.size(); ++i) {
+		const FrameSample& sample = samples[i];
+		timings[0].push_back(sample.frameTime);
+		timings[1].push_back(sample.updateTime);
+		timings[2].push_back(sample.traversalTime);
+		timings[3].push_back(sample.drawTime);
+		timings[4].push_back(sample.finishTime);
+		commands += sample.commands;
+		drawCalls += sample.drawCalls;
+		triangles += sample.triangles;
+		stateCallsIssued += sample.stateCallsIssued;
+		stateCallsFiltered += sample.stateCallsFiltered;
+	}
+	double frameCount = static_cast<double>(samples.size() - 1);
+
+	std::ios::fmtflags flags = out.flags();
+	std::streamsize precision = out.precision();
+	out << std::fixed << std::setprecision(3);
+	out << std::left << std::setw(12) << "ms" << std::right << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+	for (size_t i = 0; i < timingCount; ++i) {
+		out << std::left << std::setw(12) << names[i] << std::right
+			<< std::setw(10) << Percentile(timings[i], 0.5)
+			<< std::setw(10) << Percentile(timings[i], 0.9)
+			<< std::setw(10) << Percentile(timings[i], 0.99)
+			<< std::setw(10) << Percentile(timings[i], 1.0) << "\n";
+	}
+	out << std::setprecision(1);
+	out << "Per frame: " << commands / frameCount << " commands, " << drawCalls / frameCount << " draw calls, " << triangles / frameCount << " triangles, "
+		<< (drawCalls + stateCallsIssued) / frameCount << " GL calls (" << stateCallsIssued / frameCount << " state changes issued, "
+		<< stateCallsFiltered / frameCount << " filtered).\n";
+	out.flags(flags);
+	out.precision(precision);
+}
+
+double FrameLog::Percentile(std::vector<double> values, double fraction) {
+	if (values.empty()) {
+		return 0.0;
+	}
+	size_t rank = static_cast<size_t>(std::ceil(fraction * values.size()));
+	size_t index = rank > 0 ? rank - 1 : 0;
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// What happened during a single frame.
+/// </summary>
+struct FrameSample {
+	/// <summary>
+	/// The number of the frame, starting from 0.
+	/// </summary>
+	uint32_t frame;
+
+	/// <summary>
+	/// How long the whole frame took, in milliseconds.
+	/// </summary>
+	double frameTime;
+
+	/// <summary>
+	/// How long it took to update every object, in milliseconds.
+	/// </summary>
+	double updateTime;
+
+	/// <summary>
+	/// How long it took to walk the scene graph into draw commands, in milliseconds.
+	/// </summary>
+	double traversalTime;
+
+	/// <summary>
+	/// How long it took to sort and issue the draw commands, in milliseconds.
+	/// </summary>
+	double drawTime;
+
+	/// <summary>
+	/// How long it took for the graphics card to finish drawing after everything was issued, in milliseconds.
+	/// </summary>
+	double finishTime;
+
+	/// <summary>
+	/// The number of draw commands that were queued.
+	/// </summary>
+	size_t commands;
+
+	/// <summary>
+	/// The number of draw calls that were made.
+	/// </summary>
+	size_t drawCalls;
+
+	/// <summary>
+	/// The number of triangles that were drawn.
+	/// </summary>
+	size_t triangles;
+
+	/// <summary>
+	/// The number of state changes that went through to GL.
+	/// </summary>
+	size_t stateCallsIssued;
+
+	/// <summary>
+	/// The number of state changes that were skipped because they wouldn't have changed anything.
+	/// </summary>
+	size_t stateCallsFiltered;
+};
+
+/// <summary>
+/// Keeps a sample of every frame, so that they can be written out once the game is done.
+/// </summary>
+class FrameLog {
+	public:
+	FrameLog();
+	~FrameLog();
+
+	/// <summary>
+	/// Adds a frame to the log.
+	/// </summary>
+	/// <param name="sample">The frame.</param>
+	void Record(const FrameSample& sample);
+
+	/// <summary>
+	/// Returns every frame in the log, in the order they were recorded.
+	/// </summary>
+	/// <returns>Every frame in the log.</returns>
+	const std::vector<FrameSample>& GetSamples() const;
+
+	/// <summary>
+	/// Writes every frame to a CSV file, one frame to a row.
+	/// </summary>
+	/// <param name="path">The file to write.</param>
+	/// <returns>Whether the file was written.</returns>
+	bool WriteCSV(const std::string& path) const;
+
+	/// <summary>
+	/// Prints the percentiles of each timing and the average of each count. The first frame is left out, since it's when shaders are
+	/// compiled and meshes are uploaded, which would otherwise skew the results.
+	/// </summary>
+	/// <param name="out">Where to print to.</param>
+	void PrintSummary(std::ostream& out) const;
+
+	/// <summary>
+	/// Returns the value that the given fraction of values are at or below, using the nearest rank.
+	/// </summary>
+	/// <param name="values">The values. These don't need to be sorted.</param>
+	/// <param name="fraction">The fraction, from 0 to 1. 0.5 gives the median.</param>
+	/// <returns>The percentile, or 0 if there are no values.</returns>
+	static double Percentile(std::vector<double> values, double fraction);
+
+	private:
+	/// <summary>
+	/// Every frame so far.
+	/// </summary>
+	std::vector<FrameSample> samples;
+};
@@ -0,0 +1,131 @@
+#include "GLExtensions.h"
+
+#include <SFML/Window/Context.hpp>
+
+unsigned int GLExtensions::contextGeneration = 0;
+
+GLExtensions::GenBuffersProc GLExtensions::GenBuffers = nullptr;
+GLExtensions::DeleteBuffersProc GLExtensions::DeleteBuffers = nullptr;
+GLExtensions::BindBufferProc GLExtensions::BindBuffer = nullptr;
+GLExtensions::BufferDataProc GLExtensions::BufferData = nullptr;
+GLExtensions::BufferSubDataProc GLExtensions::BufferSubData = nullptr;
+GLExtensions::IsBufferProc GLExtensions::IsBuffer = nullptr;
+GLExtensions::GenVertexArraysProc GLExtensions::GenVertexArrays = nullptr;
+GLExtensions::DeleteVertexArraysProc GLExtensions::DeleteVertexArrays = nullptr;
+GLExtensions::BindVertexArrayProc GLExtensions::BindVertexArray = nullptr;
+GLExtensions::CreateShaderProc GLExtensions::CreateShader = nullptr;
+GLExtensions::DeleteShaderProc GLExtensions::DeleteShader = nullptr;
+GLExtensions::ShaderSourceProc GLExtensions::ShaderSource = nullptr;
+GLExtensions::CompileShaderProc GLExtensions::CompileShader = nullptr;
+GLExtensions::GetShaderivProc GLExtensions::GetShaderiv = nullptr;
+GLExtensions::GetShaderInfoLogProc GLExtensions::GetShaderInfoLog = nullptr;
+GLExtensions::CreateProgramProc GLExtensions::CreateProgram = nullptr;
+GLExtensions::DeleteProgramProc GLExtensions::DeleteProgram = nullptr;
+GLExtensions::AttachShaderProc GLExtensions::AttachShader = nullptr;
+GLExtensions::BindAttribLocationProc GLExtensions::BindAttribLocation = nullptr;
+GLExtensions::LinkProgramProc GLExtensions::LinkProgram = nullptr;
+GLExtensions::GetProgramivProc GLExtensions::GetProgramiv = nullptr;
+GLExtensions::GetProgramInfoLogProc GLExtensions::GetProgramInfoLog = nullptr;
+GLExtensions::UseProgramProc GLExtensions::UseProgram = nullptr;
+GLExtensions::GetUniformLocationProc GLExtensions::GetUniformLocation = nullptr;
+GLExtensions::Uniform1iProc GLExtensions::Uniform1i = nullptr;
+GLExtensions::Uniform4fvProc GLExtensions::Uniform4fv = nullptr;
+GLExtensions::UniformMatrix4fvProc GLExtensions::UniformMatrix4fv = nullptr;
+GLExtensions::EnableVertexAttribArrayProc GLExtensions::EnableVertexAttribArray = nullptr;
+GLExtensions::DisableVertexAttribArrayProc GLExtensions::DisableVertexAttribArray = nullptr;
+GLExtensions::VertexAttribPointerProc GLExtensions::VertexAttribPointer = nullptr;
+GLExtensions::VertexAttrib4fvProc GLExtensions::VertexAttrib4fv = nullptr;
+GLExtensions::VertexAttribDivisorProc GLExtensions::VertexAttribDivisor = nullptr;
+GLExtensions::DrawElementsInstancedProc GLExtensions::DrawElementsInstanced = nullptr;
+GLExtensions::GetUniformBlockIndexProc GLExtensions::GetUniformBlockIndex = nullptr;
+GLExtensions::UniformBlockBindingProc GLExtensions::UniformBlockBinding = nullptr;
+GLExtensions::BindBufferBaseProc GLExtensions::BindBufferBase = nullptr;
+
+/// <summary>
+/// The loader used by the Load() call in progress.
+/// </summary>
+static GLExtensions::LoaderProc currentLoader = nullptr;
+
+/// <summary>
+/// Fetches a function from the current context into the given pointer.
+/// </summary>
+template<typename T> static void LoadFunction(T& function, const char* name) {
+	if (currentLoader != nullptr) {
+		function = reinterpret_cast<T>(currentLoader(name));
+	} else {
+		function = reinterpret_cast<T>(sf::Context::getFunction(name));
+	}
+}
+
+bool GLExtensions::Load(LoaderProc loader) {
+	currentLoader = loader;
+	++contextGeneration;
+	LoadFunction(GenBuffers, "glGenBuffers");
+	LoadFunction(DeleteBuffers, "glDeleteBuffers");
+	LoadFunction(BindBuffer, "glBindBuffer");
+	LoadFunction(BufferData, "glBufferData");
+	LoadFunction(BufferSubData, "glBufferSubData");
+	LoadFunction(IsBuffer, "glIsBuffer");
+	LoadFunction(GenVertexArrays, "glGenVertexArrays");
+	LoadFunction(DeleteVertexArrays, "glDeleteVertexArrays");
+	LoadFunction(BindVertexArray, "glBindVertexArray");
+	LoadFunction(CreateShader, "glCreateShader");
+	LoadFunction(DeleteShader, "glDeleteShader");
+	LoadFunction(ShaderSource, "glShaderSource");
+	LoadFunction(CompileShader, "glCompileShader");
+	LoadFunction(GetShaderiv, "glGetShaderiv");
+	LoadFunction(GetShaderInfoLog, "glGetShaderInfoLog");
+	LoadFunction(CreateProgram, "glCreateProgram");
+	LoadFunction(DeleteProgram, "glDeleteProgram");
+	LoadFunction(AttachShader, "glAttachShader");
+	LoadFunction(BindAttribLocation, "glBindAttribLocation");
+	LoadFunction(LinkProgram, "glLinkProgram");
+	LoadFunction(GetProgramiv, "glGetProgramiv");
+	LoadFunction(GetProgramInfoLog, "glGetProgramInfoLog");
+	LoadFunction(UseProgram, "glUseProgram");
+	LoadFunction(GetUniformLocation, "glGetUniformLocation");
+	LoadFunction(Uniform1i, "glUniform1i");
+	LoadFunction(Uniform4fv, "glUniform4fv");
+	LoadFunction(UniformMatrix4fv, "glUniformMatrix4fv");
+	LoadFunction(EnableVertexAttribArray, "glEnableVertexAttribArray");
+	LoadFunction(DisableVertexAttribArray, "glDisableVertexAttribArray");
+	LoadFunction(VertexAttribPointer, "glVertexAttribPointer");
+	LoadFunction(VertexAttrib4fv, "glVertexAttrib4fv");
+	LoadFunction(VertexAttribDivisor, "glVertexAttribDivisor");
+	LoadFunction(DrawElementsInstanced, "glDrawElementsInstanced");
+	LoadFunction(GetUniformBlockIndex, "glGetUniformBlockIndex");
+	LoadFunction(UniformBlockBinding, "glUniformBlockBinding");
+	LoadFunction(BindBufferBase, "glBindBufferBase");
+	return HasBuffers();
+}
+
+bool GLExtensions::HasBuffers() {
+	return GenBuffers != nullptr && DeleteBuffers != nullptr && BindBuffer != nullptr && BufferData != nullptr && BufferSubData != nullptr;
+}
+
+bool GLExtensions::HasVertexArrays() {
+	return HasBuffers() && GenVertexArrays != nullptr && DeleteVertexArrays != nullptr && BindVertexArray != nullptr;
+}
+
+bool GLExtensions::HasShaders() {
+	return CreateShader != nullptr && DeleteShader != nullptr && ShaderSource != nullptr && CompileShader != nullptr && GetShaderiv != nullptr && GetShaderInfoLog != nullptr
+		&& CreateProgram != nullptr && DeleteProgram != nullptr && AttachShader != nullptr && BindAttribLocation != nullptr && LinkProgram != nullptr && GetProgramiv != nullptr
+		&& GetProgramInfoLog != nullptr && UseProgram != nullptr && GetUniformLocation != nullptr && Uniform1i != nullptr && Uniform4fv != nullptr && UniformMatrix4fv != nullptr
+		&& EnableVertexAttribArray != nullptr && DisableVertexAttribArray != nullptr && VertexAttribPointer != nullptr;
+}
+
+bool GLExtensions::HasInstancing() {
+	return HasBuffers() && HasShaders() && VertexAttribDivisor != nullptr && DrawElementsInstanced != nullptr;
+}
+
+bool GLExtensions::HasUniformBuffers() {
+	return HasBuffers() && GetUniformBlockIndex != nullptr && UniformBlockBinding != nullptr && BindBufferBase != nullptr;
+}
+
+bool GLExtensions::HasShaderPipeline() {
+	return HasInstancing() && HasUniformBuffers() && VertexAttrib4fv != nullptr;
+}
+
+unsigned int GLExtensions::GetContextGeneration() {
+	return contextGeneration;
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+
+#include <SFML/OpenGL.hpp>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// The Windows GL headers only go up to 1.1, so anything newer has to be declared here.
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_INFO_LOG_LENGTH
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_UNIFORM_BUFFER
+#define GL_UNIFORM_BUFFER 0x8A11
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+#ifndef GL_RED
+#define GL_RED 0x1903
+#endif
+#ifndef GL_R8
+#define GL_R8 0x8229
+#endif
+#ifndef GL_INVALID_INDEX
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif
+
+/// <summary>
+/// Loads the OpenGL functions that aren't exported by the platform's GL library.
+/// These are fetched through SFML (or a given loader) once a context exists, so Load() should be called after the window has been made.
+/// If something can't be loaded, the pointer stays nullptr, so check the Has functions before relying on a feature.
+/// </summary>
+class GLExtensions {
+	public:
+	typedef std::ptrdiff_t SizeIPtr;
+	typedef std::ptrdiff_t IntPtr;
+
+	typedef void (APIENTRY *GenBuffersProc)(GLsizei n, GLuint* buffers);
+	typedef void (APIENTRY *DeleteBuffersProc)(GLsizei n, const GLuint* buffers);
+	typedef void (APIENTRY *BindBufferProc)(GLenum target, GLuint buffer);
+	typedef void (APIENTRY *BufferDataProc)(GLenum target, SizeIPtr size, const void* data, GLenum usage);
+	typedef void (APIENTRY *BufferSubDataProc)(GLenum target, IntPtr offset, SizeIPtr size, const void* data);
+	typedef GLboolean (APIENTRY *IsBufferProc)(GLuint buffer);
+	typedef void (APIENTRY *GenVertexArraysProc)(GLsizei n, GLuint* arrays);
+	typedef void (APIENTRY *DeleteVertexArraysProc)(GLsizei n, const GLuint* arrays);
+	typedef void (APIENTRY *BindVertexArrayProc)(GLuint array);
+	typedef GLuint (APIENTRY *CreateShaderProc)(GLenum type);
+	typedef void (APIENTRY *DeleteShaderProc)(GLuint shader);
+	typedef void (APIENTRY *ShaderSourceProc)(GLuint shader, GLsizei count, const char* const* string, const GLint* length);
+	typedef void (APIENTRY *CompileShaderProc)(GLuint shader);
+	typedef void (APIENTRY *GetShaderivProc)(GLuint shader, GLenum pname, GLint* params);
+	typedef void (APIENTRY *GetShaderInfoLogProc)(GLuint shader, GLsizei bufSize, GLsizei* length, char* infoLog);
+	typedef GLuint (APIENTRY *CreateProgramProc)();
+	typedef void (APIENTRY *DeleteProgramProc)(GLuint program);
+	typedef void (APIENTRY *AttachShaderProc)(GLuint program, GLuint shader);
+	typedef void (APIENTRY *BindAttribLocationProc)(GLuint program, GLuint index, const char* name);
+	typedef void (APIENTRY *LinkProgramProc)(GLuint program);
+	typedef void (APIENTRY *GetProgramivProc)(GLuint program, GLenum pname, GLint* params);
+	typedef void (APIENTRY *GetProgramInfoLogProc)(GLuint program, GLsizei bufSize, GLsizei* length, char* infoLog);
+	typedef void (APIENTRY *UseProgramProc)(GLuint program);
+	typedef GLint (APIENTRY *GetUniformLocationProc)(GLuint program, const char* name);
+	typedef void (APIENTRY *Uniform1iProc)(GLint location, GLint v0);
+	typedef void (APIENTRY *Uniform4fvProc)(GLint location, GLsizei count, const GLfloat* value);
+	typedef void (APIENTRY *UniformMatrix4fvProc)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+	typedef void (APIENTRY *EnableVertexAttribArrayProc)(GLuint index);
+	typedef void (APIENTRY *DisableVertexAttribArrayProc)(GLuint index);
+	typedef void (APIENTRY *VertexAttribPointerProc)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+	typedef void (APIENTRY *VertexAttrib4fvProc)(GLuint index, const GLfloat* v);
+	typedef void (APIENTRY *VertexAttribDivisorProc)(GLuint index, GLuint divisor);
+	typedef void (APIENTRY *DrawElementsInstancedProc)(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount);
+	typedef GLuint (APIENTRY *GetUniformBlockIndexProc)(GLuint program, const char* uniformBlockName);
+	typedef void (APIENTRY *UniformBlockBindingProc)(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+	typedef void (APIENTRY *BindBufferBaseProc)(GLenum target, GLuint index, GLuint buffer);
+
+	/// <summary>
+	/// Looks up a function by name for the current context.
+	/// </summary>
+	typedef const void* (*LoaderProc)(const char* name);
+
+	/// <summary>
+	/// Fetches every function pointer from the current context. This should be called whenever a new window is made.
+	/// </summary>
+	/// <param name="loader">What to look the functions up with. If this is nullptr, they're looked up through SFML.</param>
+	/// <returns>Whether buffer objects are supported.</returns>
+	static bool Load(LoaderProc loader = nullptr);
+
+	/// <summary>
+	/// Returns whether vertex and index buffer objects can be used.
+	/// </summary>
+	/// <returns>Whether vertex and index buffer objects can be used.</returns>
+	static bool HasBuffers();
+
+	/// <summary>
+	/// Returns whether vertex array objects can be used.
+	/// </summary>
+	/// <returns>Whether vertex array objects can be used.</returns>
+	static bool HasVertexArrays();
+
+	/// <summary>
+	/// Returns whether shader programs can be used.
+	/// </summary>
+	/// <returns>Whether shader programs can be used.</returns>
+	static bool HasShaders();
+
+	/// <summary>
+	/// Returns whether instanced drawing can be used. This needs shaders, since fixed function has no way to read per-instance data.
+	/// </summary>
+	/// <returns>Whether instanced drawing can be used.</returns>
+	static bool HasInstancing();
+
+	/// <summary>
+	/// Returns whether uniform buffers can be used.
+	/// </summary>
+	/// <returns>Whether uniform buffers can be used.</returns>
+	static bool HasUniformBuffers();
+
+	/// <summary>
+	/// Returns whether everything can be drawn through shaders: instanced, with the camera and lights in uniform buffers.
+	/// If not, meshes are drawn one at a time with fixed function lighting instead.
+	/// </summary>
+	/// <returns>Whether the shader pipeline can be used.</returns>
+	static bool HasShaderPipeline();
+
+	/// <summary>
+	/// Returns a number that changes every time Load() is called. Objects that aren't shared between contexts (such as vertex arrays)
+	/// should remember this when they're made, and remake themselves if it changes.
+	/// </summary>
+	/// <returns>The current context generation.</returns>
+	static unsigned int GetContextGeneration();
+
+	static GenBuffersProc GenBuffers;
+	static DeleteBuffersProc DeleteBuffers;
+	static BindBufferProc BindBuffer;
+	static BufferDataProc BufferData;
+	static BufferSubDataProc BufferSubData;
+	static IsBufferProc IsBuffer;
+	static GenVertexArraysProc GenVertexArrays;
+	static DeleteVertexArraysProc DeleteVertexArrays;
+	static BindVertexArrayProc BindVertexArray;
+	static CreateShaderProc CreateShader;
+	static DeleteShaderProc DeleteShader;
+	static ShaderSourceProc ShaderSource;
+	static CompileShaderProc CompileShader;
+	static GetShaderivProc GetShaderiv;
+	static GetShaderInfoLogProc GetShaderInfoLog;
+	static CreateProgramProc CreateProgram;
+	static DeleteProgramProc DeleteProgram;
+	static AttachShaderProc AttachShader;
+	static BindAttribLocationProc BindAttribLocation;
+	static LinkProgramProc LinkProgram;
+	static GetProgramivProc GetProgramiv;
+	static GetProgramInfoLogProc GetProgramInfoLog;
+	static UseProgramProc UseProgram;
+	static GetUniformLocationProc GetUniformLocation;
+	static Uniform1iProc Uniform1i;
+	static Uniform4fvProc Uniform4fv;
+	static UniformMatrix4fvProc UniformMatrix4fv;
+	static EnableVertexAttribArrayProc EnableVertexAttribArray;
+	static DisableVertexAttribArrayProc DisableVertexAttribArray;
+	static VertexAttribPointerProc VertexAttribPointer;
+	static VertexAttrib4fvProc VertexAttrib4fv;
+	static VertexAttribDivisorProc VertexAttribDivisor;
+	static DrawElementsInstancedProc DrawElementsInstanced;
+	static GetUniformBlockIndexProc GetUniformBlockIndex;
+	static UniformBlockBindingProc UniformBlockBinding;
+	static BindBufferBaseProc BindBufferBase;
+
+	private:
+	/// <summary>
+	/// How many times Load() has been called.
+	/// </summary>
+	static unsigned int contextGeneration;
+};
@@ -0,0 +1,175 @@
+#include "GLStateCache.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include "GLExtensions.h"
+
+const std::array<GLenum, 8> GLStateCache::trackedCapabilities = {{
+	GL_DEPTH_TEST,
+	GL_CULL_FACE,
+	GL_LIGHTING,
+	GL_LIGHT0,
+	GL_BLEND,
+	GL_TEXTURE_2D,
+	GL_COLOR_MATERIAL,
+	GL_NORMALIZE
+}};
+
+GLStateCache::GLStateCache() {
+	issuedCalls = 0;
+	filteredCalls = 0;
+	lastIssuedCalls = 0;
+	lastFilteredCalls = 0;
+}
+
+GLStateCache::~GLStateCache() {
+}
+
+void GLStateCache::Invalidate() {
+	for (CachedValue<bool>& capability : capabilities) {
+		capability.known = false;
+	}
+	cullFace.known = false;
+	frontPolygonMode.known = false;
+	backPolygonMode.known = false;
+	depthMask.known = false;
+	blendFunc.known = false;
+	colorMask.known = false;
+	clearColor.known = false;
+	clearDepth.known = false;
+	color.known = false;
+	matrixMode.known = false;
+	projection.known = false;
+	program.known = false;
+}
+
+void GLStateCache::NewFrame() {
+	lastIssuedCalls = issuedCalls;
+	lastFilteredCalls = filteredCalls;
+	issuedCalls = 0;
+	filteredCalls = 0;
+}
+
+void GLStateCache::SetEnabled(GLenum capability, bool enabled) {
+	int index = CapabilityIndex(capability);
+	if (!Count(index < 0 || capabilities[index].Update(enabled))) {
+		return;
+	}
+	if (enabled) {
+		glEnable(capability);
+	} else {
+		glDisable(capability);
+	}
+}
+
+void GLStateCache::Enable(GLenum capability) {
+	SetEnabled(capability, true);
+}
+
+void GLStateCache::Disable(GLenum capability) {
+	SetEnabled(capability, false);
+}
+
+void GLStateCache::CullFace(GLenum mode) {
+	if (Count(cullFace.Update(mode))) {
+		glCullFace(mode);
+	}
+}
+
+void GLStateCache::PolygonMode(GLenum face, GLenum mode) {
+	bool changed = false;
+	if (face != GL_BACK) {
+		changed = frontPolygonMode.Update(mode) || changed;
+	}
+	if (face != GL_FRONT) {
+		changed = backPolygonMode.Update(mode) || changed;
+	}
+	if (Count(changed)) {
+		glPolygonMode(face, mode);
+	}
+}
+
+void GLStateCache::DepthMask(bool enabled) {
+	if (Count(depthMask.Update(enabled))) {
+		glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+}
+
+void GLStateCache::BlendFunc(GLenum source, GLenum destination) {
+	if (Count(blendFunc.Update(glm::uvec2(source, destination)))) {
+		glBlendFunc(source, destination);
+	}
+}
+
+void GLStateCache::ColorMask(bool red, bool green, bool blue, bool alpha) {
+	if (Count(colorMask.Update(glm::bvec4(red, green, blue, alpha)))) {
+		glColorMask(red ? GL_TRUE : GL_FALSE, green ? GL_TRUE : GL_FALSE, blue ? GL_TRUE : GL_FALSE, alpha ? GL_TRUE : GL_FALSE);
+	}
+}
+
+void GLStateCache::ClearColor(const glm::vec4& newColor) {
+	if (Count(clearColor.Update(newColor))) {
+		glClearColor(newColor.r, newColor.g, newColor.b, newColor.a);
+	}
+}
+
+void GLStateCache::ClearDepth(double depth) {
+	if (Count(clearDepth.Update(depth))) {
+		glClearDepth(depth);
+	}
+}
+
+void GLStateCache::Color(const glm::vec4& newColor) {
+	if (Count(color.Update(newColor))) {
+		glColor4f(newColor.r, newColor.g, newColor.b, newColor.a);
+	}
+}
+
+void GLStateCache::MatrixMode(GLenum mode) {
+	if (Count(matrixMode.Update(mode))) {
+		glMatrixMode(mode);
+	}
+}
+
+void GLStateCache::Projection(const glm::mat4& newProjection) {
+	if (Count(projection.Update(newProjection))) {
+		MatrixMode(GL_PROJECTION);
+		glLoadMatrixf(glm::value_ptr(newProjection));
+	}
+	MatrixMode(GL_MODELVIEW);
+}
+
+void GLStateCache::UseProgram(unsigned int newProgram) {
+	if (GLExtensions::UseProgram == nullptr) {
+		return;
+	}
+	if (Count(program.Update(newProgram))) {
+		GLExtensions::UseProgram(newProgram);
+	}
+}
+
+size_t GLStateCache::GetIssuedCalls() const {
+	return lastIssuedCalls;
+}
+
+size_t GLStateCache::GetFilteredCalls() const {
+	return lastFilteredCalls;
+}
+
+bool GLStateCache::Count(bool changed) {
+	if (changed) {
+		++issuedCalls;
+	} else {
+		++filteredCalls;
+	}
+	return changed;
+}
+
+int GLStateCache::CapabilityIndex(GLenum capability) {
+	for (size_t i = 0; i < trackedCapabilities.size(); ++i) {
+		if (trackedCapabilities[i] == capability) {
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
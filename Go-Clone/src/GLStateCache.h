@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <SFML/OpenGL.hpp>
+
+/// <summary>
+/// A shadow copy of the OpenGL state the engine touches. Every setter compares against what it last set and only calls into GL
+/// if the value actually changes, since redundant state changes are a large part of the CPU cost of drawing (especially on
+/// software drivers). Anything that changes state behind its back must call Invalidate() afterwards.
+/// </summary>
+class GLStateCache {
+	public:
+	GLStateCache();
+	~GLStateCache();
+
+	/// <summary>
+	/// Forgets everything, so that the next call to every setter goes through to GL. This should be called whenever the
+	/// context is recreated, or after code that changes state without going through the cache.
+	/// </summary>
+	void Invalidate();
+
+	/// <summary>
+	/// Moves the call counters into the last frame's counters and starts counting again.
+	/// </summary>
+	void NewFrame();
+
+	/// <summary>
+	/// Enables or disables a capability, like glEnable() and glDisable(). Capabilities that aren't tracked always go through.
+	/// </summary>
+	/// <param name="capability">The capability to change.</param>
+	/// <param name="enabled">Whether it should be enabled.</param>
+	void SetEnabled(GLenum capability, bool enabled);
+
+	/// <summary>
+	/// Enables a capability. This is the same as SetEnabled(capability, true).
+	/// </summary>
+	/// <param name="capability">The capability to enable.</param>
+	void Enable(GLenum capability);
+
+	/// <summary>
+	/// Disables a capability. This is the same as SetEnabled(capability, false).
+	/// </summary>
+	/// <param name="capability">The capability to disable.</param>
+	void Disable(GLenum capability);
+
+	/// <summary>
+	/// Sets which faces get culled, like glCullFace().
+	/// </summary>
+	/// <param name="mode">GL_FRONT, GL_BACK or GL_FRONT_AND_BACK.</param>
+	void CullFace(GLenum mode);
+
+	/// <summary>
+	/// Sets how polygons are rasterised, like glPolygonMode().
+	/// </summary>
+	/// <param name="face">GL_FRONT, GL_BACK or GL_FRONT_AND_BACK.</param>
+	/// <param name="mode">GL_POINT, GL_LINE or GL_FILL.</param>
+	void PolygonMode(GLenum face, GLenum mode);
+
+	/// <summary>
+	/// Sets whether depth is written, like glDepthMask().
+	/// </summary>
+	/// <param name="enabled">Whether depth should be written.</param>
+	void DepthMask(bool enabled);
+
+	/// <summary>
+	/// Sets how new colours are blended with what's already there, like glBlendFunc(). Blending still needs GL_BLEND enabled.
+	/// </summary>
+	/// <param name="source">The factor the new colour is multiplied by.</param>
+	/// <param name="destination">The factor the existing colour is multiplied by.</param>
+	void BlendFunc(GLenum source, GLenum destination);
+
+	/// <summary>
+	/// Sets which colour channels are written, like glColorMask().
+	/// </summary>
+	/// <param name="red">Whether red is written.</param>
+	/// <param name="green">Whether green is written.</param>
+	/// <param name="blue">Whether blue is written.</param>
+	/// <param name="alpha">Whether alpha is written.</param>
+	void ColorMask(bool red, bool green, bool blue, bool alpha);
+
+	/// <summary>
+	/// Sets the colour the colour buffer is cleared to, like glClearColor().
+	/// </summary>
+	/// <param name="color">The clear colour.</param>
+	void ClearColor(const glm::vec4& color);
+
+	/// <summary>
+	/// Sets the value the depth buffer is cleared to, like glClearDepth().
+	/// </summary>
+	/// <param name="depth">The clear depth.</param>
+	void ClearDepth(double depth);
+
+	/// <summary>
+	/// Sets the current vertex colour, like glColor4f().
+	/// </summary>
+	/// <param name="color">The colour.</param>
+	void Color(const glm::vec4& color);
+
+	/// <summary>
+	/// Sets which matrix stack the matrix functions change, like glMatrixMode().
+	/// </summary>
+	/// <param name="mode">GL_MODELVIEW or GL_PROJECTION.</param>
+	void MatrixMode(GLenum mode);
+
+	/// <summary>
+	/// Loads the given matrix into the projection stack. The modelview stack is left as the current stack afterwards.
+	/// </summary>
+	/// <param name="projection">The projection matrix.</param>
+	void Projection(const glm::mat4& projection);
+
+	/// <summary>
+	/// Sets the current program, like glUseProgram(). 0 goes back to fixed function.
+	/// </summary>
+	/// <param name="program">The program to use.</param>
+	void UseProgram(unsigned int program);
+
+	/// <summary>
+	/// Returns the number of calls that went through to GL during the last frame.
+	/// </summary>
+	/// <returns>The number of calls that went through to GL during the last frame.</returns>
+	size_t GetIssuedCalls() const;
+
+	/// <summary>
+	/// Returns the number of calls that were skipped during the last frame because they wouldn't have changed anything.
+	/// </summary>
+	/// <returns>The number of calls that were skipped during the last frame.</returns>
+	size_t GetFilteredCalls() const;
+
+	private:
+	/// <summary>
+	/// A single piece of state, and whether it's known at all.
+	/// </summary>
+	template <typename T>
+	struct CachedValue {
+		CachedValue() : known(false), value() {}
+
+		/// <summary>
+		/// Stores a new value.
+		/// </summary>
+		/// <param name="newValue">The new value.</param>
+		/// <returns>Whether the value changed (or wasn't known), meaning GL needs to be told.</returns>
+		bool Update(const T& newValue) {
+			if (known && value == newValue) {
+				return false;
+			}
+			known = true;
+			value = newValue;
+			return true;
+		}
+
+		bool known;
+		T value;
+	};
+
+	/// <summary>
+	/// Counts a call, and returns whether it needs to go through.
+	/// </summary>
+	/// <param name="changed">Whether the call changes anything.</param>
+	/// <returns>The same as changed.</returns>
+	bool Count(bool changed);
+
+	/// <summary>
+	/// Returns where a capability is kept in the table.
+	/// </summary>
+	/// <param name="capability">The capability.</param>
+	/// <returns>Its index, or -1 if it isn't tracked.</returns>
+	static int CapabilityIndex(GLenum capability);
+
+	/// <summary>
+	/// The capabilities that are tracked.
+	/// </summary>
+	static const std::array<GLenum, 8> trackedCapabilities;
+
+	/// <summary>
+	/// Whether each tracked capability is enabled.
+	/// </summary>
+	std::array<CachedValue<bool>, 8> capabilities;
+
+	CachedValue<GLenum> cullFace;
+	CachedValue<GLenum> frontPolygonMode;
+	CachedValue<GLenum> backPolygonMode;
+	CachedValue<bool> depthMask;
+	CachedValue<glm::uvec2> blendFunc;
+	CachedValue<glm::bvec4> colorMask;
+	CachedValue<glm::vec4> clearColor;
+	CachedValue<double> clearDepth;
+	CachedValue<glm::vec4> color;
+	CachedValue<GLenum> matrixMode;
+	CachedValue<glm::mat4> projection;
+	CachedValue<unsigned int> program;
+
+	/// <summary>
+	/// The number of calls that went through to GL so far this frame.
+	/// </summary>
+	size_t issuedCalls;
+
+	/// <summary>
+	/// The number of calls that were skipped so far this frame.
+	/// </summary>
+	size_t filteredCalls;
+
+	/// <summary>
+	/// The number of calls that went through to GL during the last frame.
+	/// </summary>
+	size_t lastIssuedCalls;
+
+	/// <summary>
+	/// The number of calls that were skipped during the last frame.
+	/// </summary>
+	size_t lastFilteredCalls;
+};
@@ -0,0 +1,53 @@
+#include "GPUResource.h"
+
+#include <mutex>
+#include <vector>
+
+/// <summary>
+/// Every live resource. This is made on first use so that it outlives anything that's registered in it, including static caches.
+/// </summary>
+static std::vector<GPUResource*>& Registry() {
+	static std::vector<GPUResource*> registry;
+	return registry;
+}
+
+/// <summary>
+/// Guards the registry, in case a resource is dropped on another thread.
+/// </summary>
+static std::mutex& RegistryMutex() {
+	static std::mutex registryMutex;
+	return registryMutex;
+}
+
+GPUResource::GPUResource() {
+	std::lock_guard<std::mutex> lock(RegistryMutex());
+	registryIndex = Registry().size();
+	Registry().push_back(this);
+}
+
+GPUResource::~GPUResource() {
+	std::lock_guard<std::mutex> lock(RegistryMutex());
+	// The last resource takes this one's place so that nothing needs to shift down.
+	std::vector<GPUResource*>& registry = Registry();
+	registry[registryIndex] = registry.back();
+	registry[registryIndex]->registryIndex = registryIndex;
+	registry.pop_back();
+}
+
+size_t GPUResource::RestoreAll() {
+	// A copy is restored from so that anything made while restoring (which is already in the new context) isn't done twice.
+	std::vector<GPUResource*> resources;
+	{
+		std::lock_guard<std::mutex> lock(RegistryMutex());
+		resources = Registry();
+	}
+	for (GPUResource* resource : resources) {
+		resource->Restore();
+	}
+	return resources.size();
+}
+
+size_t GPUResource::GetCount() {
+	std::lock_guard<std::mutex> lock(RegistryMutex());
+	return Registry().size();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+/// <summary>
+/// Something that keeps objects on the graphics card along with a copy of what's in them on the CPU.
+/// Every resource is registered while it's alive, so that if the context they were made in is lost, they can all be remade at once
+/// rather than as each one happens to be drawn.
+/// </summary>
+class GPUResource {
+	public:
+	GPUResource();
+	virtual ~GPUResource();
+
+	GPUResource(const GPUResource&) = delete;
+	GPUResource& operator=(const GPUResource&) = delete;
+
+	/// <summary>
+	/// Remakes every resource from its CPU copy. This should only be called once a new context is current and the old one is gone,
+	/// since the old objects are forgotten rather than deleted.
+	/// </summary>
+	/// <returns>How many resources were restored.</returns>
+	static size_t RestoreAll();
+
+	/// <summary>
+	/// Returns how many resources are alive.
+	/// </summary>
+	/// <returns>How many resources are alive.</returns>
+	static size_t GetCount();
+
+	protected:
+	/// <summary>
+	/// Forgets the objects that went with the old context and remakes them in the current one.
+	/// Anything that was never sent to the graphics card can stay that way until it's needed.
+	/// </summary>
+	virtual void Restore() = 0;
+
+	private:
+	/// <summary>
+	/// Where this resource is in the registry.
+	/// </summary>
+	size_t registryIndex;
+};
@@ -0,0 +1,109 @@
+#include "GameArguments.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "AssetLoader.h"
+#include "Log.h"
+
+GameArguments::GameArguments() {
+	headless = false;
+	width = 800;
+	height = 600;
+	frameLimit = 0;
+	captureInterval = 1;
+	benchmark = false;
+	benchmarkObjects = 1000;
+	benchmarkDepth = 1;
+	benchmarkFanOut = 4;
+	benchmarkAnimated = 0.5f;
+	benchmarkStones = false;
+	benchmarkLOD = false;
+	benchmarkLabels = false;
+	uploadBudget = static_cast<uint32_t>(AssetLoader::defaultUploadBudget / 1024);
+#ifdef _WIN32
+	fontPath = "C:\\Windows\\Fonts\\consola.ttf";
+#endif
+	glyphCachePath = "Glyphs.sdf";
+	replayRecordedTiming = false;
+}
+
+GameArguments GameArguments::Parse(int argc, char* argv[]) {
+	GameArguments arguments;
+	for (int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		// Everything other than the switches takes a value.
+		bool hasValue = i + 1 < argc;
+		if (argument == "--headless") {
+			arguments.headless = true;
+		} else if (argument == "--benchmark") {
+			arguments.benchmark = true;
+		} else if (argument == "--stones") {
+			arguments.benchmarkStones = true;
+		} else if (argument == "--lod") {
+			arguments.benchmarkLOD = true;
+		} else if (argument == "--labels") {
+			arguments.benchmarkLabels = true;
+		} else if (argument == "--width" && hasValue) {
+			arguments.width = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--height" && hasValue) {
+			arguments.height = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--frames" && hasValue) {
+			arguments.frameLimit = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--capture" && hasValue) {
+			arguments.capturePrefix = argv[++i];
+		} else if (argument == "--capture-every" && hasValue) {
+			arguments.captureInterval = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--timings" && hasValue) {
+			arguments.timingsPath = argv[++i];
+		} else if (argument == "--objects" && hasValue) {
+			arguments.benchmarkObjects = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--depth" && hasValue) {
+			arguments.benchmarkDepth = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--fan-out" && hasValue) {
+			arguments.benchmarkFanOut = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--animated" && hasValue) {
+			arguments.benchmarkAnimated = static_cast<float>(std::strtod(argv[++i], nullptr));
+		} else if (argument == "--stone-mesh" && hasValue) {
+			arguments.stoneMeshPath = argv[++i];
+		} else if (argument == "--upload-budget" && hasValue) {
+			arguments.uploadBudget = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--font" && hasValue) {
+			arguments.fontPath = argv[++i];
+		} else if (argument == "--glyph-cache" && hasValue) {
+			arguments.glyphCachePath = argv[++i];
+		} else if (argument == "--log" && hasValue) {
+			arguments.logPath = argv[++i];
+		} else if (argument == "--record" && hasValue) {
+			arguments.recordPath = argv[++i];
+		} else if (argument == "--replay" && hasValue) {
+			arguments.replayPath = argv[++i];
+		} else if (argument == "--replay-timing" && hasValue) {
+			std::string timing = argv[++i];
+			if (timing == "recorded" || timing == "fast") {
+				arguments.replayRecordedTiming = timing == "recorded";
+			} else {
+				LOG_WARNING("The replay timing must be recorded or fast, using fast.");
+			}
+		} else {
+			LOG_WARNING("Ignoring unknown argument {}.", argument);
+		}
+	}
+
+	if (arguments.width == 0 || arguments.height == 0) {
+		LOG_WARNING("The width and height must be above 0, using 800x600.");
+		arguments.width = 800;
+		arguments.height = 600;
+	}
+	if (arguments.captureInterval == 0) {
+		arguments.captureInterval = 1;
+	}
+	if (arguments.benchmark && arguments.frameLimit == 0) {
+		arguments.frameLimit = defaultBenchmarkFrames;
+	}
+	if (arguments.benchmarkDepth == 0) {
+		arguments.benchmarkDepth = 1;
+	}
+	arguments.benchmarkAnimated = std::min(std::max(arguments.benchmarkAnimated, 0.0f), 1.0f);
+	return arguments;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// The options the game was started with. These come from the command line, and anything not given is left as its default.
+/// </summary>
+struct GameArguments {
+	GameArguments();
+
+	/// <summary>
+	/// Reads the options from the command line. Anything that isn't recognised is reported and skipped.
+	/// </summary>
+	/// <param name="argc">The number of arguments, as given to main().</param>
+	/// <param name="argv">The arguments, as given to main().</param>
+	/// <returns>The options.</returns>
+	static GameArguments Parse(int argc, char* argv[]);
+
+	/// <summary>
+	/// The number of frames a benchmark runs for if --frames isn't given.
+	/// </summary>
+	static const uint32_t defaultBenchmarkFrames = 300;
+
+	/// <summary>
+	/// Whether to render into an offscreen buffer instead of opening a window (--headless).
+	/// </summary>
+	bool headless;
+
+	/// <summary>
+	/// The width of the window or offscreen buffer (--width).
+	/// </summary>
+	uint32_t width;
+
+	/// <summary>
+	/// The height of the window or offscreen buffer (--height).
+	/// </summary>
+	uint32_t height;
+
+	/// <summary>
+	/// How many frames to run before exiting, or 0 to run until the window is closed (--frames).
+	/// A headless game always stops, so 0 means a single frame there.
+	/// </summary>
+	uint32_t frameLimit;
+
+	/// <summary>
+	/// Where to save captured frames. Each frame is saved as this followed by its number and ".png". Empty means nothing is captured (--capture).
+	/// </summary>
+	std::string capturePrefix;
+
+	/// <summary>
+	/// How often to capture a frame. 1 captures every frame, 10 every tenth, and so on (--capture-every).
+	/// </summary>
+	uint32_t captureInterval;
+
+	/// <summary>
+	/// Where to write the time each frame took, as a CSV file. Empty means the timings aren't written (--timings).
+	/// </summary>
+	std::string timingsPath;
+
+	/// <summary>
+	/// Whether to fill the scene with generated objects instead of the usual scene, and report how long the frames took (--benchmark).
+	/// </summary>
+	bool benchmark;
+
+	/// <summary>
+	/// How many objects the benchmark scene has (--objects).
+	/// </summary>
+	uint32_t benchmarkObjects;
+
+	/// <summary>
+	/// How many levels deep each tree of objects in the benchmark scene goes. 1 means every object is at the top (--depth).
+	/// </summary>
+	uint32_t benchmarkDepth;
+
+	/// <summary>
+	/// How many children each object in the benchmark scene has, apart from the ones on the last level (--fan-out).
+	/// </summary>
+	uint32_t benchmarkFanOut;
+
+	/// <summary>
+	/// The fraction of objects in the benchmark scene that move every frame, from 0 to 1 (--animated).
+	/// </summary>
+	float benchmarkAnimated;
+
+	/// <summary>
+	/// Whether the benchmark scene is made of stones rather than cubes (--stones).
+	/// </summary>
+	bool benchmarkStones;
+
+	/// <summary>
+	/// Whether the benchmark stones pick their level of detail by how big they look (--lod).
+	/// </summary>
+	bool benchmarkLOD;
+
+	/// <summary>
+	/// Whether every object in the benchmark scene is labelled with its number (--labels).
+	/// </summary>
+	bool benchmarkLabels;
+
+	/// <summary>
+	/// An OBJ file to stream in for the stones once the game has started. The built in stone is drawn until it arrives (--stone-mesh).
+	/// </summary>
+	std::string stoneMeshPath;
+
+	/// <summary>
+	/// Roughly how many kilobytes of loaded assets are uploaded per frame (--upload-budget).
+	/// </summary>
+	uint32_t uploadBudget;
+
+	/// <summary>
+	/// The TrueType font all text is drawn with. Without one, no text is drawn (--font).
+	/// </summary>
+	std::string fontPath;
+
+	/// <summary>
+	/// Where the font's glyph atlas is cached between runs. Empty means it's built every time (--glyph-cache).
+	/// </summary>
+	std::string glyphCachePath;
+
+	/// <summary>
+	/// Where to record the input of every frame, so the run can be replayed. Empty means nothing is recorded (--record).
+	/// </summary>
+	std::string recordPath;
+
+	/// <summary>
+	/// An input recording to play back instead of reading input from the window. The game stops at the end of it unless --frames
+	/// is given (--replay).
+	/// </summary>
+	std::string replayPath;
+
+	/// <summary>
+	/// Whether a replay waits to run at the speed it was recorded at, rather than as fast as it can (--replay-timing recorded|fast).
+	/// </summary>
+	bool replayRecordedTiming;
+
+	/// <summary>
+	/// Where to write the log. Empty means it goes to the console (--log).
+	/// </summary>
+	std::string logPath;
+};
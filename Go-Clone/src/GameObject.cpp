@@ -1,7 +1,5 @@
 #include "GameObject.h"
 
-#include <SFML/OpenGL.hpp>
-
 #include "GoGame.h"
 #include "Transform.h"
 
@@ -29,34 +27,33 @@ GoGame* GameObject::GetEngine() {
 	return engine;
 }
 
-void GameObject::RenderCall() {
+void GameObject::CollectDrawCommands(RenderQueue& queue, const glm::mat4& parentMatrix) {
 	//TODO: Add a is enabled call.
-	glPushMatrix();
+	glm::mat4 worldMatrix = GetWorldMatrix(parentMatrix);
+	SubmitDrawCommands(queue, worldMatrix);
+
+	for (auto& childPair : children) {
+		std::shared_ptr<GameObject> child = std::shared_ptr<GameObject>(childPair.second);
+		child->CollectDrawCommands(queue, worldMatrix);
+	}
+}
+
+glm::mat4 GameObject::GetWorldMatrix(const glm::mat4& parentMatrix) {
 	std::shared_ptr<Transform> transform = GetComponent<Transform>();
 	if (transform != nullptr) {
-		glTranslatef(transform->Translate().x, transform->Translate().y, transform->Translate().z);
-		//TODO: Formally do the radians to degrees business. This is...ergh...
-		glRotatef(transform->Rotate().x * 180.0f / 3.14f, 1.0f, 0.0f, 0.0f);
-		glRotatef(transform->Rotate().y * 180.0f / 3.14f, 0.0f, 1.0f, 0.0f);
-		glRotatef(transform->Rotate().z * 180.0f / 3.14f, 0.0f, 0.0f, 1.0f);
-		glScalef(transform->Scale().x, transform->Scale().y, transform->Scale().z);
+		return parentMatrix * transform->GetMatrix();
 	}
+	return parentMatrix;
+}
 
-	std::vector<std::shared_ptr<Renderable>> renderComponents = GetComponents<Renderable>();
-
-	// Your render components should modify anything, so this should be fine.
-	for (auto& renderComponent : renderComponents) {
-		if (renderComponent->IsActive()) {
-			renderComponent->Render();
+void GameObject::SubmitDrawCommands(RenderQueue& queue, const glm::mat4& worldMatrix) {
+	// This is walked every frame, so the components are checked in place rather than copied out with GetComponents().
+	for (auto& component : components) {
+		Renderable* renderComponent = dynamic_cast<Renderable*>(component.get());
+		if (renderComponent != nullptr && renderComponent->IsActive()) {
+			renderComponent->Submit(queue, worldMatrix);
 		}
 	}
-
-	for (auto& childPair : children) {
-		std::shared_ptr<GameObject> child = std::shared_ptr<GameObject>(childPair.second);
-		child->RenderCall();
-	}
-
-	glPopMatrix();
 }
 
 GameObject::GameObject() {
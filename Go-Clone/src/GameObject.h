@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include <glm/mat4x4.hpp>
+
 #include "Component.h"
 #include "GoGame.h"
 
@@ -173,10 +175,27 @@ class GameObject {
 	class GoGame* GetEngine();
 
 	/// <summary>
-	/// Calls the render function on any renderable components, then calls this on any children.
+	/// Has any renderable components add their draw commands to the queue, then calls this on any children.
+	/// Nothing is drawn here; the renderer sorts and draws the queue once the whole scene has been walked.
 	/// This doesn't need to be called manually, the engine should call this itself.
 	/// </summary>
-	void RenderCall();
+	/// <param name="queue">The queue to add draw commands to.</param>
+	/// <param name="parentMatrix">The world matrix of the parent object.</param>
+	void CollectDrawCommands(RenderQueue& queue, const glm::mat4& parentMatrix);
+
+	/// <summary>
+	/// Returns the world matrix of this object, given the world matrix of its parent.
+	/// </summary>
+	/// <param name="parentMatrix">The world matrix of the parent object.</param>
+	/// <returns>The world matrix of this object.</returns>
+	glm::mat4 GetWorldMatrix(const glm::mat4& parentMatrix);
+
+	/// <summary>
+	/// Has any renderable components add their draw commands to the queue, without going into the children.
+	/// </summary>
+	/// <param name="queue">The queue to add draw commands to.</param>
+	/// <param name="worldMatrix">The world matrix of this object.</param>
+	void SubmitDrawCommands(RenderQueue& queue, const glm::mat4& worldMatrix);
 
 	protected:
 	/// <summary>
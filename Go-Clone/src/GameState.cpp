@@ -1,10 +1,243 @@
 #include "GameState.h"
 
+#include "Zobrist.h"
 
 
-GameState::GameState() {
+
+GameState::GameState(uint32_t size, ESuperko superko) : superko(superko) {
+	NewGame(size);
+}
+
+GameState::GameState(const GameState& other) : board(other.board->Clone()), superko(other.superko), history(other.history), toMove(other.toMove), koPoint(other.koPoint), captures(other.captures), passCount(other.passCount), moveNumber(other.moveNumber), journalPosition(other.journalPosition), journalLength(other.journalLength) {
+	CopyJournal(other);
+}
+
+GameState& GameState::operator=(const GameState& other) {
+	if (this != &other) {
+		// The board, history and journal are copied into what's already here, so going back to a saved position doesn't allocate.
+		if (board->GetSize() == other.board->GetSize()) {
+			board->CopyFrom(*other.board);
+		} else {
+			board = other.board->Clone();
+		}
+		superko = other.superko;
+		history = other.history;
+		toMove = other.toMove;
+		koPoint = other.koPoint;
+		captures = other.captures;
+		passCount = other.passCount;
+		moveNumber = other.moveNumber;
+		CopyJournal(other);
+		journalPosition = other.journalPosition;
+		journalLength = other.journalLength;
+	}
+	return *this;
 }
 
 
 GameState::~GameState() {
 }
+
+void GameState::NewGame(uint32_t size) {
+	if (board == nullptr || board->GetSize() != size) {
+		board = Board::Create(size);
+	} else {
+		board->Clear();
+	}
+	toMove = EPlayer::EBlack;
+	koPoint = Board::noPoint;
+	captures.fill(0);
+	passCount = 0;
+	moveNumber = 0;
+	history.Clear();
+	history.Insert(GetHistoryKey(board->GetHash(), toMove));
+	journalPosition = 0;
+	journalLength = 0;
+}
+
+const Board& GameState::GetBoard() const {
+	return *board;
+}
+
+bool GameState::IsLegal(uint32_t point) const {
+	return point < board->GetPointCount() && point != koPoint && board->GetPlayable(toMove).Get(point) && !RepeatsPosition(point);
+}
+
+Bitboard GameState::GetLegalMoves() const {
+	Bitboard moves = board->GetPlayable(toMove);
+	if (koPoint != Board::noPoint) {
+		moves.Reset(koPoint);
+	}
+	return moves;
+}
+
+bool GameState::Play(uint32_t point) {
+	if (!IsLegal(point)) {
+		return false;
+	}
+	JournalEntry& entry = StartJournalEntry(point);
+	Bitboard captured = board->Play(point, toMove, entry.change);
+	uint32_t capturedCount = captured.Count();
+	captures[static_cast<uint32_t>(toMove) - 1] += capturedCount;
+	entry.capturedCount = capturedCount;
+
+	// Taking a single stone with a single stone that's left in atari is a ko, and the stone taken can't be retaken straight away.
+	koPoint = Board::noPoint;
+	if (capturedCount == 1 && board->GetChainSize(point) == 1 && board->IsInAtari(point)) {
+		koPoint = captured.First();
+	}
+
+	toMove = GetOpponent(toMove);
+	passCount = 0;
+	++moveNumber;
+	entry.addedToHistory = history.Insert(GetHistoryKey(board->GetHash(), toMove));
+	journalLength = journalPosition;
+	return true;
+}
+
+void GameState::Pass() {
+	JournalEntry& entry = StartJournalEntry(Board::noPoint);
+	entry.capturedCount = 0;
+	koPoint = Board::noPoint;
+	toMove = GetOpponent(toMove);
+	++passCount;
+	++moveNumber;
+	entry.addedToHistory = history.Insert(GetHistoryKey(board->GetHash(), toMove));
+	journalLength = journalPosition;
+}
+
+bool GameState::Undo() {
+	if (journalPosition == 0) {
+		return false;
+	}
+	const JournalEntry& entry = journal[--journalPosition];
+	if (entry.addedToHistory) {
+		history.Erase(GetHistoryKey(board->GetHash(), toMove));
+	}
+	toMove = GetOpponent(toMove);
+	if (entry.point != Board::noPoint) {
+		board->Undo(entry.change);
+		captures[static_cast<uint32_t>(toMove) - 1] -= entry.capturedCount;
+	}
+	koPoint = entry.previousKoPoint;
+	passCount = entry.previousPassCount;
+	--moveNumber;
+	return true;
+}
+
+bool GameState::Redo() {
+	if (journalPosition == journalLength) {
+		return false;
+	}
+	// Making the move again writes the same entry over itself, and the moves after it are kept.
+	size_t length = journalLength;
+	uint32_t point = journal[journalPosition].point;
+	if (point == Board::noPoint) {
+		Pass();
+	} else {
+		Play(point);
+	}
+	journalLength = length;
+	return true;
+}
+
+bool GameState::CanUndo() const {
+	return journalPosition != 0;
+}
+
+bool GameState::CanRedo() const {
+	return journalPosition != journalLength;
+}
+
+EPlayer GameState::GetToMove() const {
+	return toMove;
+}
+
+uint32_t GameState::GetKoPoint() const {
+	return koPoint;
+}
+
+uint32_t GameState::GetCaptures(EPlayer player) const {
+	return player == EPlayer::ENone ? 0 : captures[static_cast<uint32_t>(player) - 1];
+}
+
+uint32_t GameState::GetPassCount() const {
+	return passCount;
+}
+
+uint32_t GameState::GetMoveNumber() const {
+	return moveNumber;
+}
+
+uint64_t GameState::GetHash() const {
+	uint64_t hash = board->GetHash();
+	if (toMove == EPlayer::EWhite) {
+		hash ^= Zobrist::GetWhiteToMoveKey();
+	}
+	if (koPoint != Board::noPoint) {
+		hash ^= Zobrist::GetKoKey(koPoint);
+	}
+	return hash;
+}
+
+ESuperko GameState::GetSuperko() const {
+	return superko;
+}
+
+void GameState::SavePosition(Position& position) const {
+	if (position.board != nullptr && position.board->GetSize() == board->GetSize()) {
+		position.board->CopyFrom(*board);
+	} else {
+		position.board = board->Clone();
+	}
+	position.toMove = toMove;
+	position.koPoint = koPoint;
+	position.captures = captures;
+	position.passCount = passCount;
+	position.moveNumber = moveNumber;
+}
+
+void GameState::LoadPosition(const Position& position) {
+	board->CopyFrom(*position.board);
+	toMove = position.toMove;
+	koPoint = position.koPoint;
+	captures = position.captures;
+	passCount = position.passCount;
+	moveNumber = position.moveNumber;
+	history.Clear();
+	history.Insert(GetHistoryKey(board->GetHash(), toMove));
+	journalPosition = 0;
+	journalLength = 0;
+}
+
+void GameState::AddToHistory(uint64_t boardHash, EPlayer player) {
+	history.Insert(GetHistoryKey(boardHash, player));
+}
+
+void GameState::CopyJournal(const GameState& other) {
+	// Entries past the end of the journal are left over from undone moves that were played over, so they aren't worth copying.
+	journal.assign(other.journal.begin(), other.journal.begin() + other.journalLength);
+}
+
+GameState::JournalEntry& GameState::StartJournalEntry(uint32_t point) {
+	if (journalPosition == journal.size()) {
+		// Room is only made once a move is journaled, so games that are copied and thrown away don't pay for it.
+		if (journal.capacity() == 0) {
+			journal.reserve(journalCapacity);
+		}
+		journal.emplace_back();
+	}
+	JournalEntry& entry = journal[journalPosition++];
+	entry.point = point;
+	entry.previousKoPoint = koPoint;
+	entry.previousPassCount = passCount;
+	return entry;
+}
+
+bool GameState::RepeatsPosition(uint32_t point) const {
+	return superko != ESuperko::ENone && history.Contains(GetHistoryKey(board->GetHashAfter(point, toMove), GetOpponent(toMove)));
+}
+
+uint64_t GameState::GetHistoryKey(uint64_t boardHash, EPlayer player) const {
+	return superko == ESuperko::ESituational && player == EPlayer::EWhite ? boardHash ^ Zobrist::GetWhiteToMoveKey() : boardHash;
+}
@@ -1,11 +1,298 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Board.h"
+#include "Constants.h"
+#include "PositionSet.h"
+
+/// <summary>
+/// Which positions can't be repeated, beyond the simple ko.
+/// </summary>
+enum class ESuperko : uint8_t {
+	/// <summary>
+	/// Only the simple ko applies.
+	/// </summary>
+	ENone,
+
+	/// <summary>
+	/// No move can make the stones on the board the same as they've been before.
+	/// </summary>
+	EPositional,
+
+	/// <summary>
+	/// No move can make the stones the same as they've been before with the same player to move.
+	/// </summary>
+	ESituational
+};
+
 /// <summary>
 /// Handles game critical variables. Should only belong to the engine, but can be viewable by other objects.
+/// Moves are played through here, which applies the rules: whose turn it is, captures, suicide and ko.
 /// </summary>
 class GameState {
 	public:
-	GameState();
+	/// <summary>
+	/// Where a game is, without the history and journal of how it got there. Saving over a position that's been saved to before
+	/// copies into the board it already has.
+	/// </summary>
+	struct Position {
+		std::shared_ptr<Board> board;
+		EPlayer toMove;
+		uint32_t koPoint;
+		std::array<uint32_t, 2> captures;
+		uint32_t passCount;
+		uint32_t moveNumber;
+	};
+
+	/// <summary>
+	/// Starts with an empty board.
+	/// </summary>
+	/// <param name="size">The width of the board. Only 9, 13 and 19 are supported.</param>
+	/// <param name="superko">Which repeated positions are illegal.</param>
+	GameState(uint32_t size = Board::maxSize, ESuperko superko = ESuperko::EPositional);
+
+	/// <summary>
+	/// Copies a game, including its own copy of the board.
+	/// </summary>
+	GameState(const GameState& other);
+	GameState& operator=(const GameState& other);
 	~GameState();
-};
 
+	/// <summary>
+	/// Clears the board for a new game. Black plays first. This is where the rules compiled for the size are picked, so a new board
+	/// is only made if the size changes.
+	/// </summary>
+	/// <param name="size">The width of the board. Only 9, 13 and 19 are supported.</param>
+	void NewGame(uint32_t size);
+
+	/// <summary>
+	/// Returns the board.
+	/// </summary>
+	/// <returns>The board.</returns>
+	const Board& GetBoard() const;
+
+	/// <summary>
+	/// Returns whether the player to move can play on a point. The point has to be empty, not retake a ko, not be suicide, and not
+	/// repeat an earlier position under the superko rule.
+	/// </summary>
+	/// <param name="point">The point.</param>
+	/// <returns>Whether the move is legal.</returns>
+	bool IsLegal(uint32_t point) const;
+
+	/// <summary>
+	/// Returns the points the player to move can play on, ko included. This is a bitboard kept up to date as moves are played, so
+	/// enumerating the moves is a bit scan. Superko isn't taken out, since repeats are rare and looking for them means working out
+	/// the position after every move; check IsLegal() on a move before playing it when superko matters.
+	/// </summary>
+	/// <returns>The points that can be played on.</returns>
+	Bitboard GetLegalMoves() const;
+
+	/// <summary>
+	/// Picks a legal move for the player to move at random, with every legal move as likely as any other. The moves are counted and
+	/// one is picked straight from the bitboard, so this doesn't slow down as the board fills up; a move that breaks superko is
+	/// dropped and another picked.
+	/// </summary>
+	/// <param name="random">The random number generator to use.</param>
+	/// <returns>The move, or Board::noPoint if there's nothing to do but pass.</returns>
+	template <typename Random>
+	uint32_t GetRandomLegalMove(Random& random) const {
+		Bitboard candidates = GetLegalMoves();
+		for (uint32_t count = candidates.Count(); count != 0; --count) {
+			uint32_t point = candidates.Select(std::uniform_int_distribution<uint32_t>(0, count - 1)(random));
+			if (!RepeatsPosition(point)) {
+				return point;
+			}
+			candidates.Reset(point);
+		}
+		return Board::noPoint;
+	}
+
+	/// <summary>
+	/// Plays a stone for the player to move, and passes the turn over.
+	/// </summary>
+	/// <param name="point">The point to play on.</param>
+	/// <returns>Whether the move was legal. Nothing changes if it wasn't.</returns>
+	bool Play(uint32_t point);
+
+	/// <summary>
+	/// Passes the turn over without playing.
+	/// </summary>
+	void Pass();
+
+	/// <summary>
+	/// Takes back the last move or pass. Only what the move changed is put back, so this takes as long as the move did, however
+	/// long the game is.
+	/// </summary>
+	/// <returns>Whether there was a move to take back.</returns>
+	bool Undo();
+
+	/// <summary>
+	/// Plays the last move taken back again. Playing anything else after taking moves back forgets them.
+	/// </summary>
+	/// <returns>Whether there was a move to play again.</returns>
+	bool Redo();
+
+	/// <summary>
+	/// Returns whether there's a move that can be taken back.
+	/// </summary>
+	bool CanUndo() const;
+
+	/// <summary>
+	/// Returns whether there's a move that was taken back and can be played again.
+	/// </summary>
+	bool CanRedo() const;
+
+	/// <summary>
+	/// Returns whose turn it is.
+	/// </summary>
+	/// <returns>The player to move.</returns>
+	EPlayer GetToMove() const;
+
+	/// <summary>
+	/// Returns the point that can't be played on this turn because it would retake a ko.
+	/// </summary>
+	/// <returns>The ko point, or Board::noPoint if there isn't one.</returns>
+	uint32_t GetKoPoint() const;
+
+	/// <summary>
+	/// Returns how many stones a player has captured.
+	/// </summary>
+	/// <param name="player">The player who did the capturing.</param>
+	/// <returns>The number of stones captured.</returns>
+	uint32_t GetCaptures(EPlayer player) const;
+
+	/// <summary>
+	/// Returns how many passes have been made in a row. Two means the game is over.
+	/// </summary>
+	/// <returns>The number of passes in a row.</returns>
+	uint32_t GetPassCount() const;
+
+	/// <summary>
+	/// Returns how many moves have been made, including passes.
+	/// </summary>
+	/// <returns>The number of moves.</returns>
+	uint32_t GetMoveNumber() const;
+
+	/// <summary>
+	/// Returns the Zobrist hash of the whole situation: the stones, who is to move, and the ko. This is kept up to date as moves are
+	/// played, and can be used as a key for transposition tables and the like.
+	/// </summary>
+	/// <returns>The hash.</returns>
+	uint64_t GetHash() const;
+
+	/// <summary>
+	/// Returns which repeated positions are illegal.
+	/// </summary>
+	/// <returns>The superko rule.</returns>
+	ESuperko GetSuperko() const;
+
+	/// <summary>
+	/// Copies where the game is into a saved position.
+	/// </summary>
+	/// <param name="position">The position to save over.</param>
+	void SavePosition(Position& position) const;
+
+	/// <summary>
+	/// Goes to a saved position. Nothing before it can be taken back, and the history only has the position itself, so any earlier
+	/// positions superko should know about have to be added with AddToHistory().
+	/// </summary>
+	/// <param name="position">The position, which has to be on a board the same size as this game's.</param>
+	void LoadPosition(const Position& position);
+
+	/// <summary>
+	/// Adds an earlier position to the history, so superko won't allow it again.
+	/// </summary>
+	/// <param name="boardHash">The board's hash in that position.</param>
+	/// <param name="player">Who was to move.</param>
+	void AddToHistory(uint64_t boardHash, EPlayer player);
+
+	/// <summary>
+	/// How many moves the journal makes room for on the first move journaled, which is more than any real game has.
+	/// </summary>
+	static const size_t journalCapacity = 1024;
+
+	private:
+	/// <summary>
+	/// What a move or pass changed, so it can be taken back.
+	/// </summary>
+	struct JournalEntry {
+		/// <summary>
+		/// The point played on, or Board::noPoint for a pass.
+		/// </summary>
+		uint32_t point;
+
+		/// <summary>
+		/// What the move changed on the board. This isn't set for a pass.
+		/// </summary>
+		Board::Change change;
+
+		uint32_t capturedCount;
+		uint32_t previousKoPoint;
+		uint32_t previousPassCount;
+
+		/// <summary>
+		/// Whether the position was new to the history, and so has to come out of it again.
+		/// </summary>
+		bool addedToHistory;
+	};
+
+	/// <summary>
+	/// Copies the moves in another game's journal that can still be taken back or made again, and no more.
+	/// </summary>
+	void CopyJournal(const GameState& other);
+
+	/// <summary>
+	/// Returns the journal entry for the move about to be made, filled in with what's the same for moves and passes.
+	/// </summary>
+	JournalEntry& StartJournalEntry(uint32_t point);
+
+	/// <summary>
+	/// Returns whether playing on a point would repeat an earlier position under the superko rule.
+	/// </summary>
+	bool RepeatsPosition(uint32_t point) const;
+
+	/// <summary>
+	/// Returns the key a position is kept under in the history, which depends on the superko rule.
+	/// </summary>
+	uint64_t GetHistoryKey(uint64_t boardHash, EPlayer player) const;
+
+	std::shared_ptr<Board> board;
+	ESuperko superko;
+
+	/// <summary>
+	/// Every position there's been this game, for the superko rule.
+	/// </summary>
+	PositionSet history;
+
+	EPlayer toMove;
+	uint32_t koPoint;
+
+	/// <summary>
+	/// How many stones white, then black, have captured.
+	/// </summary>
+	std::array<uint32_t, 2> captures;
+
+	uint32_t passCount;
+	uint32_t moveNumber;
+
+	/// <summary>
+	/// Every move made this game, in order. Entries are reused when moves are taken back and others made, so once the game's been
+	/// this long nothing more is allocated. A copy only has room for the moves it copied, and grows from there.
+	/// </summary>
+	std::vector<JournalEntry> journal;
+
+	/// <summary>
+	/// How many moves in the journal have been made and not taken back.
+	/// </summary>
+	size_t journalPosition;
+
+	/// <summary>
+	/// How many moves in the journal can be played again, including those not taken back.
+	/// </summary>
+	size_t journalLength;
+};
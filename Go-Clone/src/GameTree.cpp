@@ -0,0 +1,247 @@
+#include "GameTree.h"
+
+#include <algorithm>
+
+/// <summary>
+/// About how many moves copying a snapshot is worth, when choosing between starting from one and stepping there with the journal.
+/// </summary>
+static const uint32_t snapshotCost = 4;
+
+GameTree::GameTree(uint32_t size, ESuperko superko) : state(size, superko) {
+	snapshots.reserve(snapshotCapacity);
+	NewGame(size);
+}
+
+GameTree::~GameTree() {
+}
+
+void GameTree::NewGame(uint32_t size) {
+	nodes.clear();
+	Node root;
+	root.parent = noNode;
+	root.firstChild = noNode;
+	root.lastChild = noNode;
+	root.nextSibling = noNode;
+	root.depth = 0;
+	root.commentOffset = 0;
+	root.commentLength = 0;
+	root.move = static_cast<uint16_t>(Board::noPoint);
+	commentText.clear();
+
+	state.NewGame(size);
+	root.hash = state.GetBoard().GetHash();
+	nodes.push_back(root);
+	current = 0;
+	journalBase = 0;
+	snapshots.clear();
+	snapshotOf.clear();
+	snapshotClock = 0;
+	SaveSnapshot();
+}
+
+const GameState& GameTree::GetState() const {
+	return state;
+}
+
+uint32_t GameTree::GetCurrent() const {
+	return current;
+}
+
+bool GameTree::Play(uint32_t point) {
+	if (!state.IsLegal(point)) {
+		return false;
+	}
+	Descend(GetOrAddChild(point));
+	return true;
+}
+
+void GameTree::Pass() {
+	Descend(GetOrAddChild(Board::noPoint));
+}
+
+bool GameTree::GoTo(uint32_t node) {
+	if (node >= nodes.size()) {
+		return false;
+	}
+	if (node == current) {
+		return true;
+	}
+
+	// The journal can step there, back up to where the two branches meet and down again, as long as it goes back that far.
+	uint32_t from = current;
+	uint32_t to = node;
+	while (nodes[from].depth > nodes[to].depth) {
+		from = nodes[from].parent;
+	}
+	while (nodes[to].depth > nodes[from].depth) {
+		to = nodes[to].parent;
+	}
+	while (from != to) {
+		from = nodes[from].parent;
+		to = nodes[to].parent;
+	}
+	uint32_t meeting = from;
+	bool journalReaches = nodes[meeting].depth >= nodes[journalBase].depth;
+	uint32_t journalCost = (nodes[current].depth - nodes[meeting].depth) + (nodes[node].depth - nodes[meeting].depth);
+
+	// A snapshot is better if one of the keyframes above the node has one and is close enough.
+	Snapshot* snapshot = nullptr;
+	for (uint32_t keyframe = node; keyframe != noNode; keyframe = nodes[keyframe].parent) {
+		uint32_t distance = nodes[node].depth - nodes[keyframe].depth;
+		if (journalReaches && distance + snapshotCost >= journalCost) {
+			break;
+		}
+		if (nodes[keyframe].depth % keyframeInterval == 0) {
+			snapshot = FindSnapshot(keyframe);
+			if (snapshot != nullptr) {
+				break;
+			}
+		}
+	}
+
+	uint32_t start;
+	if (snapshot != nullptr) {
+		LoadSnapshot(*snapshot);
+		start = snapshot->node;
+	} else if (journalReaches) {
+		for (uint32_t i = nodes[current].depth - nodes[meeting].depth; i > 0; --i) {
+			state.Undo();
+		}
+		start = meeting;
+	} else {
+		// Every snapshot above the node has been thrown out, so the moves are played again from the empty board.
+		state.NewGame(state.GetBoard().GetSize());
+		journalBase = 0;
+		start = 0;
+	}
+
+	path.clear();
+	for (uint32_t step = node; step != start; step = nodes[step].parent) {
+		path.push_back(step);
+	}
+	current = start;
+	for (auto step = path.rbegin(); step != path.rend(); ++step) {
+		Descend(*step);
+	}
+	return true;
+}
+
+uint32_t GameTree::GetNodeCount() const {
+	return static_cast<uint32_t>(nodes.size());
+}
+
+uint32_t GameTree::GetRoot() const {
+	return 0;
+}
+
+uint32_t GameTree::GetParent(uint32_t node) const {
+	return nodes[node].parent;
+}
+
+uint32_t GameTree::GetFirstChild(uint32_t node) const {
+	return nodes[node].firstChild;
+}
+
+uint32_t GameTree::GetNextSibling(uint32_t node) const {
+	return nodes[node].nextSibling;
+}
+
+uint32_t GameTree::GetMove(uint32_t node) const {
+	return nodes[node].move;
+}
+
+uint32_t GameTree::GetDepth(uint32_t node) const {
+	return nodes[node].depth;
+}
+
+void GameTree::SetComment(uint32_t node, const std::string& comment) {
+	nodes[node].commentOffset = static_cast<uint32_t>(commentText.size());
+	nodes[node].commentLength = static_cast<uint32_t>(comment.size());
+	commentText += comment;
+}
+
+std::string GameTree::GetComment(uint32_t node) const {
+	return commentText.substr(nodes[node].commentOffset, nodes[node].commentLength);
+}
+
+uint32_t GameTree::GetOrAddChild(uint32_t move) {
+	for (uint32_t child = nodes[current].firstChild; child != noNode; child = nodes[child].nextSibling) {
+		if (nodes[child].move == move) {
+			return child;
+		}
+	}
+
+	uint32_t child = static_cast<uint32_t>(nodes.size());
+	Node node;
+	node.parent = current;
+	node.firstChild = noNode;
+	node.lastChild = noNode;
+	node.nextSibling = noNode;
+	node.depth = nodes[current].depth + 1;
+	node.commentOffset = 0;
+	node.commentLength = 0;
+	node.hash = 0;
+	node.move = static_cast<uint16_t>(move);
+	nodes.push_back(node);
+
+	Node& parent = nodes[current];
+	if (parent.lastChild == noNode) {
+		parent.firstChild = child;
+	} else {
+		nodes[parent.lastChild].nextSibling = child;
+	}
+	parent.lastChild = child;
+	return child;
+}
+
+void GameTree::Descend(uint32_t child) {
+	if (nodes[child].move == Board::noPoint) {
+		state.Pass();
+	} else {
+		state.Play(nodes[child].move);
+	}
+	nodes[child].hash = state.GetBoard().GetHash();
+	current = child;
+	if (nodes[child].depth % keyframeInterval == 0 && FindSnapshot(child) == nullptr) {
+		SaveSnapshot();
+	}
+}
+
+GameTree::Snapshot* GameTree::FindSnapshot(uint32_t node) {
+	auto found = snapshotOf.find(node);
+	if (found == snapshotOf.end()) {
+		return nullptr;
+	}
+	Snapshot& snapshot = snapshots[found->second];
+	snapshot.lastUsed = ++snapshotClock;
+	return &snapshot;
+}
+
+void GameTree::LoadSnapshot(const Snapshot& snapshot) {
+	state.LoadPosition(snapshot.position);
+	// Black moves first, so whoever was to move at a node only depends on how deep it is.
+	for (uint32_t node = nodes[snapshot.node].parent; node != noNode; node = nodes[node].parent) {
+		state.AddToHistory(nodes[node].hash, nodes[node].depth % 2 == 0 ? EPlayer::EBlack : EPlayer::EWhite);
+	}
+	journalBase = snapshot.node;
+}
+
+void GameTree::SaveSnapshot() {
+	if (snapshots.size() < snapshotCapacity) {
+		snapshotOf[current] = snapshots.size();
+		snapshots.emplace_back();
+		Snapshot& snapshot = snapshots.back();
+		snapshot.node = current;
+		snapshot.lastUsed = ++snapshotClock;
+		state.SavePosition(snapshot.position);
+		return;
+	}
+	auto oldest = std::min_element(snapshots.begin(), snapshots.end(), [](const Snapshot& first, const Snapshot& second) {
+		return first.lastUsed < second.lastUsed;
+	});
+	snapshotOf.erase(oldest->node);
+	snapshotOf[current] = static_cast<size_t>(oldest - snapshots.begin());
+	oldest->node = current;
+	oldest->lastUsed = ++snapshotClock;
+	state.SavePosition(oldest->position);
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GameState.h"
+
+/// <summary>
+/// Every variation of a game, as a tree of moves, along with the position at the node being looked at. Nodes only keep their move,
+/// their place in the tree and where their comment is, all in flat arrays, so a game with hundreds of variations costs a few bytes a
+/// move rather than a board a move.
+/// Positions are made when they're needed. Moving a short way, such as to the next move or a sibling, steps the current position
+/// with its undo journal. Jumping further starts from a snapshot of the nearest keyframe above the node and plays the moves in
+/// between. Keyframes are every keyframeInterval moves deep, and the most recently used snapshots are kept, up to snapshotCapacity.
+/// </summary>
+class GameTree {
+	public:
+	/// <summary>
+	/// Stands for no node, such as the parent of the root.
+	/// </summary>
+	static const uint32_t noNode = UINT32_MAX;
+
+	/// <summary>
+	/// How many moves apart keyframes are, which is also about the most moves a jump has to play.
+	/// </summary>
+	static const uint32_t keyframeInterval = 16;
+
+	/// <summary>
+	/// How many keyframe snapshots are kept at once.
+	/// </summary>
+	static const size_t snapshotCapacity = 32;
+
+	/// <summary>
+	/// Starts a tree with just the empty board at its root.
+	/// </summary>
+	/// <param name="size">The width of the board. Only 9, 13 and 19 are supported.</param>
+	/// <param name="superko">Which repeated positions are illegal.</param>
+	GameTree(uint32_t size = Board::maxSize, ESuperko superko = ESuperko::EPositional);
+	~GameTree();
+
+	/// <summary>
+	/// Throws the tree away and starts again from an empty board.
+	/// </summary>
+	/// <param name="size">The width of the board.</param>
+	void NewGame(uint32_t size);
+
+	/// <summary>
+	/// Returns the position at the current node.
+	/// </summary>
+	/// <returns>The position.</returns>
+	const GameState& GetState() const;
+
+	/// <summary>
+	/// Returns the node being looked at.
+	/// </summary>
+	/// <returns>The current node.</returns>
+	uint32_t GetCurrent() const;
+
+	/// <summary>
+	/// Plays a move from the current node, and moves to it. If the move's already in the tree, it's gone to rather than added again.
+	/// </summary>
+	/// <param name="point">The point to play on.</param>
+	/// <returns>Whether the move was legal. Nothing changes if it wasn't.</returns>
+	bool Play(uint32_t point);
+
+	/// <summary>
+	/// Passes from the current node, and moves to the pass. If the pass is already in the tree, it's gone to rather than added again.
+	/// </summary>
+	void Pass();
+
+	/// <summary>
+	/// Makes a node the current one, and its position the current position.
+	/// </summary>
+	/// <param name="node">The node.</param>
+	/// <returns>Whether the node is in the tree.</returns>
+	bool GoTo(uint32_t node);
+
+	/// <summary>
+	/// Returns how many nodes there are, including the root.
+	/// </summary>
+	/// <returns>The number of nodes.</returns>
+	uint32_t GetNodeCount() const;
+
+	/// <summary>
+	/// Returns the root, which is the empty board.
+	/// </summary>
+	/// <returns>The root node.</returns>
+	uint32_t GetRoot() const;
+
+	/// <summary>
+	/// Returns the node a node was played from.
+	/// </summary>
+	/// <returns>The parent, or noNode for the root.</returns>
+	uint32_t GetParent(uint32_t node) const;
+
+	/// <summary>
+	/// Returns the first move played from a node, which is the main line.
+	/// </summary>
+	/// <returns>The first child, or noNode if there aren't any.</returns>
+	uint32_t GetFirstChild(uint32_t node) const;
+
+	/// <summary>
+	/// Returns the next variation played from the same node as a node.
+	/// </summary>
+	/// <returns>The next sibling, or noNode if there aren't any more.</returns>
+	uint32_t GetNextSibling(uint32_t node) const;
+
+	/// <summary>
+	/// Returns the move that led to a node.
+	/// </summary>
+	/// <returns>The point played on, or Board::noPoint for a pass or the root.</returns>
+	uint32_t GetMove(uint32_t node) const;
+
+	/// <summary>
+	/// Returns how many moves deep a node is.
+	/// </summary>
+	/// <returns>The depth, which is 0 for the root.</returns>
+	uint32_t GetDepth(uint32_t node) const;
+
+	/// <summary>
+	/// Sets the comment on a node. The old comment's text stays in the tree's text until the tree is thrown away.
+	/// </summary>
+	/// <param name="node">The node.</param>
+	/// <param name="comment">The comment, or an empty string for none.</param>
+	void SetComment(uint32_t node, const std::string& comment);
+
+	/// <summary>
+	/// Returns the comment on a node.
+	/// </summary>
+	/// <returns>The comment, which is empty if there isn't one.</returns>
+	std::string GetComment(uint32_t node) const;
+
+	private:
+	/// <summary>
+	/// A move in the tree. Children are a linked list through their siblings, in the order they were added.
+	/// </summary>
+	struct Node {
+		uint32_t parent;
+		uint32_t firstChild;
+		uint32_t lastChild;
+		uint32_t nextSibling;
+		uint32_t depth;
+
+		/// <summary>
+		/// Where the comment is in the tree's text, and how long it is.
+		/// </summary>
+		uint32_t commentOffset;
+		uint32_t commentLength;
+
+		/// <summary>
+		/// The board's hash after the move, for putting the superko history back after starting from a snapshot.
+		/// </summary>
+		uint64_t hash;
+
+		/// <summary>
+		/// The point played on, or Board::noPoint for a pass or the root.
+		/// </summary>
+		uint16_t move;
+	};
+
+	/// <summary>
+	/// A copy of the position at a keyframe. The superko history is put back from the nodes above it, and the journal starts again
+	/// from it, so neither is kept.
+	/// </summary>
+	struct Snapshot {
+		uint32_t node;
+
+		/// <summary>
+		/// When the snapshot was last used, for throwing out the least recently used.
+		/// </summary>
+		uint64_t lastUsed;
+
+		GameState::Position position;
+	};
+
+	/// <summary>
+	/// Returns the child of the current node with a move, adding it if it isn't there.
+	/// </summary>
+	uint32_t GetOrAddChild(uint32_t move);
+
+	/// <summary>
+	/// Moves the current position down to a child of the current node by making its move, and keeps a snapshot if it's a keyframe.
+	/// </summary>
+	void Descend(uint32_t child);
+
+	/// <summary>
+	/// Returns the snapshot of a node, or nullptr if there isn't one.
+	/// </summary>
+	Snapshot* FindSnapshot(uint32_t node);
+
+	/// <summary>
+	/// Makes the current position a snapshot's, with the positions above it back in the history.
+	/// </summary>
+	void LoadSnapshot(const Snapshot& snapshot);
+
+	/// <summary>
+	/// Keeps a copy of the current position, replacing the least recently used snapshot if there's no room.
+	/// </summary>
+	void SaveSnapshot();
+
+	std::vector<Node> nodes;
+
+	/// <summary>
+	/// The text of every comment, one after another.
+	/// </summary>
+	std::string commentText;
+
+	GameState state;
+	uint32_t current;
+
+	/// <summary>
+	/// The node the state's journal starts from, which is as far back as it can step.
+	/// </summary>
+	uint32_t journalBase;
+
+	std::vector<Snapshot> snapshots;
+
+	/// <summary>
+	/// Which snapshot each keyframe with one is in.
+	/// </summary>
+	std::unordered_map<uint32_t, size_t> snapshotOf;
+
+	/// <summary>
+	/// Counts up every time a snapshot is used.
+	/// </summary>
+	uint64_t snapshotClock;
+
+	/// <summary>
+	/// The nodes from a jump's starting point down to where it's going, kept to save allocating them every jump.
+	/// </summary>
+	std::vector<uint32_t> path;
+};
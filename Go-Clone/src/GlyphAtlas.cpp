@@ -0,0 +1,280 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include "Log.h"
+#include "MappedFile.h"
+#include "TrueTypeFont.h"
+
+/// <summary>
+/// How many pixels an em takes up in the atlas. Text drawn much bigger than this starts to round off at the corners.
+/// </summary>
+static const float pixelsPerEm = 40.0f;
+
+/// <summary>
+/// How many pixels the distance field reaches either side of an edge. This is also the blank border left around each glyph.
+/// </summary>
+static const int spread = 5;
+
+/// <summary>
+/// The width of the atlas. It's as tall as it needs to be.
+/// </summary>
+static const uint32_t atlasWidth = 512;
+
+/// <summary>
+/// Marks the start of a cache file, and changes whenever the layout does.
+/// </summary>
+static const uint32_t cacheMagic = 0x46445347;
+static const uint32_t cacheVersion = 1;
+
+GlyphAtlas::GlyphAtlas() {
+	width = 0;
+	height = 0;
+	ascender = 0.0f;
+	descender = 0.0f;
+	lineHeight = 0.0f;
+}
+
+GlyphAtlas::~GlyphAtlas() {
+}
+
+bool GlyphAtlas::Build(const std::vector<uint8_t>& fontData, const std::string& cachePath) {
+	uint64_t fontHash = HashFont(fontData);
+	if (cachePath.empty() || !LoadCache(cachePath, fontHash)) {
+		TrueTypeFont font;
+		if (!font.Load(fontData)) {
+			LOG_ERROR("Couldn't read the font, so there won't be any text.");
+			return false;
+		}
+		Generate(font);
+		if (!cachePath.empty()) {
+			SaveCache(cachePath, fontHash);
+		}
+	}
+	texture = std::make_shared<Texture>(width, height, Texture::ESingleChannel, pixels);
+	return true;
+}
+
+bool GlyphAtlas::IsReady() const {
+	return texture != nullptr;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(uint32_t codepoint) const {
+	if (codepoint < firstCharacter || codepoint > lastCharacter) {
+		codepoint = '?';
+	}
+	return glyphs[codepoint - firstCharacter];
+}
+
+std::shared_ptr<Texture> GlyphAtlas::GetTexture() const {
+	return texture;
+}
+
+float GlyphAtlas::GetAscender() const {
+	return ascender;
+}
+
+float GlyphAtlas::GetDescender() const {
+	return descender;
+}
+
+float GlyphAtlas::GetLineHeight() const {
+	return lineHeight;
+}
+
+void GlyphAtlas::Generate(const TrueTypeFont& font) {
+	float unitsPerEm = font.GetUnitsPerEm();
+	float scale = pixelsPerEm / unitsPerEm;
+	ascender = font.GetAscender() / unitsPerEm;
+	descender = font.GetDescender() / unitsPerEm;
+	lineHeight = (font.GetAscender() - font.GetDescender() + font.GetLineGap()) / unitsPerEm;
+
+	// Each glyph is rendered into its own little field first, since the atlas size isn't known until they're all packed.
+	struct Field {
+		int left;
+		int bottom;
+		int fieldWidth;
+		int fieldHeight;
+		std::vector<uint8_t> values;
+	};
+	const uint32_t characterCount = lastCharacter - firstCharacter + 1;
+	std::vector<Field> fields(characterCount);
+	glyphs.assign(characterCount, Glyph());
+
+	for (uint32_t character = firstCharacter; character <= lastCharacter; ++character) {
+		Field& field = fields[character - firstCharacter];
+		uint32_t glyphIndex = font.GetGlyphIndex(character);
+		glyphs[character - firstCharacter].advance = font.GetAdvance(glyphIndex) / unitsPerEm;
+
+		std::vector<TrueTypeFont::Contour> contours = font.GetGlyphShape(glyphIndex);
+		if (contours.empty()) {
+			field.fieldWidth = 0;
+			field.fieldHeight = 0;
+			continue;
+		}
+
+		// Everything is worked out in atlas pixels from here on.
+		glm::vec2 low(1e9f);
+		glm::vec2 high(-1e9f);
+		for (TrueTypeFont::Contour& contour : contours) {
+			for (glm::vec2& point : contour) {
+				point *= scale;
+				low = glm::min(low, point);
+				high = glm::max(high, point);
+			}
+		}
+		field.left = static_cast<int>(std::floor(low.x)) - spread;
+		field.bottom = static_cast<int>(std::floor(low.y)) - spread;
+		field.fieldWidth = static_cast<int>(std::ceil(high.x)) + spread - field.left;
+		field.fieldHeight = static_cast<int>(std::ceil(high.y)) + spread - field.bottom;
+		field.values.resize(field.fieldWidth * field.fieldHeight);
+
+		for (int y = 0; y < field.fieldHeight; ++y) {
+			for (int x = 0; x < field.fieldWidth; ++x) {
+				glm::vec2 sample(field.left + x + 0.5f, field.bottom + y + 0.5f);
+				float closest = 1e9f;
+				int winding = 0;
+				for (const TrueTypeFont::Contour& contour : contours) {
+					for (size_t i = 0; i < contour.size(); ++i) {
+						const glm::vec2& a = contour[i];
+						const glm::vec2& b = contour[(i + 1) % contour.size()];
+						glm::vec2 edge = b - a;
+						float lengthSquared = glm::dot(edge, edge);
+						float t = lengthSquared > 0.0f ? glm::clamp(glm::dot(sample - a, edge) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+						glm::vec2 offset = sample - (a + edge * t);
+						closest = std::min(closest, glm::dot(offset, offset));
+
+						// A ray to the right counts the edges it crosses, which decides whether the sample is inside (non-zero winding).
+						if ((a.y <= sample.y) != (b.y <= sample.y)) {
+							float crossing = a.x + (sample.y - a.y) / edge.y * edge.x;
+							if (crossing > sample.x) {
+								winding += edge.y > 0.0f ? 1 : -1;
+							}
+						}
+					}
+				}
+				float distance = std::sqrt(closest) * (winding != 0 ? 1.0f : -1.0f);
+				float value = glm::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+				field.values[y * field.fieldWidth + x] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+			}
+		}
+	}
+
+	// The fields are packed into rows from left to right, starting a new row when one fills up.
+	std::vector<glm::ivec2> positions(characterCount);
+	int cursorX = 0;
+	int cursorY = 0;
+	int rowHeight = 0;
+	for (uint32_t i = 0; i < characterCount; ++i) {
+		if (fields[i].fieldWidth == 0) {
+			continue;
+		}
+		if (cursorX + fields[i].fieldWidth > static_cast<int>(atlasWidth)) {
+			cursorX = 0;
+			cursorY += rowHeight;
+			rowHeight = 0;
+		}
+		positions[i] = glm::ivec2(cursorX, cursorY);
+		cursorX += fields[i].fieldWidth;
+		rowHeight = std::max(rowHeight, fields[i].fieldHeight);
+	}
+	width = atlasWidth;
+	height = std::max(cursorY + rowHeight, 1);
+	pixels.assign(width * height, 0);
+
+	for (uint32_t i = 0; i < characterCount; ++i) {
+		const Field& field = fields[i];
+		Glyph& glyph = glyphs[i];
+		if (field.fieldWidth == 0) {
+			glyph.planeMin = glm::vec2(0.0f);
+			glyph.planeMax = glm::vec2(0.0f);
+			glyph.uvMin = glm::vec2(0.0f);
+			glyph.uvMax = glm::vec2(0.0f);
+			continue;
+		}
+		for (int y = 0; y < field.fieldHeight; ++y) {
+			std::memcpy(&pixels[(positions[i].y + y) * width + positions[i].x], &field.values[y * field.fieldWidth], field.fieldWidth);
+		}
+		glyph.planeMin = glm::vec2(field.left, field.bottom) / pixelsPerEm;
+		glyph.planeMax = glm::vec2(field.left + field.fieldWidth, field.bottom + field.fieldHeight) / pixelsPerEm;
+		glyph.uvMin = glm::vec2(positions[i]) / glm::vec2(width, height);
+		glyph.uvMax = glm::vec2(positions[i] + glm::ivec2(field.fieldWidth, field.fieldHeight)) / glm::vec2(width, height);
+	}
+}
+
+bool GlyphAtlas::LoadCache(const std::string& path, uint64_t fontHash) {
+	MappedFile file(path);
+	if (!file.IsOpen()) {
+		return false;
+	}
+
+	// The cache is only ever read back on the machine that wrote it, so it's just the raw values.
+	const uint8_t* cursor = file.GetData();
+	const uint8_t* end = cursor + file.GetSize();
+	uint32_t header[2];
+	uint64_t cachedHash;
+	float metrics[3];
+	uint32_t size[3];
+	size_t headerSize = sizeof(header) + sizeof(cachedHash) + sizeof(metrics) + sizeof(size);
+	if (file.GetSize() < headerSize) {
+		return false;
+	}
+	std::memcpy(header, cursor, sizeof(header));
+	cursor += sizeof(header);
+	std::memcpy(&cachedHash, cursor, sizeof(cachedHash));
+	cursor += sizeof(cachedHash);
+	std::memcpy(metrics, cursor, sizeof(metrics));
+	cursor += sizeof(metrics);
+	std::memcpy(size, cursor, sizeof(size));
+	cursor += sizeof(size);
+
+	size_t glyphBytes = size[2] * sizeof(Glyph);
+	size_t pixelBytes = static_cast<size_t>(size[0]) * size[1];
+	if (header[0] != cacheMagic || header[1] != cacheVersion || cachedHash != fontHash || size[2] != lastCharacter - firstCharacter + 1 ||
+		static_cast<size_t>(end - cursor) != glyphBytes + pixelBytes) {
+		return false;
+	}
+
+	ascender = metrics[0];
+	descender = metrics[1];
+	lineHeight = metrics[2];
+	width = size[0];
+	height = size[1];
+	glyphs.resize(size[2]);
+	std::memcpy(glyphs.data(), cursor, glyphBytes);
+	cursor += glyphBytes;
+	pixels.assign(cursor, cursor + pixelBytes);
+	return true;
+}
+
+void GlyphAtlas::SaveCache(const std::string& path, uint64_t fontHash) const {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		LOG_WARNING("Couldn't save the glyph cache to {}.", path);
+		return;
+	}
+	uint32_t header[2] = {cacheMagic, cacheVersion};
+	float metrics[3] = {ascender, descender, lineHeight};
+	uint32_t size[3] = {width, height, static_cast<uint32_t>(glyphs.size())};
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(&fontHash), sizeof(fontHash));
+	file.write(reinterpret_cast<const char*>(metrics), sizeof(metrics));
+	file.write(reinterpret_cast<const char*>(size), sizeof(size));
+	file.write(reinterpret_cast<const char*>(glyphs.data()), glyphs.size() * sizeof(Glyph));
+	file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+}
+
+uint64_t GlyphAtlas::HashFont(const std::vector<uint8_t>& fontData) {
+	uint64_t hash = 14695981039346656037ull;
+	for (uint8_t byte : fontData) {
+		hash ^= byte;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Texture.h"
+
+class TrueTypeFont;
+
+/// <summary>
+/// A texture holding a signed distance field of every printable ASCII character in a font. Each pixel stores how far it is from the
+/// edge of the glyph (0.5 is on the edge, higher is inside), so the text stays sharp at any size and any angle from one small texture.
+/// Building the field is slow, so the result is saved to a cache file and reused as long as the font hasn't changed.
+/// </summary>
+class GlyphAtlas {
+	public:
+	/// <summary>
+	/// Where a glyph is in the atlas, and where it goes relative to the pen. Sizes are in ems, so they just need scaling by the font size.
+	/// </summary>
+	struct Glyph {
+		/// <summary>
+		/// How far to move the pen along after this glyph.
+		/// </summary>
+		float advance;
+
+		/// <summary>
+		/// The bottom left of the glyph's quad, relative to the pen on the baseline. The quad includes the blank space around the glyph
+		/// that the distance field fades out in.
+		/// </summary>
+		glm::vec2 planeMin;
+
+		/// <summary>
+		/// The top right of the glyph's quad, relative to the pen on the baseline.
+		/// </summary>
+		glm::vec2 planeMax;
+
+		/// <summary>
+		/// The bottom left of the glyph in the texture.
+		/// </summary>
+		glm::vec2 uvMin;
+
+		/// <summary>
+		/// The top right of the glyph in the texture.
+		/// </summary>
+		glm::vec2 uvMax;
+	};
+
+	/// <summary>
+	/// The first character in the atlas (a space).
+	/// </summary>
+	static const uint32_t firstCharacter = 32;
+
+	/// <summary>
+	/// The last character in the atlas (a tilde).
+	/// </summary>
+	static const uint32_t lastCharacter = 126;
+
+	GlyphAtlas();
+	~GlyphAtlas();
+
+	/// <summary>
+	/// Builds the atlas for a font, or loads it from the cache file if it was saved from the same font before.
+	/// </summary>
+	/// <param name="fontData">The contents of a .ttf file.</param>
+	/// <param name="cachePath">Where the atlas is cached. This can be empty to always build it.</param>
+	/// <returns>Whether the atlas is usable.</returns>
+	bool Build(const std::vector<uint8_t>& fontData, const std::string& cachePath);
+
+	/// <summary>
+	/// Returns whether the atlas has been built.
+	/// </summary>
+	/// <returns>Whether the atlas has been built.</returns>
+	bool IsReady() const;
+
+	/// <summary>
+	/// Returns the glyph for a character. Characters that aren't in the atlas are drawn as a question mark.
+	/// </summary>
+	/// <param name="codepoint">The character.</param>
+	/// <returns>The glyph.</returns>
+	const Glyph& GetGlyph(uint32_t codepoint) const;
+
+	/// <summary>
+	/// Returns the texture holding the distance field.
+	/// </summary>
+	/// <returns>The texture, or nullptr if the atlas hasn't been built.</returns>
+	std::shared_ptr<Texture> GetTexture() const;
+
+	/// <summary>
+	/// Returns how far above the baseline the tallest glyphs reach, in ems.
+	/// </summary>
+	float GetAscender() const;
+
+	/// <summary>
+	/// Returns how far below the baseline the lowest glyphs reach, in ems. This is negative.
+	/// </summary>
+	float GetDescender() const;
+
+	/// <summary>
+	/// Returns the distance between the baselines of two lines, in ems.
+	/// </summary>
+	float GetLineHeight() const;
+
+	private:
+	/// <summary>
+	/// Renders every glyph's distance field and packs them into the atlas.
+	/// </summary>
+	/// <param name="font">The font to render.</param>
+	void Generate(const TrueTypeFont& font);
+
+	/// <summary>
+	/// Loads the atlas from the cache, if the cache exists and was made from a font with the same hash.
+	/// </summary>
+	bool LoadCache(const std::string& path, uint64_t fontHash);
+
+	/// <summary>
+	/// Saves the atlas to the cache.
+	/// </summary>
+	void SaveCache(const std::string& path, uint64_t fontHash) const;
+
+	/// <summary>
+	/// Hashes the font's bytes (with 64 bit FNV-1a), so the cache can tell whether it's still for the same font.
+	/// </summary>
+	static uint64_t HashFont(const std::vector<uint8_t>& fontData);
+
+	/// <summary>
+	/// The glyph of each character from firstCharacter to lastCharacter.
+	/// </summary>
+	std::vector<Glyph> glyphs;
+
+	/// <summary>
+	/// The distance field, one byte per pixel, row by row from the bottom.
+	/// </summary>
+	std::vector<uint8_t> pixels;
+
+	uint32_t width;
+	uint32_t height;
+
+	float ascender;
+	float descender;
+	float lineHeight;
+
+	/// <summary>
+	/// The texture, made once the atlas is built.
+	/// </summary>
+	std::shared_ptr<Texture> texture;
+};
@@ -1,29 +1,59 @@
 #include "GoGame.h"
 
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 
+#include <glm/gtc/matrix_transform.hpp>
 #include <SFML/OpenGL.hpp>
 
+#include "BenchmarkScene.h"
+#include "FrameCapture.h"
 #include "GameObject.h"
+#include "GLExtensions.h"
+#include "Log.h"
+#include "Material.h"
 
 #include "BasicCube.h"
+#include "Mesh.h"
+#include "MeshLOD.h"
+#include "MeshRenderer.h"
 #include "Transform.h"
 
-GoGame::GoGame() {
-	//TODO: Arguments eventually.
-	sf::VideoMode videoMode;
-	videoMode.width = 800;
-	videoMode.height = 600;
+GoGame::GoGame(const GameArguments& arguments) : arguments(arguments) {
+	window = nullptr;
+	offscreen = nullptr;
+	frameNumber = 0;
+	toggleFullscreenAction = actions.AddAction("ToggleFullscreen");
+	actions.Bind(toggleFullscreenAction, { sf::Keyboard::Key::F });
 	systemVars.fullscreen = false;
-	sf::ContextSettings settings;
-	settings.depthBits = 8;
-	//window = new sf::Window(videoMode, systemVars.windowTitle, sf::Style::Default);
-	window = new sf::Window(videoMode, systemVars.windowTitle, sf::Style::Default, settings);
-	sf::ContextSettings newsettings = window->getSettings();
+	systemVars.windowWidth = arguments.width;
+	systemVars.windowHeight = arguments.height;
+	if (arguments.headless) {
+		offscreen = new OffscreenContext(arguments.width, arguments.height);
+		if (!offscreen->IsValid()) {
+			LOG_WARNING("The {} offscreen context couldn't be made, nothing will be drawn.", OffscreenContext::GetBackendName());
+		}
+		glViewport(0, 0, arguments.width, arguments.height);
+		if (!GLExtensions::Load(OffscreenContext::GetFunction)) {
+			LOG_WARNING("Buffer objects aren't supported, meshes will be drawn from client memory.");
+		}
+	} else {
+		// Everything made on the graphics card is shared through this, so it survives the window being remade.
+		resources.HoldSharedContext();
+		window = OpenWindow(sf::VideoMode(arguments.width, arguments.height), sf::Style::Default);
 
-	// This is to prevent typing style input.
-	window->setKeyRepeatEnabled(false);
+		if (!GLExtensions::Load()) {
+			LOG_WARNING("Buffer objects aren't supported, meshes will be drawn from client memory.");
+		}
+	}
+	resources.ContextChanged();
+	resources.AddMesh("Cube", Mesh::Cube());
+	resources.AddMesh("Stone", Mesh::Stone());
+	if (!arguments.fontPath.empty()) {
+		fontAsset = assets.Load(arguments.fontPath, Asset::EFont);
+	}
 
 	root = std::shared_ptr<GameObject>(nullptr);
 	// Since root is nullptr right now, then the construction of the root object should correctly have a nullptr parent.
@@ -34,64 +64,133 @@ GoGame::GoGame() {
 
 GoGame::~GoGame() {
 	std::shared_ptr<GameObject>(root)->Destroy();
+	renderer.Clear();
+	renderer.GetText().SetAtlas(nullptr);
+	glyphAtlas = nullptr;
+	resources.Clear();
 	delete window;
+	delete offscreen;
 }
 
 void GoGame::Start() {
-	std::cout << "We're in the start function!\n";
-
-	//! Remove this in production.
-	std::cout << "Putting in a couple of dummy objects and deleting them quickly.\n";
-	std::cout << "If the memory goes up, then there's a leak somewhere.\n";
+	LOG_DEBUG("We're in the start function!");
+
+	if (arguments.benchmark) {
+		std::shared_ptr<Mesh> mesh = arguments.benchmarkStones ? Mesh::Stone() : Mesh::Cube();
+		std::shared_ptr<Material> material = arguments.benchmarkStones ? Material::ForProgram(ShaderLibrary::EStone) : Material::Default();
+		BenchmarkScene scene(arguments.benchmarkObjects, arguments.benchmarkDepth, arguments.benchmarkFanOut, arguments.benchmarkAnimated, mesh, material);
+		if (arguments.benchmarkStones && !arguments.stoneMeshPath.empty()) {
+			// The built in stones are drawn straight away, and swapped for the loaded ones once they're uploaded.
+			scene.SetMeshAsset(assets.Load(arguments.stoneMeshPath, Asset::EMesh));
+		}
+		if (arguments.benchmarkStones && arguments.benchmarkLOD) {
+			scene.SetLOD(MeshLOD::Stone());
+		}
+		scene.SetLabelled(arguments.benchmarkLabels);
+		scene.Build();
+		LOG_INFO("Benchmarking {} {} (depth {}, fan-out {}, {} animated) for {} frames.", scene.GetObjectCount(), arguments.benchmarkStones ? "stones" : "cubes", arguments.benchmarkDepth, arguments.benchmarkFanOut, scene.GetAnimatedCount(), arguments.frameLimit);
+	} else {
+		//! Remove this in production.
+		LOG_INFO("Putting in a couple of dummy objects and deleting them quickly.");
+		LOG_INFO("If the memory goes up, then there's a leak somewhere.");
 
-	for (int i = 0; i < 10000; ++i) {
-		auto dummyOne = GameObject::Create<GameObject>();
-		dummyOne->SetName("Item 1");
-		auto dummyTwo = GameObject::Create<GameObject>(dummyOne);
-		dummyTwo->SetName("Item 2");
+		for (int i = 0; i < 10000; ++i) {
+			auto dummyOne = GameObject::Create<GameObject>();
+			dummyOne->SetName("Item 1");
+			auto dummyTwo = GameObject::Create<GameObject>(dummyOne);
+			dummyTwo->SetName("Item 2");
 
-		dummyOne->Destroy();
-	}
+			dummyOne->Destroy();
+		}
 
-	std::cout << "Seems okay.\n";
+		LOG_INFO("Seems okay.");
 
-	auto spinningCube = GameObject::Create<BasicCube>();
-	spinningCube->SetName("The Cube!");
-	auto transform = spinningCube->GetComponent<Transform>();
-	transform->Scale() = glm::vec3{0.5f, 0.5f, 0.5f};
-	transform->Rotate().z = 0.5f;
-	transform->Rotate().x = 0.5f;
+		auto spinningCube = GameObject::Create<BasicCube>();
+		spinningCube->SetName("The Cube!");
+		auto transform = spinningCube->GetComponent<Transform>();
+		transform->Scale() = glm::vec3{0.5f, 0.5f, 0.5f};
+		transform->Rotate().z = 0.5f;
+		transform->Rotate().x = 0.5f;
 
 	
-	auto spinningCubeTwo = GameObject::Create<BasicCube>();
-	spinningCubeTwo->SetName("The Cube's Cousin!");
-	transform = spinningCubeTwo->GetComponent<Transform>();
-	transform->Scale() = glm::vec3{0.3f, 0.3f, 0.3f};
-	transform->Translate() = glm::vec3{1.5f, 0.2f, -1.6f};
-	transform->Rotate().z = 0.5f;
-	transform->Rotate().x = 0.5f;
+		auto spinningCubeTwo = GameObject::Create<BasicCube>();
+		spinningCubeTwo->SetName("The Cube's Cousin!");
+		transform = spinningCubeTwo->GetComponent<Transform>();
+		transform->Scale() = glm::vec3{0.3f, 0.3f, 0.3f};
+		transform->Translate() = glm::vec3{1.5f, 0.2f, -1.6f};
+		transform->Rotate().z = 0.5f;
+		transform->Rotate().x = 0.5f;
 	
-	std::cout << "You should see two spinning cubes.\n";
+		LOG_INFO("You should see two spinning cubes.");
+	}
+
+	if (!arguments.replayPath.empty()) {
+		replay = std::make_shared<InputReplay>(arguments.replayPath);
+		if (!replay->IsOpen()) {
+			replay = nullptr;
+		}
+	}
+	if (!arguments.recordPath.empty()) {
+		recorder = std::make_shared<InputRecorder>(arguments.recordPath);
+		if (!recorder->IsOpen()) {
+			recorder = nullptr;
+		}
+	}
 
 	// This is a standard while loop described on the documentation page.
-	while (window->isOpen()) {
-		sf::Event event;
-		while (window->pollEvent(event)) {
-			if (!input.HandleInput(event)) {
-				if (event.type == sf::Event::Closed) {
-					window->close();
+	sf::Clock frameClock;
+	while (IsRunning()) {
+		frameClock.restart();
+		if (replay != nullptr) {
+			replay->FeedFrame(frameNumber, input, arguments.replayRecordedTiming);
+		}
+		if (window != nullptr) {
+			sf::Event event;
+			while (window->pollEvent(event)) {
+				// While replaying, only the recorded input counts, so the window's is thrown away.
+				bool handled = replay == nullptr ? input.HandleInput(event) : event.type != sf::Event::Closed;
+				if (!handled) {
+					if (event.type == sf::Event::Closed) {
+						window->close();
+					}
 				}
 			}
+			if (actions.IsActionDown(toggleFullscreenAction)) {
+				ToggleFullscreen();
+			}
 		}
-		if (input.IsKeyDown(sf::Keyboard::Key::F)) {
-			ToggleFullscreen();
-		}
+		sf::Clock updateClock;
+		Awake();
+		Update();
+		LateUpdate();
+		updateTime = updateClock.getElapsedTime();
+
+		assets.UploadPending(static_cast<size_t>(arguments.uploadBudget) * 1024);
+		MeshRenderer::ResolveMeshAssets();
+		PrepareText();
 		RenderScene();
-		window->display();
+		FinishFrame(frameClock);
 		input.UpdateState();
+		actions.Evaluate(input);
+		if (recorder != nullptr) {
+			recorder->RecordFrame(frameNumber, input.GetEvents());
+		}
+		++frameNumber;
+	}
+	if (replay != nullptr) {
+		LOG_INFO("Replayed the input of {} frames from {}.", replay->GetFrameCount(), arguments.replayPath);
+	}
+
+	if (arguments.benchmark) {
+		// The summary goes straight to the console, so anything logged before it has to be written out first.
+		Log::Flush();
+		frameLog.PrintSummary(std::cout);
+	}
+	if (!arguments.timingsPath.empty() && frameLog.WriteCSV(arguments.timingsPath)) {
+		LOG_INFO("Wrote the timings of {} frames to {}.", frameLog.GetSamples().size(), arguments.timingsPath);
 	}
 
-	std::cout << "The program is now exiting!\n";
+	LOG_INFO("The program is now exiting!");
 }
 
 const GameState& GoGame::GetGameState() const {
@@ -99,18 +198,32 @@ const GameState& GoGame::GetGameState() const {
 }
 
 bool GoGame::ToggleFullscreen() {
-	delete window;
-	systemVars.windowWidth = 800;
-	systemVars.windowHeight = 600;
+	if (window == nullptr) {
+		return false;
+	}
+	// Going back to a window goes back to the size asked for on the command line.
+	systemVars.windowWidth = arguments.width;
+	systemVars.windowHeight = arguments.height;
 	systemVars.screenWidth = sf::VideoMode::getDesktopMode().width;
 	systemVars.screenHeight = sf::VideoMode::getDesktopMode().height;
+	// The new window is made before the old one goes, so there's never a moment where nothing holds the shared objects.
+	sf::Window* oldWindow = window;
 	if (!systemVars.fullscreen) {
-		window = new sf::Window(sf::VideoMode(systemVars.screenWidth, systemVars.screenHeight), systemVars.windowTitle, sf::Style::Fullscreen);
+		window = OpenWindow(sf::VideoMode(systemVars.screenWidth, systemVars.screenHeight), sf::Style::Fullscreen);
 		systemVars.fullscreen = true;
 	} else {
-		window = new sf::Window(sf::VideoMode(systemVars.windowWidth, systemVars.windowHeight), systemVars.windowTitle, sf::Style::Default);
+		window = OpenWindow(sf::VideoMode(systemVars.windowWidth, systemVars.windowHeight), sf::Style::Default);
 		systemVars.fullscreen = false;
 	}
+	delete oldWindow;
+	window->setActive(true);
+
+	GLExtensions::Load();
+	size_t restored = resources.ContextChanged();
+	if (restored != 0) {
+		LOG_WARNING("The graphics context was lost, so {} resources were restored.", restored);
+	}
+	renderer.GetState().Invalidate();
 	return systemVars.fullscreen;
 }
 
@@ -140,44 +253,137 @@ const Input& GoGame::GetInput() const {
 	return input;
 }
 
+const ActionMap& GoGame::GetActions() const {
+	return actions;
+}
+
 void GoGame::AddToAwakeQueue(std::shared_ptr<Wakeable> wakeableComponent) {
 	awakeQueue.push(std::weak_ptr<Wakeable>(wakeableComponent));
 }
 
+Renderer& GoGame::GetRenderer() {
+	return renderer;
+}
+
+ResourceManager& GoGame::GetResources() {
+	return resources;
+}
+
+AssetLoader& GoGame::GetAssets() {
+	return assets;
+}
+
+sf::Window* GoGame::OpenWindow(const sf::VideoMode& videoMode, sf::Uint32 style) {
+	sf::ContextSettings settings;
+	settings.depthBits = 8;
+	sf::Window* newWindow = new sf::Window(videoMode, systemVars.windowTitle, style, settings);
+	// This is to prevent typing style input.
+	newWindow->setKeyRepeatEnabled(false);
+	newWindow->setActive(true);
+	return newWindow;
+}
+
 void GoGame::RenderScene() {
 	//TODO: This is just for demoing. Fix this later on.
-	glClearColor(0.1f, 0.1f, 0.7f, 1.0f);
-	glEnable(GL_DEPTH_TEST);
+	renderer.BeginFrame(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -3.0f)), glm::frustum(-1.0f, 1.0f, -1.0f, 1.0f, 1.5f, 500.0f));
 
-	//glFrustum(-0.1f, 0.1f, -0.1f, 0.1f, 1.0f, 500.0f);
+	// Most of this stays the same every frame, so the state cache drops it after the first frame.
+	GLStateCache& state = renderer.GetState();
+	state.ClearColor(glm::vec4(0.1f, 0.1f, 0.7f, 1.0f));
+	state.Enable(GL_DEPTH_TEST);
+	state.ColorMask(true, true, true, true);
+	state.DepthMask(true);
+	state.ClearDepth(500.0f);
 
-	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
-	glFrustum(-1.0f, 1.0f, -1.0f, 1.0f, 1.5f, 500.0f);
-	//glOrtho(-1.0f, 1.0f, -1.0f, 1.0f, -5.0f, 5.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	glColorMask(true, true, true, true);
-	glDepthMask(true);
-	glClearDepth(500.0f);
+	// A dim fill with one light shining straight away from the camera, like the old fixed function default.
+	renderer.SetAmbientLight(glm::vec3(0.2f));
+	renderer.AddLight(glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.8f));
 
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	if (renderer.GetText().IsReady()) {
+		sf::Vector2u size = window != nullptr ? window->getSize() : sf::Vector2u(arguments.width, arguments.height);
+		std::ostringstream frameTime;
+		frameTime << std::fixed << std::setprecision(1) << lastFrameTime.asMicroseconds() / 1000.0 << " ms";
+		renderer.GetText().SetScreenSize(glm::vec2(size.x, size.y));
+		renderer.GetText().AddScreenText(frameTime.str(), glm::vec2(8.0f, 8.0f), 16.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.8f));
+	}
+
+	renderer.CollectDrawCommands(std::shared_ptr<GameObject>(root));
+	renderer.EndFrame();
+}
 
-	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
+void GoGame::PrepareText() {
+	if (fontAsset == nullptr || fontAsset->GetState() < Asset::EReady) {
+		return;
+	}
+	// This only builds the atlas the first time the font is used. After that, it's read straight from the cache.
+	if (fontAsset->IsReady()) {
+		std::shared_ptr<GlyphAtlas> atlas = std::make_shared<GlyphAtlas>();
+		if (atlas->Build(fontAsset->GetFontData(), arguments.glyphCachePath)) {
+			glyphAtlas = atlas;
+			resources.AddTexture("Glyphs", glyphAtlas->GetTexture());
+			renderer.GetText().SetAtlas(glyphAtlas);
+		}
+	}
+	fontAsset = nullptr;
+}
 
-	glEnable(GL_LIGHTING);
+bool GoGame::IsRunning() const {
+	if (arguments.frameLimit != 0 && frameNumber >= arguments.frameLimit) {
+		return false;
+	}
+	if (replay != nullptr && arguments.frameLimit == 0 && frameNumber != 0 && replay->IsFinished()) {
+		return false;
+	}
+	if (window == nullptr) {
+		// There's nothing to close without a window, so it always stops at the limit, the end of the replay, or after a single frame.
+		return frameNumber == 0 || arguments.frameLimit != 0 || replay != nullptr;
+	}
+	return window->isOpen();
+}
 
-	glTranslatef(-5.0f, 5.0f, -3.0f);
-	glEnable(GL_LIGHT0);
-	
-	glTranslatef(5.0f, -5.0f, 3.0f);
+void GoGame::FinishFrame(const sf::Clock& frameClock) {
+	bool recording = !arguments.timingsPath.empty() || arguments.benchmark;
+	bool capturing = !arguments.capturePrefix.empty() && frameNumber % arguments.captureInterval == 0;
 
-	glTranslatef(0.0f, 0.0f, -3.0f);
+	// Waiting for the graphics card to finish makes the timings include the drawing itself, not just issuing it.
+	sf::Clock finishClock;
+	if (recording || window == nullptr) {
+		glFinish();
+	}
+	sf::Time finishTime = finishClock.getElapsedTime();
+	sf::Time frameTime = frameClock.getElapsedTime();
+	lastFrameTime = frameTime;
+
+	// This has to happen before the buffers are swapped, or the back buffer may have been thrown away.
+	if (capturing) {
+		std::string number = std::to_string(frameNumber);
+		std::string path = arguments.capturePrefix + std::string(number.size() < 5 ? 5 - number.size() : 0, '0') + number + ".png";
+		// The window's own size is what was drawn, whether it's fullscreen or not.
+		sf::Vector2u size = window != nullptr ? window->getSize() : sf::Vector2u(arguments.width, arguments.height);
+		FrameCapture::Capture(path, size.x, size.y);
+	}
 
-	std::shared_ptr<GameObject>(root)->RenderCall();
-	
-	glDisable(GL_LIGHT0);
-	glDisable(GL_LIGHTING);
+	if (recording) {
+		FrameSample sample;
+		sample.frame = frameNumber;
+		sample.frameTime = frameTime.asMicroseconds() / 1000.0;
+		sample.updateTime = updateTime.asMicroseconds() / 1000.0;
+		sample.traversalTime = renderer.GetTraversalTime().asMicroseconds() / 1000.0;
+		sample.drawTime = renderer.GetDrawTime().asMicroseconds() / 1000.0;
+		sample.finishTime = finishTime.asMicroseconds() / 1000.0;
+		sample.commands = renderer.GetQueue().GetSize();
+		sample.drawCalls = renderer.GetDrawCalls();
+		sample.triangles = renderer.GetTriangleCount();
+		sample.stateCallsIssued = renderer.GetState().GetIssuedCalls();
+		sample.stateCallsFiltered = renderer.GetState().GetFilteredCalls();
+		frameLog.Record(sample);
+	}
+
+	if (window != nullptr) {
+		window->display();
+	}
 }
 
 void GoGame::Awake() {
@@ -4,9 +4,19 @@
 #include <queue>
 #include <SFML/Window.hpp>
 
+#include "ActionMap.h"
+#include "AssetLoader.h"
 #include "ComponentTypes.h"
+#include "FrameLog.h"
+#include "GameArguments.h"
 #include "GameState.h"
+#include "GlyphAtlas.h"
 #include "Input.h"
+#include "InputRecorder.h"
+#include "InputReplay.h"
+#include "OffscreenContext.h"
+#include "Renderer.h"
+#include "ResourceManager.h"
 
 /// <summary>
 /// Stores information about the current system, this is mostly used for window management and hardware polling.
@@ -25,7 +35,7 @@ struct SystemVariables {
 /// </summary>
 class GoGame {
 	public:
-	GoGame();
+	GoGame(const GameArguments& arguments);
 	~GoGame();
 
 	/// <summary>
@@ -79,18 +89,70 @@ class GoGame {
 	/// <returns>A constant version of the Input object.</returns>
 	const Input& GetInput() const;
 
+	/// <summary>
+	/// Gets the actions, which are worked out from the input once per frame. Components should look up the IDs of the actions they
+	/// use when they wake up, and ask about those rather than about keys.
+	/// </summary>
+	/// <returns>The actions.</returns>
+	const ActionMap& GetActions() const;
+
 	/// <summary>
 	/// Adds the object to the awake queue for the next frame. This doesn't need to be called manually.
 	/// </summary>
 	/// <param name="wakableComponent">The component that will be woken up.</param>
 	void AddToAwakeQueue(std::shared_ptr<Wakeable> wakableComponent);
 
+	/// <summary>
+	/// Gets the renderer. Renderables use this to hand their draws over while the scene is being rendered.
+	/// </summary>
+	/// <returns>The renderer.</returns>
+	Renderer& GetRenderer();
+
+	/// <summary>
+	/// Gets the resource manager, which owns the meshes, textures and shaders shared across the game.
+	/// </summary>
+	/// <returns>The resource manager.</returns>
+	ResourceManager& GetResources();
+
+	/// <summary>
+	/// Gets the asset loader, which reads files in the background and uploads them a little at a time each frame.
+	/// </summary>
+	/// <returns>The asset loader.</returns>
+	AssetLoader& GetAssets();
+
 	private:
 	/// <summary>
 	/// Renders the current game scene. This should only be called in the game loop.
 	/// </summary>
 	void RenderScene();
 
+	/// <summary>
+	/// Makes a window with the context settings the game needs. Every window should be made through this.
+	/// </summary>
+	/// <param name="videoMode">The size of the window.</param>
+	/// <param name="style">The SFML window style.</param>
+	/// <returns>The new window.</returns>
+	sf::Window* OpenWindow(const sf::VideoMode& videoMode, sf::Uint32 style);
+
+	/// <summary>
+	/// Builds the glyph atlas once the font has loaded, and hands it to the text renderer.
+	/// </summary>
+	void PrepareText();
+
+	/// <summary>
+	/// Returns whether the game loop should keep going. It stops when the window is closed, the frame limit is reached, or a replay
+	/// runs out; without a window, it stops after one frame if none of those were asked for.
+	/// </summary>
+	/// <returns>Whether to run another frame.</returns>
+	bool IsRunning() const;
+
+	/// <summary>
+	/// Ends a frame once the scene's been drawn. This waits for the drawing when it's being timed, captures the frame if asked to,
+	/// records its timings, and shows it.
+	/// </summary>
+	/// <param name="frameClock">The clock started at the beginning of the frame.</param>
+	void FinishFrame(const sf::Clock& frameClock);
+
 	/// <summary>
 	/// Initialises all objects that are in the awake queue.
 	/// </summary>
@@ -135,6 +197,36 @@ class GoGame {
 	/// </summary>
 	sf::Window* window;
 
+	/// <summary>
+	/// The context that's drawn to instead of a window when running headless. nullptr when there's a window.
+	/// </summary>
+	OffscreenContext* offscreen;
+
+	/// <summary>
+	/// The options the game was started with.
+	/// </summary>
+	GameArguments arguments;
+
+	/// <summary>
+	/// How many frames have been finished, which is also the number of the frame being run.
+	/// </summary>
+	uint32_t frameNumber;
+
+	/// <summary>
+	/// How long Awake, Update and LateUpdate took in the last frame, which is recorded in its FrameSample.
+	/// </summary>
+	sf::Time updateTime;
+
+	/// <summary>
+	/// How long the last frame took, which is shown in the corner once there's a font.
+	/// </summary>
+	sf::Time lastFrameTime;
+
+	/// <summary>
+	/// The timings of every frame, kept when they're being written out or benchmarked.
+	/// </summary>
+	FrameLog frameLog;
+
 	/// <summary>
 	/// The system variables, particularly for window management and hardware polling. Game specific variables should not be here.
 	/// </summary>
@@ -144,4 +236,49 @@ class GoGame {
 	/// Handles all the user-level input of the engine. Inputs are either handled here, or spit back out (which means they're engine related).
 	/// </summary>
 	Input input;
+
+	/// <summary>
+	/// The bindings from input to actions.
+	/// </summary>
+	ActionMap actions;
+
+	/// <summary>
+	/// The action that switches to and from fullscreen.
+	/// </summary>
+	uint32_t toggleFullscreenAction;
+
+	/// <summary>
+	/// Writes the input of every frame out, if the game was asked to record it.
+	/// </summary>
+	std::shared_ptr<InputRecorder> recorder;
+
+	/// <summary>
+	/// Feeds recorded input in place of the window's, if the game was asked to replay some.
+	/// </summary>
+	std::shared_ptr<InputReplay> replay;
+
+	/// <summary>
+	/// Collects and draws everything in the scene each frame.
+	/// </summary>
+	Renderer renderer;
+
+	/// <summary>
+	/// Owns the shared graphics resources and keeps them alive when the window is remade.
+	/// </summary>
+	ResourceManager resources;
+
+	/// <summary>
+	/// Loads assets in the background.
+	/// </summary>
+	AssetLoader assets;
+
+	/// <summary>
+	/// The font being loaded. This is dropped once the atlas has been built from it.
+	/// </summary>
+	std::shared_ptr<Asset> fontAsset;
+
+	/// <summary>
+	/// The glyphs every piece of text is drawn with.
+	/// </summary>
+	std::shared_ptr<GlyphAtlas> glyphAtlas;
 };
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "IDPool.h"
+
+IDPool::IDPool() {
+	nextID = 1;
+}
+
+IDPool::~IDPool() {
+}
+
+uint32_t IDPool::Acquire() {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (freeIDs.empty()) {
+		return nextID++;
+	}
+	uint32_t id = freeIDs.back();
+	freeIDs.pop_back();
+	return id;
+}
+
+void IDPool::Release(uint32_t id) {
+	std::lock_guard<std::mutex> lock(mutex);
+	freeIDs.push_back(id);
+}
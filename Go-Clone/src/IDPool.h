@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/// <summary>
+/// Hands out IDs starting from 1, giving back out the ones that have been released before making new ones. IDs only get as big as
+/// the most things that have been alive at once, rather than growing every time something's made, so they stay small enough to be
+/// put in sort keys however many assets are streamed in and out. This is safe to use from any thread.
+/// </summary>
+class IDPool {
+	public:
+	IDPool();
+	~IDPool();
+
+	/// <summary>
+	/// Returns an ID that isn't in use.
+	/// </summary>
+	/// <returns>The ID, which is never 0.</returns>
+	uint32_t Acquire();
+
+	/// <summary>
+	/// Gives an ID back so that it can be handed out again.
+	/// </summary>
+	/// <param name="id">An ID from Acquire() that's no longer in use.</param>
+	void Release(uint32_t id);
+
+	private:
+	std::mutex mutex;
+
+	/// <summary>
+	/// The ID handed out once there are no released ones left.
+	/// </summary>
+	uint32_t nextID;
+
+	/// <summary>
+	/// IDs that have been released. The most recently released is handed out first.
+	/// </summary>
+	std::vector<uint32_t> freeIDs;
+};
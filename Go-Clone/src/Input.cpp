@@ -1,82 +1,242 @@
 #include "Input.h"
 
-#include <iostream>
-#include <array>
-
-/// <summary>
-/// An instant of all the current input. Everything should exist within this.
-/// </summary>
-struct InputState {
-	static const uint8_t totalKeys = sf::Keyboard::Key::KeyCount * 2;
-	std::array<bool, totalKeys> keyboardState;
-	//TODO: Add more stuff here for more inputs.
-};
+#include <algorithm>
 
 Input::Input() {
-	// This assumes that they will initialise completely as false.
-	previousState = new InputState;
-	currentState = new InputState;
-	nextState = new InputState;
+	// Everything starts released, with the mouse in the corner.
+	InputState empty = InputState();
+	history.fill(empty);
+	nextIndex = 0;
 }
 
 Input::~Input() {
-	//HACK: This extra check can probably be removed; an older style of using the states needed this.
-	if (currentState != nextState) {
-		delete nextState;
-	}
-	if (previousState != currentState) {
-		delete currentState;
-	}
-	delete previousState;
 }
 
 void Input::UpdateState() {
-	// All the pointers swap. This should allow the data to be quickly transferred.
-	delete previousState;
-	previousState = currentState;
-	currentState = nextState;
-	nextState = new InputState;
-	// Copy all the info from the current state into the next state so it can be modified independently.
-	*nextState = *currentState;
+	ApplyEvents();
+	events.Seal();
+
+	// The next state starts as a copy of the one just finished, so held keys stay held. The oldest state is written over.
+	const InputState& finished = history[nextIndex];
+	nextIndex = (nextIndex + 1) % historyLength;
+	InputState& next = history[nextIndex];
+	next.keys = finished.keys;
+	next.mouseButtons = finished.mouseButtons;
+	next.mousePosition = finished.mousePosition;
+	next.keysPressed.reset();
+	next.keysReleased.reset();
+	next.mouseButtonsPressed.reset();
+	next.mouseButtonsReleased.reset();
+	next.mouseMotion = sf::Vector2i(0, 0);
+	next.wheelDelta = 0.0f;
+	next.firstEvent = events.GetEnd();
+	next.endEvent = events.GetEnd();
 }
 
 bool Input::HandleInput(sf::Event event) {
+	InputEvent input;
+	input.count = 1;
+	input.code = 0;
+	input.x = 0;
+	input.y = 0;
+	input.wheelDelta = 0.0f;
+	// SFML doesn't say when events happened, so they're stamped when they're taken from the window.
+	input.time = clock.getElapsedTime().asMicroseconds();
 	switch (event.type) {
 		case sf::Event::EventType::KeyPressed:
-			std::cout << "Pressed: " << event.key.code << "\n";
-			if (event.key.code >= 0) {
-				nextState->keyboardState[event.key.code] = true;
-			}
-			break;
 		case sf::Event::EventType::KeyReleased:
-			std::cout << "Released: " << event.key.code << "\n";
-			if (event.key.code >= 0) {
-				nextState->keyboardState[event.key.code] = false;
-			}
+			input.type = event.type == sf::Event::EventType::KeyPressed ? InputEvent::EKeyPressed : InputEvent::EKeyReleased;
+			input.code = event.key.code;
 			break;
-		case sf::Event::EventType::JoystickButtonPressed:
-		case sf::Event::EventType::JoystickButtonReleased:
 		case sf::Event::EventType::MouseButtonPressed:
 		case sf::Event::EventType::MouseButtonReleased:
+			input.type = event.type == sf::Event::EventType::MouseButtonPressed ? InputEvent::EMouseButtonPressed : InputEvent::EMouseButtonReleased;
+			input.code = event.mouseButton.button;
+			input.x = event.mouseButton.x;
+			input.y = event.mouseButton.y;
+			break;
 		case sf::Event::EventType::MouseMoved:
-			//TODO: Handle everything else at some point.
+			input.type = InputEvent::EMouseMoved;
+			input.x = event.mouseMove.x;
+			input.y = event.mouseMove.y;
+			break;
+		case sf::Event::EventType::MouseWheelScrolled:
+			// Only the vertical wheel is kept, since that's what every mouse has.
+			if (event.mouseWheelScroll.wheel != sf::Mouse::Wheel::VerticalWheel) {
+				return true;
+			}
+			input.type = InputEvent::EMouseWheel;
+			input.x = event.mouseWheelScroll.x;
+			input.y = event.mouseWheelScroll.y;
+			input.wheelDelta = event.mouseWheelScroll.delta;
+			break;
+		case sf::Event::EventType::JoystickButtonPressed:
+		case sf::Event::EventType::JoystickButtonReleased:
+			input.type = event.type == sf::Event::EventType::JoystickButtonPressed ? InputEvent::EJoystickButtonPressed : InputEvent::EJoystickButtonReleased;
+			input.code = event.joystickButton.button;
+			input.x = event.joystickButton.joystickId;
 			break;
+		case sf::Event::EventType::MouseWheelMoved:
+			// This is the deprecated twin of MouseWheelScrolled, which SFML sends as well.
+			return true;
 		// If the input is none of these, then don't act on it, and return false.
 		// The engine should pick up on this and then act on it.
 		default:
 			return false;
 	}
+	HandleEvent(input);
 	return true;
 }
 
-bool Input::IsKeyDown(sf::Keyboard::Key key) const {
-	return currentState->keyboardState[key] && !previousState->keyboardState[key];
+void Input::HandleEvent(const InputEvent& event) {
+	events.Push(event);
+}
+
+bool Input::IsKeyDown(sf::Keyboard::Key key, uint32_t framesAgo) const {
+	return key >= 0 && key < sf::Keyboard::Key::KeyCount && GetKeysDown(framesAgo)[key];
+}
+
+bool Input::IsKeyUp(sf::Keyboard::Key key, uint32_t framesAgo) const {
+	return key >= 0 && key < sf::Keyboard::Key::KeyCount && GetKeysUp(framesAgo)[key];
+}
+
+bool Input::IsKey(sf::Keyboard::Key key, uint32_t framesAgo) const {
+	return key >= 0 && key < sf::Keyboard::Key::KeyCount && GetState(framesAgo).keys[key];
+}
+
+uint32_t Input::CountKeyPresses(sf::Keyboard::Key key, uint32_t frames) const {
+	uint32_t presses = 0;
+	for (uint32_t framesAgo = 0; framesAgo < frames; ++framesAgo) {
+		if (IsKeyDown(key, framesAgo)) {
+			++presses;
+		}
+	}
+	return presses;
+}
+
+const Input::KeySet& Input::GetKeys(uint32_t framesAgo) const {
+	return GetState(framesAgo).keys;
+}
+
+Input::KeySet Input::GetKeysDown(uint32_t framesAgo) const {
+	// A key went down if it changed and is now held, which is a couple of operations per word rather than per key.
+	// Keys that were tapped within the update don't change the held state, so they're added on from the events.
+	const InputState& state = GetState(framesAgo);
+	return ((state.keys ^ GetState(framesAgo + 1).keys) & state.keys) | state.keysPressed;
+}
+
+Input::KeySet Input::GetKeysUp(uint32_t framesAgo) const {
+	const KeySet& before = GetState(framesAgo + 1).keys;
+	const InputState& state = GetState(framesAgo);
+	return ((state.keys ^ before) & before) | state.keysReleased;
+}
+
+bool Input::IsMouseButtonDown(sf::Mouse::Button button, uint32_t framesAgo) const {
+	return button >= 0 && button < sf::Mouse::Button::ButtonCount && GetState(framesAgo).mouseButtonsPressed[button];
+}
+
+bool Input::IsMouseButtonUp(sf::Mouse::Button button, uint32_t framesAgo) const {
+	return button >= 0 && button < sf::Mouse::Button::ButtonCount && GetState(framesAgo).mouseButtonsReleased[button];
+}
+
+bool Input::IsMouseButton(sf::Mouse::Button button, uint32_t framesAgo) const {
+	return button >= 0 && button < sf::Mouse::Button::ButtonCount && GetState(framesAgo).mouseButtons[button];
+}
+
+uint32_t Input::CountMouseButtonPresses(sf::Mouse::Button button, uint32_t frames) const {
+	uint32_t presses = 0;
+	for (uint32_t framesAgo = 0; framesAgo < frames; ++framesAgo) {
+		if (IsMouseButtonDown(button, framesAgo)) {
+			++presses;
+		}
+	}
+	return presses;
+}
+
+const Input::ButtonSet& Input::GetMouseButtons(uint32_t framesAgo) const {
+	return GetState(framesAgo).mouseButtons;
+}
+
+const Input::ButtonSet& Input::GetMouseButtonsDown(uint32_t framesAgo) const {
+	return GetState(framesAgo).mouseButtonsPressed;
 }
 
-bool Input::IsKeyUp(sf::Keyboard::Key key) const {
-	return !currentState->keyboardState[key] && previousState->keyboardState[key];
+const Input::ButtonSet& Input::GetMouseButtonsUp(uint32_t framesAgo) const {
+	return GetState(framesAgo).mouseButtonsReleased;
 }
 
-bool Input::IsKey(sf::Keyboard::Key key) const {
-	return currentState->keyboardState[key];
-}
\ No newline at end of file
+sf::Vector2i Input::GetMousePosition(uint32_t framesAgo) const {
+	return GetState(framesAgo).mousePosition;
+}
+
+sf::Vector2i Input::GetMouseMotion(uint32_t framesAgo) const {
+	return GetState(framesAgo).mouseMotion;
+}
+
+float Input::GetWheelDelta(uint32_t framesAgo) const {
+	return GetState(framesAgo).wheelDelta;
+}
+
+InputEventQueue::Range Input::GetEvents(uint32_t framesAgo) const {
+	const InputState& state = GetState(framesAgo);
+	return events.GetRange(state.firstEvent, state.endEvent);
+}
+
+const InputEventQueue& Input::GetEventQueue() const {
+	return events;
+}
+
+void Input::ApplyEvents() {
+	InputState& state = history[nextIndex];
+	InputEventQueue::Range range = events.GetRange(state.firstEvent, events.GetEnd());
+	state.endEvent = events.GetEnd();
+	for (size_t i = 0; i < range.GetSize(); ++i) {
+		const InputEvent& event = range[i];
+		bool validKey = event.code >= 0 && event.code < sf::Keyboard::Key::KeyCount;
+		bool validButton = event.code >= 0 && event.code < sf::Mouse::Button::ButtonCount;
+		switch (event.type) {
+			case InputEvent::EKeyPressed:
+				if (validKey) {
+					state.keys.set(event.code);
+					state.keysPressed.set(event.code);
+				}
+				break;
+			case InputEvent::EKeyReleased:
+				if (validKey) {
+					state.keys.reset(event.code);
+					state.keysReleased.set(event.code);
+				}
+				break;
+			case InputEvent::EMouseButtonPressed:
+				if (validButton) {
+					state.mouseButtons.set(event.code);
+					state.mouseButtonsPressed.set(event.code);
+				}
+				break;
+			case InputEvent::EMouseButtonReleased:
+				if (validButton) {
+					state.mouseButtons.reset(event.code);
+					state.mouseButtonsReleased.set(event.code);
+				}
+				break;
+			case InputEvent::EMouseMoved:
+				// Moves were already merged as they came in, so however many arrived, this is usually once per frame.
+				state.mouseMotion += sf::Vector2i(event.x, event.y) - state.mousePosition;
+				state.mousePosition = sf::Vector2i(event.x, event.y);
+				break;
+			case InputEvent::EMouseWheel:
+				state.wheelDelta += event.wheelDelta;
+				break;
+			case InputEvent::EJoystickButtonPressed:
+			case InputEvent::EJoystickButtonReleased:
+				//TODO: Handle joysticks at some point.
+				break;
+		}
+	}
+}
+
+const Input::InputState& Input::GetState(uint32_t framesAgo) const {
+	// The state being filled is never read, so the last update is the one just before it.
+	uint32_t back = std::min(framesAgo + 1, historyLength - 1);
+	return history[(nextIndex + historyLength - back) % historyLength];
+}
@@ -1,13 +1,37 @@
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <SFML/System/Clock.hpp>
 #include <SFML/Window.hpp>
 
+#include "InputEventQueue.h"
+
 //! This may not be enough for all purposes (eg. typing, or precise mouse movement).
 /// <summary>
 /// Handles per-frame inputs and states. SFML events should be passed in, and the state is managed internally.
+/// The last few frames are kept in a fixed ring, so queries can look back for combos and double clicks, and nothing is allocated per frame.
+/// Every event is also kept in order with when it arrived, for anything that needs more than the state at the end of each frame.
+/// The events are only turned into state once per frame, in one pass, with mouse moves merged as they arrive.
 /// </summary>
 class Input {
 	public:
+	/// <summary>
+	/// Which keys are held, one bit per key.
+	/// </summary>
+	typedef std::bitset<sf::Keyboard::KeyCount> KeySet;
+
+	/// <summary>
+	/// Which mouse buttons are held, one bit per button.
+	/// </summary>
+	typedef std::bitset<sf::Mouse::ButtonCount> ButtonSet;
+
+	/// <summary>
+	/// How many frames are kept. Queries can look back this many frames, less two (the frame being filled, and the one before the oldest).
+	/// </summary>
+	static const uint32_t historyLength = 32;
+
 	/// <summary>
 	/// Sets up the internal structures for handling input.
 	/// </summary>
@@ -15,51 +39,217 @@ class Input {
 	~Input();
 
 	/// <summary>
-	/// Marks the current state as finished and creates a new one.
+	/// Applies this frame's events, marks the current state as finished and starts a new one.
 	/// This should be called at the end of a frame draw so that new events are counted under
 	/// a new frame.
 	/// </summary>
 	void UpdateState();
 
 	/// <summary>
-	/// Handles an SFML event for the current state.
+	/// Queues an SFML event for the current state. It takes effect at the next UpdateState().
 	/// </summary>
 	/// <param name="event">The SFML event to be handled.</param>
 	/// <returns>True if the event was of an input change. If false, the engine should handle this.</returns>
 	bool HandleInput(sf::Event event);
 
 	/// <summary>
-	/// Gets whether the given key was pressed down in the last update.
+	/// Queues an event that's already been read, such as one being replayed. Its time is kept as it is.
+	/// It takes effect at the next UpdateState().
+	/// </summary>
+	/// <param name="event">The event.</param>
+	void HandleEvent(const InputEvent& event);
+
+	/// <summary>
+	/// Gets whether the given key was pressed down in the last update. A key that was tapped and let go within one update still counts.
 	/// </summary>
 	/// <param name="key">The key that was pressed.</param>
-	/// <returns>Whether it was pressed down in the last update.</returns>
-	bool IsKeyDown(sf::Keyboard::Key key) const;
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>Whether it was pressed down in that update.</returns>
+	bool IsKeyDown(sf::Keyboard::Key key, uint32_t framesAgo = 0) const;
 
 	/// <summary>
 	/// Gets whether the given key was released in the last update.
 	/// </summary>
 	/// <param name="key">The key that was released.</param>
-	/// <returns>Whether it was released in the last update.</returns>
-	bool IsKeyUp(sf::Keyboard::Key key) const;
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>Whether it was released in that update.</returns>
+	bool IsKeyUp(sf::Keyboard::Key key, uint32_t framesAgo = 0) const;
 
 	/// <summary>
 	/// Gets whether the given key is current down as of the last update.
 	/// </summary>
 	/// <param name="key">The key that is down.</param>
-	/// <returns>Whether it is currently down in the last update.</returns>
-	bool IsKey(sf::Keyboard::Key key) const;
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>Whether it was down in that update.</returns>
+	bool IsKey(sf::Keyboard::Key key, uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Counts how many times a key was pressed over the last few updates, for things like double taps.
+	/// </summary>
+	/// <param name="key">The key.</param>
+	/// <param name="frames">How many updates to look over.</param>
+	/// <returns>The number of presses.</returns>
+	uint32_t CountKeyPresses(sf::Keyboard::Key key, uint32_t frames) const;
+
+	/// <summary>
+	/// Gets every key that was held in an update.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The keys that were held.</returns>
+	const KeySet& GetKeys(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets every key that was pressed down in an update, including ones let go again before it ended.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The keys that were pressed.</returns>
+	KeySet GetKeysDown(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets every key that was released in an update, including ones pressed again before it ended.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The keys that were released.</returns>
+	KeySet GetKeysUp(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets whether the given mouse button was pressed down in the last update.
+	/// </summary>
+	/// <param name="button">The button that was pressed.</param>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>Whether it was pressed down in that update.</returns>
+	bool IsMouseButtonDown(sf::Mouse::Button button, uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets whether the given mouse button was released in the last update.
+	/// </summary>
+	/// <param name="button">The button that was released.</param>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>Whether it was released in that update.</returns>
+	bool IsMouseButtonUp(sf::Mouse::Button button, uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets whether the given mouse button is down as of the last update.
+	/// </summary>
+	/// <param name="button">The button that is down.</param>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>Whether it was down in that update.</returns>
+	bool IsMouseButton(sf::Mouse::Button button, uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Counts how many times a mouse button was pressed over the last few updates. Two within a few frames is a double click.
+	/// </summary>
+	/// <param name="button">The button.</param>
+	/// <param name="frames">How many updates to look over.</param>
+	/// <returns>The number of presses.</returns>
+	uint32_t CountMouseButtonPresses(sf::Mouse::Button button, uint32_t frames) const;
+
+	/// <summary>
+	/// Gets every mouse button that was held in an update.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The buttons that were held.</returns>
+	const ButtonSet& GetMouseButtons(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets every mouse button that was pressed down in an update, including ones let go again before it ended.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The buttons that were pressed.</returns>
+	const ButtonSet& GetMouseButtonsDown(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets every mouse button that was released in an update, including ones pressed again before it ended.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The buttons that were released.</returns>
+	const ButtonSet& GetMouseButtonsUp(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets where the mouse was in the window.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The position of the mouse in pixels from the top left of the window.</returns>
+	sf::Vector2i GetMousePosition(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets how far the mouse moved during an update.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>How far the mouse moved in pixels.</returns>
+	sf::Vector2i GetMouseMotion(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets how far the mouse wheel turned during an update.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>How many notches the wheel turned. Positive is away from the user.</returns>
+	float GetWheelDelta(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets the raw events that made up an update, in the order they arrived. Events that have been written over since are left out.
+	/// </summary>
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The events of that update.</returns>
+	InputEventQueue::Range GetEvents(uint32_t framesAgo = 0) const;
+
+	/// <summary>
+	/// Gets every raw event that's still kept. Readers can keep the sequence number they got up to and ask for the range after it.
+	/// </summary>
+	/// <returns>The event queue.</returns>
+	const InputEventQueue& GetEventQueue() const;
 
 	private:
 	/// <summary>
-	/// The previous input state. Used internally to see what input has changed.
+	/// An instant of all the current input. Everything should exist within this.
+	/// </summary>
+	struct InputState {
+		KeySet keys;
+		KeySet keysPressed;
+		KeySet keysReleased;
+		ButtonSet mouseButtons;
+		ButtonSet mouseButtonsPressed;
+		ButtonSet mouseButtonsReleased;
+		sf::Vector2i mousePosition;
+		sf::Vector2i mouseMotion;
+		float wheelDelta;
+
+		/// <summary>
+		/// The sequence numbers of the events that made up this state.
+		/// </summary>
+		uint64_t firstEvent;
+		uint64_t endEvent;
+	};
+
+	/// <summary>
+	/// Applies every event that arrived this frame to the state being filled.
 	/// </summary>
-	struct InputState* previousState;
+	void ApplyEvents();
+
 	/// <summary>
-	/// The current input state. Used internally to see what the current input is.
+	/// Returns the state from the given number of updates ago. Anything older than the history gives the oldest state kept.
 	/// </summary>
-	struct InputState* currentState;
+	/// <param name="framesAgo">How many updates to look back. 0 is the last update.</param>
+	/// <returns>The state.</returns>
+	const InputState& GetState(uint32_t framesAgo) const;
+
+	/// <summary>
+	/// The last few states. The one at nextIndex is still being filled by events, and the rest go back in time from the one before it.
+	/// </summary>
+	std::array<InputState, historyLength> history;
+
+	/// <summary>
+	/// Where the state being filled is in the history.
+	/// </summary>
+	uint32_t nextIndex;
+
+	/// <summary>
+	/// Every raw event, in the order they arrived.
+	/// </summary>
+	InputEventQueue events;
+
 	/// <summary>
-	/// The next input state. Used internally to plan for what the next state will have.
+	/// Timestamps the events.
 	/// </summary>
-	struct InputState* nextState;
-};
\ No newline at end of file
+	sf::Clock clock;
+};
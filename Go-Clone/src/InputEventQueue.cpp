@@ -0,0 +1,57 @@
+#include "InputEventQueue.h"
+
+#include <algorithm>
+
+size_t InputEventQueue::Range::GetSize() const {
+	return static_cast<size_t>(end - begin);
+}
+
+const InputEvent& InputEventQueue::Range::operator[](size_t index) const {
+	return queue->events[(begin + index) & (capacity - 1)];
+}
+
+InputEventQueue::InputEventQueue() {
+	end = 0;
+	sealed = 0;
+	dropped = 0;
+}
+
+InputEventQueue::~InputEventQueue() {
+}
+
+void InputEventQueue::Push(const InputEvent& event) {
+	if (event.type == InputEvent::EMouseMoved && end > sealed) {
+		InputEvent& last = events[(end - 1) & (capacity - 1)];
+		if (last.type == InputEvent::EMouseMoved) {
+			last.x = event.x;
+			last.y = event.y;
+			last.time = event.time;
+			last.count += event.count;
+			return;
+		}
+	}
+	if (end >= capacity) {
+		++dropped;
+	}
+	events[end & (capacity - 1)] = event;
+	++end;
+}
+
+void InputEventQueue::Seal() {
+	sealed = end;
+}
+
+uint64_t InputEventQueue::GetEnd() const {
+	return end;
+}
+
+InputEventQueue::Range InputEventQueue::GetRange(uint64_t begin, uint64_t rangeEnd) const {
+	rangeEnd = std::min(rangeEnd, end);
+	uint64_t oldest = end > capacity ? end - capacity : 0;
+	begin = std::min(std::max(begin, oldest), rangeEnd);
+	return Range{this, begin, rangeEnd};
+}
+
+uint64_t InputEventQueue::GetDroppedCount() const {
+	return dropped;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// A single raw input event, stamped with when it arrived.
+/// </summary>
+struct InputEvent {
+	/// <summary>
+	/// What happened.
+	/// </summary>
+	enum EType : uint8_t {
+		EKeyPressed,
+		EKeyReleased,
+		EMouseButtonPressed,
+		EMouseButtonReleased,
+		/// <summary>
+		/// The mouse moved. Moves in a row are merged into one, keeping the last position.
+		/// </summary>
+		EMouseMoved,
+		EMouseWheel,
+		EJoystickButtonPressed,
+		EJoystickButtonReleased
+	};
+
+	EType type;
+
+	/// <summary>
+	/// How many moves were merged into this one. This is 1 for everything else.
+	/// </summary>
+	uint32_t count;
+
+	/// <summary>
+	/// The key, mouse button or joystick button.
+	/// </summary>
+	int32_t code;
+
+	/// <summary>
+	/// The position of the mouse in pixels from the top left of the window. For joystick buttons, x is the joystick.
+	/// </summary>
+	int32_t x;
+	int32_t y;
+
+	/// <summary>
+	/// How far the wheel turned, in notches. Positive is away from the user.
+	/// </summary>
+	float wheelDelta;
+
+	/// <summary>
+	/// When the event was taken from the window, in microseconds since the input started.
+	/// </summary>
+	int64_t time;
+};
+
+/// <summary>
+/// A fixed size ring of raw input events. Nothing is allocated after it's made; if events arrive faster than they're read, the oldest
+/// are written over. Every event gets a sequence number that keeps going up, so readers can hold on to where they got up to.
+/// </summary>
+class InputEventQueue {
+	public:
+	/// <summary>
+	/// How many events are kept. This is a power of two so sequence numbers wrap into the ring cheaply.
+	/// </summary>
+	static const uint32_t capacity = 1024;
+
+	/// <summary>
+	/// A run of events, by sequence number.
+	/// </summary>
+	struct Range {
+		const InputEventQueue* queue;
+		uint64_t begin;
+		uint64_t end;
+
+		/// <summary>
+		/// Returns the number of events in the range.
+		/// </summary>
+		size_t GetSize() const;
+
+		/// <summary>
+		/// Returns an event, where 0 is the first in the range.
+		/// </summary>
+		const InputEvent& operator[](size_t index) const;
+	};
+
+	InputEventQueue();
+	~InputEventQueue();
+
+	/// <summary>
+	/// Adds an event. A move straight after another move is merged into it, unless Seal() was called in between.
+	/// </summary>
+	/// <param name="event">The event.</param>
+	void Push(const InputEvent& event);
+
+	/// <summary>
+	/// Stops the events so far from being merged with anything that comes after. This is called at the end of each frame, so every
+	/// event stays in the frame it arrived in.
+	/// </summary>
+	void Seal();
+
+	/// <summary>
+	/// Returns the sequence number the next event will get.
+	/// </summary>
+	/// <returns>The sequence number of the next event.</returns>
+	uint64_t GetEnd() const;
+
+	/// <summary>
+	/// Returns the events from a sequence number up to (not including) another. Anything that's been written over is left out.
+	/// </summary>
+	/// <param name="begin">The sequence number of the first event.</param>
+	/// <param name="end">One past the sequence number of the last event.</param>
+	/// <returns>The events that are still kept.</returns>
+	Range GetRange(uint64_t begin, uint64_t end) const;
+
+	/// <summary>
+	/// Returns how many events have been pushed out of the ring to make room for new ones.
+	/// </summary>
+	/// <returns>The number of events written over.</returns>
+	uint64_t GetDroppedCount() const;
+
+	private:
+	std::array<InputEvent, capacity> events;
+
+	/// <summary>
+	/// The sequence number of the next event.
+	/// </summary>
+	uint64_t end;
+
+	/// <summary>
+	/// Events before this can't be merged into.
+	/// </summary>
+	uint64_t sealed;
+
+	uint64_t dropped;
+};
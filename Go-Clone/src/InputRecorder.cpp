@@ -0,0 +1,70 @@
+#include "InputRecorder.h"
+
+#include <cstring>
+
+#include "Log.h"
+
+/// <summary>
+/// Writes a value a byte at a time from the lowest, so the file is the same whatever order the machine keeps bytes in.
+/// </summary>
+template <typename T>
+static void WriteLittleEndian(std::ofstream& file, T value, size_t size) {
+	uint64_t bits = static_cast<uint64_t>(value);
+	char bytes[8];
+	for (size_t i = 0; i < size; ++i) {
+		bytes[i] = static_cast<char>((bits >> (i * 8)) & 0xFF);
+	}
+	file.write(bytes, size);
+}
+
+InputRecorder::InputRecorder(const std::string& path) : file(path, std::ios::binary | std::ios::trunc), path(path) {
+	frameCount = 0;
+	if (!file) {
+		LOG_ERROR("Couldn't open {} to record the input to.", path);
+		return;
+	}
+	WriteLittleEndian(file, magic, 4);
+	WriteLittleEndian(file, version, 4);
+}
+
+InputRecorder::~InputRecorder() {
+	if (file.is_open()) {
+		file.close();
+		LOG_INFO("Recorded the input of {} frames to {}.", frameCount, path);
+	}
+}
+
+bool InputRecorder::IsOpen() const {
+	return file.is_open() && file.good();
+}
+
+void InputRecorder::RecordFrame(uint32_t frame, const InputEventQueue::Range& events) {
+	if (!IsOpen()) {
+		return;
+	}
+	WriteLittleEndian(file, frame, 4);
+	WriteLittleEndian(file, clock.getElapsedTime().asMicroseconds(), 8);
+	WriteLittleEndian(file, static_cast<uint32_t>(events.GetSize()), 4);
+	for (size_t i = 0; i < events.GetSize(); ++i) {
+		const InputEvent& event = events[i];
+		uint32_t wheelBits;
+		std::memcpy(&wheelBits, &event.wheelDelta, sizeof(wheelBits));
+		WriteLittleEndian(file, static_cast<uint8_t>(event.type), 1);
+		WriteLittleEndian(file, event.count, 4);
+		WriteLittleEndian(file, static_cast<uint32_t>(event.code), 4);
+		WriteLittleEndian(file, static_cast<uint32_t>(event.x), 4);
+		WriteLittleEndian(file, static_cast<uint32_t>(event.y), 4);
+		WriteLittleEndian(file, wheelBits, 4);
+		WriteLittleEndian(file, event.time, 8);
+	}
+	if (!file) {
+		LOG_ERROR("Couldn't write to {}, so the rest of the input won't be recorded.", path);
+		file.close();
+		return;
+	}
+	++frameCount;
+}
+
+uint32_t InputRecorder::GetFrameCount() const {
+	return frameCount;
+}
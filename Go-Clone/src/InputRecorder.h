@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <SFML/System/Clock.hpp>
+
+#include "InputEventQueue.h"
+
+/// <summary>
+/// Writes the input of every frame to a file, so the same run can be played back later with InputReplay.
+/// The file starts with the magic number and version, then has one record per frame: the frame number, the microseconds from the
+/// start of the recording to the end of the frame, and the number of events, followed by the events themselves.
+/// Everything is little endian and packed, so a recording can be played back on any machine.
+/// </summary>
+class InputRecorder {
+	public:
+	/// <summary>
+	/// Identifies an input recording ("GOIR").
+	/// </summary>
+	static const uint32_t magic = 0x52494F47;
+
+	/// <summary>
+	/// This goes up whenever the layout changes, so old recordings are turned away rather than misread.
+	/// </summary>
+	static const uint32_t version = 1;
+
+	/// <summary>
+	/// The size of a frame record before its events, in bytes.
+	/// </summary>
+	static const size_t frameSize = 16;
+
+	/// <summary>
+	/// The size of a single event, in bytes.
+	/// </summary>
+	static const size_t eventSize = 29;
+
+	/// <summary>
+	/// Opens the file and writes the header. Check IsOpen() to see whether it worked.
+	/// </summary>
+	/// <param name="path">Where to write the recording. Anything already there is replaced.</param>
+	InputRecorder(const std::string& path);
+	~InputRecorder();
+
+	/// <summary>
+	/// Returns whether the file could be written to.
+	/// </summary>
+	/// <returns>Whether the recording is being written.</returns>
+	bool IsOpen() const;
+
+	/// <summary>
+	/// Writes the events of a frame. This should be called once per frame after Input::UpdateState(), even when nothing happened,
+	/// so that the timing of every frame is kept.
+	/// </summary>
+	/// <param name="frame">The number of the frame.</param>
+	/// <param name="events">The events that made up the frame.</param>
+	void RecordFrame(uint32_t frame, const InputEventQueue::Range& events);
+
+	/// <summary>
+	/// Returns how many frames have been written.
+	/// </summary>
+	/// <returns>The number of frames written.</returns>
+	uint32_t GetFrameCount() const;
+
+	private:
+	std::ofstream file;
+	std::string path;
+
+	/// <summary>
+	/// Times the frames from when the recording started.
+	/// </summary>
+	sf::Clock clock;
+
+	uint32_t frameCount;
+};
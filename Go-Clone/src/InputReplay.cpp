@@ -0,0 +1,109 @@
+#include "InputReplay.h"
+
+#include <cstring>
+#include <thread>
+#include <SFML/System/Sleep.hpp>
+
+#include "Input.h"
+#include "InputRecorder.h"
+#include "Log.h"
+
+/// <summary>
+/// Reads a value a byte at a time from the lowest, which is how InputRecorder writes them.
+/// </summary>
+static uint64_t ReadLittleEndian(const uint8_t* data, size_t size) {
+	uint64_t value = 0;
+	for (size_t i = 0; i < size; ++i) {
+		value |= static_cast<uint64_t>(data[i]) << (i * 8);
+	}
+	return value;
+}
+
+InputReplay::InputReplay(const std::string& path) : file(path) {
+	offset = 8;
+	lastFrameEnd = 0;
+	frameCount = 0;
+	valid = false;
+	if (!file.IsOpen() || file.GetSize() < offset) {
+		LOG_ERROR("Couldn't read the input recording {}.", path);
+		return;
+	}
+	if (ReadLittleEndian(file.GetData(), 4) != InputRecorder::magic || ReadLittleEndian(file.GetData() + 4, 4) != InputRecorder::version) {
+		LOG_ERROR("{} isn't an input recording this version of the game can play.", path);
+		return;
+	}
+	valid = true;
+}
+
+InputReplay::~InputReplay() {
+}
+
+bool InputReplay::IsOpen() const {
+	return valid;
+}
+
+void InputReplay::FeedFrame(uint32_t frame, Input& input, bool recordedTiming) {
+	if (frameCount == 0) {
+		clock.restart();
+	}
+	if (IsFinished()) {
+		return;
+	}
+	const uint8_t* data = file.GetData();
+	size_t size = file.GetSize();
+
+	// Frames from before this one are skipped, and a frame that's still to come is left for later.
+	while (offset + InputRecorder::frameSize <= size) {
+		uint32_t recordedFrame = static_cast<uint32_t>(ReadLittleEndian(data + offset, 4));
+		int64_t frameEnd = static_cast<int64_t>(ReadLittleEndian(data + offset + 4, 8));
+		uint32_t eventCount = static_cast<uint32_t>(ReadLittleEndian(data + offset + 12, 4));
+		size_t recordSize = InputRecorder::frameSize + static_cast<size_t>(eventCount) * InputRecorder::eventSize;
+		if (recordSize > size - offset) {
+			LOG_WARNING("The input recording stops part way through frame {}.", recordedFrame);
+			offset = size;
+			return;
+		}
+		if (recordedFrame > frame) {
+			return;
+		}
+
+		if (recordedFrame == frame) {
+			if (recordedTiming) {
+				// The frame's events are fed once as much time has passed as had by the end of the frame before it.
+				// Sleeping can overshoot by a few milliseconds, so the last one is waited out, yielding rather than spinning so the
+				// thread doesn't hold a core to itself.
+				int64_t wait = lastFrameEnd - clock.getElapsedTime().asMicroseconds();
+				if (wait > 2000) {
+					sf::sleep(sf::microseconds(wait - 1000));
+				}
+				while (clock.getElapsedTime().asMicroseconds() < lastFrameEnd) {
+					std::this_thread::yield();
+				}
+			}
+			const uint8_t* eventData = data + offset + InputRecorder::frameSize;
+			for (uint32_t i = 0; i < eventCount; ++i, eventData += InputRecorder::eventSize) {
+				InputEvent event;
+				uint32_t wheelBits = static_cast<uint32_t>(ReadLittleEndian(eventData + 17, 4));
+				event.type = static_cast<InputEvent::EType>(eventData[0]);
+				event.count = static_cast<uint32_t>(ReadLittleEndian(eventData + 1, 4));
+				event.code = static_cast<int32_t>(ReadLittleEndian(eventData + 5, 4));
+				event.x = static_cast<int32_t>(ReadLittleEndian(eventData + 9, 4));
+				event.y = static_cast<int32_t>(ReadLittleEndian(eventData + 13, 4));
+				std::memcpy(&event.wheelDelta, &wheelBits, sizeof(wheelBits));
+				event.time = static_cast<int64_t>(ReadLittleEndian(eventData + 21, 8));
+				input.HandleEvent(event);
+			}
+			lastFrameEnd = frameEnd;
+			++frameCount;
+		}
+		offset += recordSize;
+	}
+}
+
+bool InputReplay::IsFinished() const {
+	return !valid || offset + InputRecorder::frameSize > file.GetSize();
+}
+
+uint32_t InputReplay::GetFrameCount() const {
+	return frameCount;
+}
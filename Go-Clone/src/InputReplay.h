@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <SFML/System/Clock.hpp>
+
+#include "MappedFile.h"
+
+class Input;
+
+/// <summary>
+/// Plays back input recorded by InputRecorder, feeding each frame's events to the input as though they had come from the window.
+/// As long as the game only changes through its input, a replay runs exactly like the recording did.
+/// </summary>
+class InputReplay {
+	public:
+	/// <summary>
+	/// Maps the recording and checks its header. Check IsOpen() to see whether it worked.
+	/// </summary>
+	/// <param name="path">The recording.</param>
+	InputReplay(const std::string& path);
+	~InputReplay();
+
+	/// <summary>
+	/// Returns whether the recording could be read.
+	/// </summary>
+	/// <returns>Whether the recording can be played.</returns>
+	bool IsOpen() const;
+
+	/// <summary>
+	/// Feeds the input the events recorded for a frame. This should be called at the start of the frame, where the window would be
+	/// polled.
+	/// </summary>
+	/// <param name="frame">The number of the frame.</param>
+	/// <param name="input">The input to feed.</param>
+	/// <param name="recordedTiming">Whether to wait until as long has passed as had in the recording. Otherwise, the frame is fed straight away.</param>
+	void FeedFrame(uint32_t frame, Input& input, bool recordedTiming);
+
+	/// <summary>
+	/// Returns whether every recorded frame has been fed.
+	/// </summary>
+	/// <returns>Whether the replay is over.</returns>
+	bool IsFinished() const;
+
+	/// <summary>
+	/// Returns how many frames have been fed.
+	/// </summary>
+	/// <returns>The number of frames fed.</returns>
+	uint32_t GetFrameCount() const;
+
+	private:
+	MappedFile file;
+
+	/// <summary>
+	/// Where the next frame record starts.
+	/// </summary>
+	size_t offset;
+
+	/// <summary>
+	/// When the last frame fed ended in the recording, in microseconds.
+	/// </summary>
+	int64_t lastFrameEnd;
+
+	/// <summary>
+	/// Times the replay from the first frame fed.
+	/// </summary>
+	sf::Clock clock;
+
+	uint32_t frameCount;
+	bool valid;
+};
@@ -0,0 +1,169 @@
+#include "InstanceBatch.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include "GLExtensions.h"
+
+/// <summary>
+/// What a hidden slot holds. A zero matrix collapses every vertex onto one point, so nothing is rasterised.
+/// </summary>
+static const InstanceData hiddenInstance = {glm::mat4(0.0f), glm::vec4(0.0f)};
+
+InstanceHandle::InstanceHandle() {
+	slot = 0;
+}
+
+void InstanceHandle::Release() {
+	if (batch != nullptr) {
+		batch->ReleaseSlot(slot);
+		batch = nullptr;
+	}
+}
+
+InstanceBatch::InstanceBatch(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material) : mesh(mesh), material(material) {
+	frame = 1;
+	anyDirty = false;
+	uploadedCount = 0;
+	instanceBuffer = 0;
+	bufferCapacity = 0;
+}
+
+InstanceBatch::~InstanceBatch() {
+	if (instanceBuffer != 0) {
+		GLExtensions::DeleteBuffers(1, &instanceBuffer);
+	}
+}
+
+void InstanceBatch::Restore() {
+	// Draw() sees that the buffer has no room and reuploads every slot.
+	instanceBuffer = 0;
+	bufferCapacity = 0;
+}
+
+uint32_t InstanceBatch::AcquireSlot() {
+	uint32_t slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	} else {
+		slot = static_cast<uint32_t>(instances.size());
+		instances.push_back(hiddenInstance);
+		submittedFrame.push_back(0);
+		// New slots always need uploading, since the buffer has never seen them.
+		dirty.push_back(true);
+		anyDirty = true;
+	}
+	return slot;
+}
+
+void InstanceBatch::ReleaseSlot(uint32_t slot) {
+	Write(slot, hiddenInstance);
+	submittedFrame[slot] = 0;
+	freeSlots.push_back(slot);
+}
+
+void InstanceBatch::Submit(uint32_t slot, const glm::mat4& model, const glm::vec4& color) {
+	Write(slot, InstanceData{model, color});
+	submittedFrame[slot] = frame;
+}
+
+bool InstanceBatch::Draw(GLStateCache& state) {
+	// Anything that wasn't submitted this frame (such as a disabled renderer) is hidden.
+	for (uint32_t slot = 0; slot < instances.size(); ++slot) {
+		if (submittedFrame[slot] != frame) {
+			Write(slot, hiddenInstance);
+		}
+	}
+	++frame;
+
+	uploadedCount = 0;
+	if (instances.empty() || !material->GetShader()->Bind(state)) {
+		return false;
+	}
+
+	if (instanceBuffer == 0) {
+		GLExtensions::GenBuffers(1, &instanceBuffer);
+	}
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+	if (instances.size() > bufferCapacity) {
+		// The buffer is grown to match the vector so that it doesn't need to grow every time a slot is added.
+		bufferCapacity = instances.capacity();
+		GLExtensions::BufferData(GL_ARRAY_BUFFER, bufferCapacity * sizeof(InstanceData), nullptr, GL_DYNAMIC_DRAW);
+		dirty.assign(instances.size(), true);
+		anyDirty = true;
+	}
+	UploadChanges();
+
+	mesh->Bind();
+	// The instance attributes are set after binding the mesh, since they're part of the vertex array's state.
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+	for (GLuint column = 0; column < 4; ++column) {
+		GLuint attribute = Shader::EInstanceModel + column;
+		GLExtensions::EnableVertexAttribArray(attribute);
+		GLExtensions::VertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), reinterpret_cast<const void*>(offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+		GLExtensions::VertexAttribDivisor(attribute, 1);
+	}
+	GLExtensions::EnableVertexAttribArray(Shader::EInstanceColor);
+	GLExtensions::VertexAttribPointer(Shader::EInstanceColor, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), reinterpret_cast<const void*>(offsetof(InstanceData, color)));
+	GLExtensions::VertexAttribDivisor(Shader::EInstanceColor, 1);
+
+	mesh->DrawElements(instances.size());
+
+	for (GLuint attribute = Shader::EInstanceModel; attribute <= Shader::EInstanceColor; ++attribute) {
+		GLExtensions::VertexAttribDivisor(attribute, 0);
+		GLExtensions::DisableVertexAttribArray(attribute);
+	}
+	mesh->Unbind();
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, 0);
+	return true;
+}
+
+bool InstanceBatch::Matches(const Mesh* otherMesh, const Material* otherMaterial) const {
+	return mesh.get() == otherMesh && material.get() == otherMaterial;
+}
+
+size_t InstanceBatch::GetSlotCount() const {
+	return instances.size() - freeSlots.size();
+}
+
+size_t InstanceBatch::GetUploadedCount() const {
+	return uploadedCount;
+}
+
+void InstanceBatch::UploadChanges() {
+	if (!anyDirty) {
+		return;
+	}
+	// Runs closer together than this are uploaded as one, since a call costs more than a few spare instances.
+	const size_t mergeGap = 8;
+	size_t slot = 0;
+	while (slot < instances.size()) {
+		if (!dirty[slot]) {
+			++slot;
+			continue;
+		}
+		size_t runBegin = slot;
+		size_t runEnd = slot + 1;
+		for (size_t next = runEnd; next < instances.size() && next - runEnd <= mergeGap; ++next) {
+			if (dirty[next]) {
+				runEnd = next + 1;
+			}
+		}
+		for (size_t i = runBegin; i < runEnd; ++i) {
+			dirty[i] = false;
+		}
+		GLExtensions::BufferSubData(GL_ARRAY_BUFFER, runBegin * sizeof(InstanceData), (runEnd - runBegin) * sizeof(InstanceData), &instances[runBegin]);
+		uploadedCount += runEnd - runBegin;
+		slot = runEnd;
+	}
+	anyDirty = false;
+}
+
+void InstanceBatch::Write(uint32_t slot, const InstanceData& data) {
+	if (std::memcmp(&instances[slot], &data, sizeof(InstanceData)) != 0) {
+		instances[slot] = data;
+		dirty[slot] = true;
+		anyDirty = true;
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "GLStateCache.h"
+#include "GPUResource.h"
+#include "Material.h"
+#include "Mesh.h"
+
+/// <summary>
+/// The data streamed to the graphics card for each instance. This is laid out exactly how it is uploaded.
+/// </summary>
+struct InstanceData {
+	glm::mat4 model;
+	glm::vec4 color;
+};
+
+/// <summary>
+/// A renderer's place in an instance batch. This is owned by the renderer and filled in by the Renderer when it's first drawn instanced.
+/// </summary>
+struct InstanceHandle {
+	InstanceHandle();
+
+	/// <summary>
+	/// Gives the slot back to its batch, if there is one.
+	/// </summary>
+	void Release();
+
+	/// <summary>
+	/// The batch the slot is in, or nullptr if there isn't one yet.
+	/// </summary>
+	std::shared_ptr<class InstanceBatch> batch;
+
+	/// <summary>
+	/// The slot in the batch.
+	/// </summary>
+	uint32_t slot;
+};
+
+/// <summary>
+/// Draws every renderer that shares a mesh and a material in a single instanced call.
+/// Each renderer owns a slot in a persistent instance buffer, and only the slots that changed since the last frame are uploaded.
+/// Batches are made and owned by the Renderer; don't create them directly.
+/// </summary>
+class InstanceBatch : public GPUResource {
+	public:
+	/// <summary>
+	/// Creates an empty batch for the given mesh and material.
+	/// </summary>
+	/// <param name="mesh">The mesh every instance draws.</param>
+	/// <param name="material">The material every instance draws with. It should be able to instance.</param>
+	InstanceBatch(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material);
+	~InstanceBatch();
+
+	/// <summary>
+	/// Reserves a slot in the batch. The slot is hidden until something is submitted into it.
+	/// </summary>
+	/// <returns>The slot that was reserved.</returns>
+	uint32_t AcquireSlot();
+
+	/// <summary>
+	/// Gives a slot back to the batch so it can be reused.
+	/// </summary>
+	/// <param name="slot">The slot to give back.</param>
+	void ReleaseSlot(uint32_t slot);
+
+	/// <summary>
+	/// Sets where and how a slot is drawn this frame. Slots that aren't submitted in a frame are hidden.
+	/// </summary>
+	/// <param name="slot">The slot to draw.</param>
+	/// <param name="model">The world matrix of the instance.</param>
+	/// <param name="color">The colour of the instance.</param>
+	void Submit(uint32_t slot, const glm::mat4& model, const glm::vec4& color);
+
+	/// <summary>
+	/// Uploads the changed instances and draws the whole batch. This should be called once per frame, after everything is submitted.
+	/// </summary>
+	/// <param name="state">The state cache to change state through.</param>
+	/// <returns>Whether a draw call was made.</returns>
+	bool Draw(GLStateCache& state);
+
+	/// <summary>
+	/// Returns whether this batch draws the given mesh and material.
+	/// </summary>
+	/// <param name="otherMesh">The mesh to check.</param>
+	/// <param name="otherMaterial">The material to check.</param>
+	/// <returns>Whether this batch draws the given mesh and material.</returns>
+	bool Matches(const Mesh* otherMesh, const Material* otherMaterial) const;
+
+	/// <summary>
+	/// Returns the number of slots that are currently reserved.
+	/// </summary>
+	/// <returns>The number of slots that are currently reserved.</returns>
+	size_t GetSlotCount() const;
+
+	/// <summary>
+	/// Returns the number of instances that were uploaded during the last Draw().
+	/// </summary>
+	/// <returns>The number of instances that were uploaded during the last Draw().</returns>
+	size_t GetUploadedCount() const;
+
+	protected:
+	void Restore() override;
+
+	private:
+	/// <summary>
+	/// Uploads every slot that changed. Nearby changes are merged so that a handful of moved instances doesn't become a handful of calls.
+	/// </summary>
+	void UploadChanges();
+
+	/// <summary>
+	/// Writes the given data into a slot, marking it for upload if it actually changed.
+	/// </summary>
+	/// <param name="slot">The slot to write.</param>
+	/// <param name="data">The new data.</param>
+	void Write(uint32_t slot, const InstanceData& data);
+
+	/// <summary>
+	/// The mesh every instance draws.
+	/// </summary>
+	std::shared_ptr<Mesh> mesh;
+
+	/// <summary>
+	/// The material every instance draws with.
+	/// </summary>
+	std::shared_ptr<Material> material;
+
+	/// <summary>
+	/// A copy of what is in the instance buffer. This is compared against to find out what changed.
+	/// </summary>
+	std::vector<InstanceData> instances;
+
+	/// <summary>
+	/// The frame each slot was last submitted in. Slots that weren't submitted this frame are hidden when drawing.
+	/// </summary>
+	std::vector<uint32_t> submittedFrame;
+
+	/// <summary>
+	/// Slots that have been given back and can be reused.
+	/// </summary>
+	std::vector<uint32_t> freeSlots;
+
+	/// <summary>
+	/// The current frame number, which goes up every Draw().
+	/// </summary>
+	uint32_t frame;
+
+	/// <summary>
+	/// Whether each slot has changed since it was last uploaded.
+	/// </summary>
+	std::vector<bool> dirty;
+
+	/// <summary>
+	/// Whether any slot needs uploading. This saves scanning the dirty flags on frames where nothing moved.
+	/// </summary>
+	bool anyDirty;
+
+	/// <summary>
+	/// The number of instances uploaded during the last Draw().
+	/// </summary>
+	size_t uploadedCount;
+
+	/// <summary>
+	/// The buffer holding the instance data.
+	/// </summary>
+	unsigned int instanceBuffer;
+
+	/// <summary>
+	/// How many instances the buffer currently has room for.
+	/// </summary>
+	size_t bufferCapacity;
+};
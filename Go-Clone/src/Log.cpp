@@ -0,0 +1,331 @@
+#include "Log.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static int64_t Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// <summary>
+/// What every message in a ring starts with. Records are kept to multiples of eight bytes, so the next one is always aligned.
+/// </summary>
+struct LogRecord {
+	/// <summary>
+	/// The size of the record in bytes, including this.
+	/// </summary>
+	uint32_t size;
+
+	/// <summary>
+	/// Whether this is just filling out the end of the ring, because the next message didn't fit. Only the size is set if so.
+	/// </summary>
+	uint32_t skip;
+
+	const LogFormat* format;
+
+	/// <summary>
+	/// When the message was written, in nanoseconds on the steady clock.
+	/// </summary>
+	int64_t time;
+};
+
+/// <summary>
+/// A single thread's messages. The thread moves the head forward as it writes, and the background thread moves the tail forward as
+/// it reads, so neither waits for the other.
+/// </summary>
+struct LogRing {
+	LogRing() : data(Log::ringSize), head(0), tail(0), reserved(0), dropped(0) {}
+
+	std::vector<uint8_t> data;
+	std::atomic<size_t> head;
+	std::atomic<size_t> tail;
+
+	/// <summary>
+	/// Where the head will be once the message being written is committed. Only the writing thread touches this.
+	/// </summary>
+	size_t reserved;
+
+	std::atomic<uint64_t> dropped;
+};
+
+/// <summary>
+/// Everything the background thread needs. The rings live until the program ends, even if their thread finishes first, so nothing
+/// is lost.
+/// </summary>
+struct LogState {
+	~LogState();
+
+	std::mutex ringsMutex;
+	std::vector<std::unique_ptr<LogRing>> rings;
+
+	/// <summary>
+	/// Only one thread empties the rings at a time, which keeps each ring to one reader.
+	/// </summary>
+	std::mutex drainMutex;
+	std::ofstream file;
+	std::ostream* output = nullptr;
+	std::string buffer;
+
+	std::thread thread;
+	std::mutex wakeMutex;
+	std::condition_variable wake;
+	bool running = false;
+
+	/// <summary>
+	/// Messages are timed from when the first one was written.
+	/// </summary>
+	int64_t startTime = Now();
+};
+
+static LogState& GetState() {
+	static LogState state;
+	return state;
+}
+
+static LogRing& GetThreadRing() {
+	thread_local LogRing* ring = nullptr;
+	if (ring == nullptr) {
+		LogState& state = GetState();
+		std::lock_guard<std::mutex> lock(state.ringsMutex);
+		state.rings.emplace_back(new LogRing());
+		ring = state.rings.back().get();
+	}
+	return *ring;
+}
+
+/// <summary>
+/// Turns a message back into text, filling in each {} from its arguments in order.
+/// </summary>
+static void FormatRecord(const LogRecord& record, const uint8_t* arguments, const uint8_t* end, int64_t startTime, std::string& buffer) {
+	static const char* levelNames[] = { "debug", "info", "warning", "error" };
+	char text[64];
+	std::snprintf(text, sizeof(text), "[%10.3f] %-7s ", (record.time - startTime) / 1.0e9, record.format->level < 4 ? levelNames[record.format->level] : "?");
+	buffer += text;
+
+	for (const char* format = record.format->text; *format != '\0'; ++format) {
+		if (format[0] != '{' || format[1] != '}') {
+			buffer += *format;
+			continue;
+		}
+		++format;
+		if (arguments >= end) {
+			buffer += "{}";
+			continue;
+		}
+		Log::EArgument type = static_cast<Log::EArgument>(*arguments++);
+		if (type == Log::EString) {
+			uint16_t length;
+			std::memcpy(&length, arguments, 2);
+			buffer.append(reinterpret_cast<const char*>(arguments + 2), length);
+			arguments += 2 + length;
+			continue;
+		}
+		if (type == Log::EBool) {
+			buffer += *arguments != 0 ? "true" : "false";
+			arguments += 1;
+			continue;
+		}
+		uint64_t bits;
+		std::memcpy(&bits, arguments, 8);
+		arguments += 8;
+		switch (type) {
+			case Log::ESigned:
+				std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(bits));
+				break;
+			case Log::EUnsigned:
+				std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(bits));
+				break;
+			case Log::EFloat: {
+				double value;
+				std::memcpy(&value, &bits, 8);
+				std::snprintf(text, sizeof(text), "%g", value);
+				break;
+			}
+			default:
+				std::snprintf(text, sizeof(text), "0x%llx", static_cast<unsigned long long>(bits));
+				break;
+		}
+		buffer += text;
+	}
+	buffer += '\n';
+}
+
+/// <summary>
+/// Formats and writes out everything waiting in the rings. The rings are read side by side, oldest message first, so messages from
+/// different threads come out in the order they were written.
+/// </summary>
+static void Drain(LogState& state) {
+	std::lock_guard<std::mutex> drainLock(state.drainMutex);
+	if (state.output == nullptr) {
+		return;
+	}
+
+	struct Reader {
+		LogRing* ring;
+		size_t tail;
+		size_t head;
+	};
+	std::vector<Reader> readers;
+	{
+		std::lock_guard<std::mutex> ringsLock(state.ringsMutex);
+		for (const std::unique_ptr<LogRing>& ring : state.rings) {
+			readers.push_back({ ring.get(), ring->tail.load(std::memory_order_relaxed), ring->head.load(std::memory_order_acquire) });
+		}
+	}
+
+	state.buffer.clear();
+	while (true) {
+		Reader* oldest = nullptr;
+		const LogRecord* oldestRecord = nullptr;
+		for (Reader& reader : readers) {
+			while (reader.tail != reader.head) {
+				const LogRecord* record = reinterpret_cast<const LogRecord*>(reader.ring->data.data() + (reader.tail & (Log::ringSize - 1)));
+				if (record->skip == 0) {
+					if (oldestRecord == nullptr || record->time < oldestRecord->time) {
+						oldest = &reader;
+						oldestRecord = record;
+					}
+					break;
+				}
+				reader.tail += record->size;
+			}
+		}
+		if (oldest == nullptr) {
+			break;
+		}
+		const uint8_t* arguments = reinterpret_cast<const uint8_t*>(oldestRecord + 1);
+		FormatRecord(*oldestRecord, arguments, reinterpret_cast<const uint8_t*>(oldestRecord) + oldestRecord->size, state.startTime, state.buffer);
+		oldest->tail += oldestRecord->size;
+		oldest->ring->tail.store(oldest->tail, std::memory_order_release);
+	}
+	for (Reader& reader : readers) {
+		reader.ring->tail.store(reader.tail, std::memory_order_release);
+	}
+
+	if (!state.buffer.empty()) {
+		state.output->write(state.buffer.data(), state.buffer.size());
+		state.output->flush();
+	}
+}
+
+LogState::~LogState() {
+	// This only happens if Log::Stop() was never called, and the thread has to be stopped before it's destroyed.
+	if (thread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(wakeMutex);
+			running = false;
+		}
+		wake.notify_one();
+		thread.join();
+		Drain(*this);
+	}
+}
+
+void Log::Start(const std::string& path) {
+	LogState& state = GetState();
+	if (state.running) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> drainLock(state.drainMutex);
+		state.output = &std::cout;
+		if (!path.empty()) {
+			state.file.open(path, std::ios::trunc);
+			if (state.file) {
+				state.output = &state.file;
+			} else {
+				std::cout << "Couldn't open " << path << " to log to, so the log goes to the console.\n";
+			}
+		}
+	}
+	state.running = true;
+	state.thread = std::thread([&state]() {
+		const std::chrono::milliseconds interval(static_cast<int64_t>(flushInterval));
+		std::unique_lock<std::mutex> lock(state.wakeMutex);
+		while (state.running) {
+			lock.unlock();
+			Drain(state);
+			lock.lock();
+			state.wake.wait_for(lock, interval);
+		}
+	});
+}
+
+void Log::Stop() {
+	LogState& state = GetState();
+	if (!state.running) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(state.wakeMutex);
+		state.running = false;
+	}
+	state.wake.notify_one();
+	state.thread.join();
+	Drain(state);
+
+	uint64_t dropped = GetDroppedCount();
+	std::lock_guard<std::mutex> drainLock(state.drainMutex);
+	if (dropped != 0) {
+		*state.output << dropped << " log messages were dropped because they were written faster than they could be saved.\n";
+	}
+	state.output->flush();
+	state.output = nullptr;
+	if (state.file.is_open()) {
+		state.file.close();
+	}
+}
+
+void Log::Flush() {
+	Drain(GetState());
+}
+
+uint64_t Log::GetDroppedCount() {
+	LogState& state = GetState();
+	std::lock_guard<std::mutex> lock(state.ringsMutex);
+	uint64_t dropped = 0;
+	for (const std::unique_ptr<LogRing>& ring : state.rings) {
+		dropped += ring->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+uint8_t* Log::Reserve(const LogFormat& format, size_t argumentSize) {
+	LogRing& ring = GetThreadRing();
+	size_t size = (sizeof(LogRecord) + argumentSize + 7) & ~static_cast<size_t>(7);
+	size_t head = ring.head.load(std::memory_order_relaxed);
+	size_t tail = ring.tail.load(std::memory_order_acquire);
+	size_t offset = head & (ringSize - 1);
+	// A message is never split across the end of the ring, so if it doesn't fit, the rest of the ring is skipped.
+	size_t skip = ringSize - offset < size ? ringSize - offset : 0;
+	if (size > ringSize / 4 || head + skip + size - tail > ringSize) {
+		ring.dropped.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	if (skip != 0) {
+		uint32_t skipHeader[2] = { static_cast<uint32_t>(skip), 1 };
+		std::memcpy(ring.data.data() + offset, skipHeader, sizeof(skipHeader));
+		head += skip;
+		offset = 0;
+	}
+	LogRecord* record = reinterpret_cast<LogRecord*>(ring.data.data() + offset);
+	record->size = static_cast<uint32_t>(size);
+	record->skip = 0;
+	record->format = &format;
+	record->time = Now();
+	ring.reserved = head + size;
+	return reinterpret_cast<uint8_t*>(record + 1);
+}
+
+void Log::Commit() {
+	LogRing& ring = GetThreadRing();
+	ring.head.store(ring.reserved, std::memory_order_release);
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#define GO_CLONE_LOG_DEBUG 0
+#define GO_CLONE_LOG_INFO 1
+#define GO_CLONE_LOG_WARNING 2
+#define GO_CLONE_LOG_ERROR 3
+#define GO_CLONE_LOG_NONE 4
+
+// Anything below this level is compiled out entirely. Debug builds keep everything, and release builds drop the debug messages.
+#ifndef GO_CLONE_LOG_LEVEL
+#ifdef NDEBUG
+#define GO_CLONE_LOG_LEVEL GO_CLONE_LOG_INFO
+#else
+#define GO_CLONE_LOG_LEVEL GO_CLONE_LOG_DEBUG
+#endif
+#endif
+
+/// <summary>
+/// How important a message is.
+/// </summary>
+enum ELogLevel : uint8_t {
+	ELogDebug = GO_CLONE_LOG_DEBUG,
+	ELogInfo = GO_CLONE_LOG_INFO,
+	ELogWarning = GO_CLONE_LOG_WARNING,
+	ELogError = GO_CLONE_LOG_ERROR
+};
+
+/// <summary>
+/// Everything about a message that's the same every time it's written. Each call site has one of these, made once, and its address
+/// is what gets written along with the arguments; the text is only looked at when the message is formatted.
+/// </summary>
+struct LogFormat {
+	ELogLevel level;
+
+	/// <summary>
+	/// The message, where each {} is replaced by the next argument.
+	/// </summary>
+	const char* text;
+
+	const char* file;
+	int line;
+};
+
+/// <summary>
+/// Writes messages without holding up the thread that writes them. Each thread has its own ring of memory, and a message is copied
+/// into it as the address of its format and its arguments, without formatting anything or taking a lock. A background thread
+/// collects the messages from every ring in the order they were written, formats them, and writes them to the console or a file.
+/// If a ring fills up faster than it's emptied, new messages are dropped and counted rather than waited on.
+/// Messages should be written with the LOG_ macros, which also filter out levels below GO_CLONE_LOG_LEVEL when compiling.
+/// </summary>
+class Log {
+	public:
+	/// <summary>
+	/// How many bytes of messages each thread can have waiting. This is a power of two so positions wrap into the ring cheaply.
+	/// </summary>
+	static const size_t ringSize = 64 * 1024;
+
+	/// <summary>
+	/// Longer strings are cut off at this many bytes.
+	/// </summary>
+	static const size_t maxStringLength = 1024;
+
+	/// <summary>
+	/// How often the background thread empties the rings, in milliseconds.
+	/// </summary>
+	static const uint32_t flushInterval = 2;
+
+	/// <summary>
+	/// The kinds of argument a message can have.
+	/// </summary>
+	enum EArgument : uint8_t {
+		ESigned,
+		EUnsigned,
+		EFloat,
+		EBool,
+		EString,
+		EPointer
+	};
+
+	/// <summary>
+	/// Starts the background thread. Messages written before this wait in their rings until it's called.
+	/// </summary>
+	/// <param name="path">The file to write to, or an empty string for the console.</param>
+	static void Start(const std::string& path);
+
+	/// <summary>
+	/// Writes out everything that's waiting and stops the background thread. Messages written after this aren't written out.
+	/// </summary>
+	static void Stop();
+
+	/// <summary>
+	/// Writes out everything that's waiting on the calling thread, so that anything printed straight to the console afterwards comes
+	/// after it.
+	/// </summary>
+	static void Flush();
+
+	/// <summary>
+	/// Returns how many messages were dropped because their thread's ring was full.
+	/// </summary>
+	/// <returns>The number of messages dropped.</returns>
+	static uint64_t GetDroppedCount();
+
+	/// <summary>
+	/// Copies a message into the calling thread's ring. Use the LOG_ macros instead of calling this directly.
+	/// </summary>
+	/// <param name="format">The call site's format, which must last for the rest of the program.</param>
+	/// <param name="arguments">Integers, floating point numbers, bools, strings and pointers.</param>
+	template <typename... Arguments>
+	static void Write(const LogFormat& format, const Arguments&... arguments) {
+		size_t size = 0;
+		int sizes[] = { 0, (size += ArgumentSize(arguments), 0)... };
+		(void)sizes;
+		uint8_t* cursor = Reserve(format, size);
+		if (cursor == nullptr) {
+			return;
+		}
+		int puts[] = { 0, (cursor = PutArgument(cursor, arguments), 0)... };
+		(void)puts;
+		Commit();
+	}
+
+	private:
+	/// <summary>
+	/// Makes room in the calling thread's ring for a message, and fills in everything but its arguments.
+	/// </summary>
+	/// <returns>Where the arguments go, or nullptr if there's no room.</returns>
+	static uint8_t* Reserve(const LogFormat& format, size_t argumentSize);
+
+	/// <summary>
+	/// Hands the message made with Reserve() over to the background thread.
+	/// </summary>
+	static void Commit();
+
+	template <typename T>
+	static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value || std::is_floating_point<T>::value, size_t>::type ArgumentSize(const T&) {
+		return 1 + 8;
+	}
+
+	static size_t ArgumentSize(bool) {
+		return 1 + 1;
+	}
+
+	static size_t ArgumentSize(const void*) {
+		return 1 + 8;
+	}
+
+	static size_t ArgumentSize(const char* text) {
+		return 1 + 2 + (text != nullptr ? strnlen(text, maxStringLength) : 0);
+	}
+
+	static size_t ArgumentSize(const std::string& text) {
+		return 1 + 2 + (text.size() < maxStringLength ? text.size() : maxStringLength);
+	}
+
+	template <typename T>
+	static typename std::enable_if<std::is_signed<T>::value && !std::is_floating_point<T>::value, uint8_t*>::type PutArgument(uint8_t* cursor, const T& value) {
+		int64_t widened = static_cast<int64_t>(value);
+		return PutValue(cursor, ESigned, &widened, 8);
+	}
+
+	template <typename T>
+	static typename std::enable_if<std::is_unsigned<T>::value || std::is_enum<T>::value, uint8_t*>::type PutArgument(uint8_t* cursor, const T& value) {
+		uint64_t widened = static_cast<uint64_t>(value);
+		return PutValue(cursor, EUnsigned, &widened, 8);
+	}
+
+	template <typename T>
+	static typename std::enable_if<std::is_floating_point<T>::value, uint8_t*>::type PutArgument(uint8_t* cursor, const T& value) {
+		double widened = static_cast<double>(value);
+		return PutValue(cursor, EFloat, &widened, 8);
+	}
+
+	static uint8_t* PutArgument(uint8_t* cursor, bool value) {
+		uint8_t byte = value ? 1 : 0;
+		return PutValue(cursor, EBool, &byte, 1);
+	}
+
+	static uint8_t* PutArgument(uint8_t* cursor, const void* value) {
+		uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+		return PutValue(cursor, EPointer, &address, 8);
+	}
+
+	static uint8_t* PutArgument(uint8_t* cursor, const char* text) {
+		return PutString(cursor, text != nullptr ? text : "", text != nullptr ? strnlen(text, maxStringLength) : 0);
+	}
+
+	static uint8_t* PutArgument(uint8_t* cursor, const std::string& text) {
+		return PutString(cursor, text.data(), text.size() < maxStringLength ? text.size() : maxStringLength);
+	}
+
+	static uint8_t* PutValue(uint8_t* cursor, EArgument type, const void* value, size_t size) {
+		*cursor = type;
+		std::memcpy(cursor + 1, value, size);
+		return cursor + 1 + size;
+	}
+
+	static uint8_t* PutString(uint8_t* cursor, const char* text, size_t length) {
+		uint16_t storedLength = static_cast<uint16_t>(length);
+		*cursor = EString;
+		std::memcpy(cursor + 1, &storedLength, 2);
+		std::memcpy(cursor + 3, text, length);
+		return cursor + 3 + length;
+	}
+};
+
+#define GO_CLONE_LOG_WRITE(logLevel, formatText, ...) do { \
+		static const LogFormat logFormat = { logLevel, formatText, __FILE__, __LINE__ }; \
+		Log::Write(logFormat, ##__VA_ARGS__); \
+	} while (false)
+
+#if GO_CLONE_LOG_LEVEL <= GO_CLONE_LOG_DEBUG
+#define LOG_DEBUG(formatText, ...) GO_CLONE_LOG_WRITE(ELogDebug, formatText, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(formatText, ...) do {} while (false)
+#endif
+
+#if GO_CLONE_LOG_LEVEL <= GO_CLONE_LOG_INFO
+#define LOG_INFO(formatText, ...) GO_CLONE_LOG_WRITE(ELogInfo, formatText, ##__VA_ARGS__)
+#else
+#define LOG_INFO(formatText, ...) do {} while (false)
+#endif
+
+#if GO_CLONE_LOG_LEVEL <= GO_CLONE_LOG_WARNING
+#define LOG_WARNING(formatText, ...) GO_CLONE_LOG_WRITE(ELogWarning, formatText, ##__VA_ARGS__)
+#else
+#define LOG_WARNING(formatText, ...) do {} while (false)
+#endif
+
+#if GO_CLONE_LOG_LEVEL <= GO_CLONE_LOG_ERROR
+#define LOG_ERROR(formatText, ...) GO_CLONE_LOG_WRITE(ELogError, formatText, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(formatText, ...) do {} while (false)
+#endif
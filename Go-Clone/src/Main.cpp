@@ -1,16 +1,18 @@
-#include <iostream>
-
+#include "GameArguments.h"
 #include "GoGame.h"
+#include "Log.h"
 
 int main(int argc, char* argv[]) {
-	std::cout << "This program has many features.\n";
+	GameArguments arguments = GameArguments::Parse(argc, argv);
+	Log::Start(arguments.logPath);
+	LOG_INFO("This program has many features.");
 
-	//TODO: Once the game arguments are finalised, pass them in here.
-	GoGame* game = new GoGame();
+	GoGame* game = new GoGame(arguments);
 
 	game->Start();
 
 	delete game;
 
+	Log::Stop();
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path) {
+	open = false;
+	data = nullptr;
+	size = 0;
+	mappingHandle = nullptr;
+	fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) {
+		fileHandle = nullptr;
+		return;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize)) {
+		return;
+	}
+	size = static_cast<size_t>(fileSize.QuadPart);
+	open = true;
+	// Empty files can't be mapped, but there's nothing to read anyway.
+	if (size == 0) {
+		return;
+	}
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle != nullptr) {
+		data = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	}
+	if (data == nullptr) {
+		open = false;
+		size = 0;
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+	if (mappingHandle != nullptr) {
+		CloseHandle(mappingHandle);
+	}
+	if (fileHandle != nullptr) {
+		CloseHandle(fileHandle);
+	}
+}
+#else
+MappedFile::MappedFile(const std::string& path) {
+	open = false;
+	data = nullptr;
+	size = 0;
+	fileDescriptor = ::open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) {
+		return;
+	}
+	struct stat status;
+	if (fstat(fileDescriptor, &status) != 0) {
+		return;
+	}
+	size = static_cast<size_t>(status.st_size);
+	open = true;
+	if (size == 0) {
+		return;
+	}
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (mapping == MAP_FAILED) {
+		open = false;
+		size = 0;
+		return;
+	}
+	data = static_cast<const uint8_t*>(mapping);
+	// The whole file is about to be read from start to end.
+	madvise(mapping, size, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+		munmap(const_cast<uint8_t*>(data), size);
+	}
+	if (fileDescriptor >= 0) {
+		close(fileDescriptor);
+	}
+}
+#endif
+
+bool MappedFile::IsOpen() const {
+	return open;
+}
+
+const uint8_t* MappedFile::GetData() const {
+	return data;
+}
+
+size_t MappedFile::GetSize() const {
+	return size;
+}
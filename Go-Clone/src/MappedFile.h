@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// A file mapped read only into memory, so it can be read without copying it into a buffer first.
+/// The mapping lasts as long as the object does.
+/// </summary>
+class MappedFile {
+	public:
+	/// <summary>
+	/// Maps the given file. Check IsOpen() to see whether it worked.
+	/// </summary>
+	/// <param name="path">The path of the file.</param>
+	MappedFile(const std::string& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// <summary>
+	/// Returns whether the file was mapped. Empty files count as mapped, with no data.
+	/// </summary>
+	/// <returns>Whether the file was mapped.</returns>
+	bool IsOpen() const;
+
+	/// <summary>
+	/// Returns the start of the file's contents. This is nullptr if the file is empty or couldn't be mapped.
+	/// </summary>
+	/// <returns>The start of the file's contents.</returns>
+	const uint8_t* GetData() const;
+
+	/// <summary>
+	/// Returns the size of the file in bytes.
+	/// </summary>
+	/// <returns>The size of the file in bytes.</returns>
+	size_t GetSize() const;
+
+	private:
+	bool open;
+	const uint8_t* data;
+	size_t size;
+
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#else
+	int fileDescriptor;
+#endif
+};
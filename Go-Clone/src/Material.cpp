@@ -0,0 +1,46 @@
+#include "Material.h"
+
+#include "GLExtensions.h"
+#include "IDPool.h"
+
+/// <summary>
+/// The IDs materials are given. This is made on first use so that it outlives anything that's registered in it, including static caches.
+/// </summary>
+static IDPool& MaterialIDs() {
+	static IDPool ids;
+	return ids;
+}
+
+Material::Material(std::shared_ptr<Shader> shader) : shader(shader) {
+	ID = MaterialIDs().Acquire();
+}
+
+Material::~Material() {
+	MaterialIDs().Release(ID);
+}
+
+uint32_t Material::GetID() const {
+	return ID;
+}
+
+std::shared_ptr<Shader> Material::GetShader() const {
+	return shader;
+}
+
+bool Material::CanInstance() {
+	return shader != nullptr && GLExtensions::HasShaderPipeline() && shader->Prepare();
+}
+
+std::shared_ptr<Material> Material::Default() {
+	return ForProgram(ShaderLibrary::ELit);
+}
+
+std::shared_ptr<Material> Material::ForProgram(ShaderLibrary::EProgram program) {
+	static std::weak_ptr<Material> cachedMaterials[ShaderLibrary::EProgramCount];
+	std::shared_ptr<Material> material = cachedMaterials[program].lock();
+	if (material == nullptr) {
+		material = std::make_shared<Material>(ShaderLibrary::Get(program));
+		cachedMaterials[program] = material;
+	}
+	return material;
+}
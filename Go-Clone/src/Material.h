@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "Shader.h"
+#include "ShaderLibrary.h"
+
+/// <summary>
+/// Describes how a mesh should be drawn, apart from its colour (which is per renderer).
+/// Renderers that share both a mesh and a material can be drawn together in one instanced call, so materials should be shared
+/// rather than copied wherever possible.
+/// </summary>
+class Material : public std::enable_shared_from_this<Material> {
+	public:
+	/// <summary>
+	/// Creates a material that uses the given shader.
+	/// </summary>
+	/// <param name="shader">The shader used for instanced drawing. If nullptr, the material is only drawn with fixed function.</param>
+	Material(std::shared_ptr<Shader> shader);
+	~Material();
+
+	Material(const Material&) = delete;
+	Material& operator=(const Material&) = delete;
+
+	/// <summary>
+	/// Returns the material's ID. This is unique between live materials, and IDs are reused once a material
+	/// is gone, so it stays small enough to be put in a sort key.
+	/// </summary>
+	/// <returns>The material's ID.</returns>
+	uint32_t GetID() const;
+
+	/// <summary>
+	/// Returns the shader used for instanced drawing. This can be nullptr.
+	/// </summary>
+	/// <returns>The shader used for instanced drawing.</returns>
+	std::shared_ptr<Shader> GetShader() const;
+
+	/// <summary>
+	/// Returns whether this material can be drawn instanced on the current context. This compiles the shader if needed,
+	/// so it should only be called while rendering.
+	/// </summary>
+	/// <returns>Whether this material can be drawn instanced.</returns>
+	bool CanInstance();
+
+	/// <summary>
+	/// Returns the default lit material. The same material is given to everyone who asks while it's still alive.
+	/// </summary>
+	/// <returns>The shared default material.</returns>
+	static std::shared_ptr<Material> Default();
+
+	/// <summary>
+	/// Returns a material that draws with one of the library's programs. The same material is given to everyone who asks for
+	/// that program while it's still alive.
+	/// </summary>
+	/// <param name="program">The program to draw with.</param>
+	/// <returns>The shared material.</returns>
+	static std::shared_ptr<Material> ForProgram(ShaderLibrary::EProgram program);
+
+	private:
+	/// <summary>
+	/// The material's ID.
+	/// </summary>
+	uint32_t ID;
+
+	/// <summary>
+	/// The shader used for instanced drawing.
+	/// </summary>
+	std::shared_ptr<Shader> shader;
+};
@@ -0,0 +1,309 @@
+#include "Mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include "GLExtensions.h"
+#include "IDPool.h"
+#include "Shader.h"
+
+/// <summary>
+/// The IDs meshes are given. This is made on first use so that it outlives anything that's registered in it, including static caches.
+/// </summary>
+static IDPool& MeshIDs() {
+	static IDPool ids;
+	return ids;
+}
+
+Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) : vertices(vertices), indices(indices) {
+	ID = MeshIDs().Acquire();
+	uploaded = false;
+	vertexBuffer = 0;
+	indexBuffer = 0;
+	vertexArray = 0;
+	vertexArrayGeneration = 0;
+	usesAttributes = false;
+
+	// The sphere is centred on the middle of the bounding box, which is close enough for culling.
+	glm::vec3 minimum(0.0f);
+	glm::vec3 maximum(0.0f);
+	if (!vertices.empty()) {
+		minimum = vertices[0].position;
+		maximum = vertices[0].position;
+	}
+	for (const Vertex& vertex : vertices) {
+		minimum = glm::min(minimum, vertex.position);
+		maximum = glm::max(maximum, vertex.position);
+	}
+	boundsCenter = (minimum + maximum) * 0.5f;
+	boundsRadius = 0.0f;
+	for (const Vertex& vertex : vertices) {
+		boundsRadius = std::max(boundsRadius, glm::length(vertex.position - boundsCenter));
+	}
+}
+
+Mesh::~Mesh() {
+	MeshIDs().Release(ID);
+	if (vertexArray != 0 && vertexArrayGeneration == GLExtensions::GetContextGeneration()) {
+		GLExtensions::DeleteVertexArrays(1, &vertexArray);
+	}
+	if (vertexBuffer != 0) {
+		GLExtensions::DeleteBuffers(1, &vertexBuffer);
+	}
+	if (indexBuffer != 0) {
+		GLExtensions::DeleteBuffers(1, &indexBuffer);
+	}
+}
+
+void Mesh::Draw() {
+	Bind();
+	DrawElements(1);
+	Unbind();
+}
+
+void Mesh::Prepare() {
+	if (!uploaded) {
+		Upload();
+	}
+}
+
+size_t Mesh::GetUploadSize() const {
+	return vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t);
+}
+
+void Mesh::Bind() {
+	if (!uploaded) {
+		Upload();
+	}
+	if (vertexArray != 0 && vertexArrayGeneration != GLExtensions::GetContextGeneration()) {
+		// The old vertex array went away with the old context.
+		CreateVertexArray();
+	}
+
+	if (vertexArray != 0) {
+		GLExtensions::BindVertexArray(vertexArray);
+	} else {
+		if (vertexBuffer != 0) {
+			GLExtensions::BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+			GLExtensions::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+		}
+		SetVertexPointers();
+	}
+}
+
+void Mesh::DrawElements(size_t instances) {
+	// Without an index buffer, the indices are read straight out of client memory.
+	const void* indexData = indexBuffer != 0 ? nullptr : indices.data();
+	if (instances == 1) {
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, indexData);
+	} else if (instances > 1) {
+		GLExtensions::DrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, indexData, static_cast<GLsizei>(instances));
+	}
+}
+
+void Mesh::Unbind() {
+	if (vertexArray != 0) {
+		GLExtensions::BindVertexArray(0);
+	} else {
+		DisableVertexPointers();
+		if (vertexBuffer != 0) {
+			GLExtensions::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			GLExtensions::BindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+	}
+}
+
+uint32_t Mesh::GetID() const {
+	return ID;
+}
+
+size_t Mesh::GetIndexCount() const {
+	return indices.size();
+}
+
+glm::vec3 Mesh::GetBoundsCenter() const {
+	return boundsCenter;
+}
+
+float Mesh::GetBoundsRadius() const {
+	return boundsRadius;
+}
+
+std::shared_ptr<Mesh> Mesh::Cube() {
+	// Only a weak pointer is kept so that the buffers are freed with the last cube rather than after the context is gone.
+	static std::weak_ptr<Mesh> cachedCube;
+	std::shared_ptr<Mesh> cube = cachedCube.lock();
+	if (cube != nullptr) {
+		return cube;
+	}
+
+	// Every face is two triangles, wound counter-clockwise from the outside.
+	static const float faces[6][2][3][3] = {
+		{{{-1, -1, -1}, {1, -1, -1}, {-1, -1, 1}}, {{1, -1, -1}, {1, -1, 1}, {-1, -1, 1}}},
+		{{{1, 1, -1}, {-1, 1, -1}, {-1, 1, 1}}, {{1, 1, 1}, {1, 1, -1}, {-1, 1, 1}}},
+		{{{1, 1, 1}, {1, -1, 1}, {1, 1, -1}}, {{1, 1, -1}, {1, -1, 1}, {1, -1, -1}}},
+		{{{-1, -1, 1}, {-1, 1, 1}, {-1, 1, -1}}, {{-1, -1, 1}, {-1, 1, -1}, {-1, -1, -1}}},
+		{{{-1, 1, 1}, {-1, -1, 1}, {1, -1, 1}}, {{1, 1, 1}, {-1, 1, 1}, {1, -1, 1}}},
+		{{{-1, -1, -1}, {-1, 1, -1}, {1, -1, -1}}, {{-1, 1, -1}, {1, 1, -1}, {1, -1, -1}}}
+	};
+	static const float normals[6][3] = {
+		{0, -1, 0}, {0, 1, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 0, 1}, {0, 0, -1}
+	};
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	for (int face = 0; face < 6; ++face) {
+		glm::vec3 normal(normals[face][0], normals[face][1], normals[face][2]);
+		for (int triangle = 0; triangle < 2; ++triangle) {
+			for (int corner = 0; corner < 3; ++corner) {
+				const float* p = faces[face][triangle][corner];
+				glm::vec3 position(p[0], p[1], p[2]);
+				// Corners shared within a face are only stored once.
+				uint32_t index = static_cast<uint32_t>(vertices.size());
+				for (uint32_t i = 0; i < vertices.size(); ++i) {
+					if (vertices[i].position == position && vertices[i].normal == normal) {
+						index = i;
+						break;
+					}
+				}
+				if (index == vertices.size()) {
+					vertices.push_back(Vertex{position, normal});
+				}
+				indices.push_back(index);
+			}
+		}
+	}
+
+	cube = std::make_shared<Mesh>(vertices, indices);
+	cachedCube = cube;
+	return cube;
+}
+
+std::shared_ptr<Mesh> Mesh::Stone(uint32_t segments) {
+	segments = std::max(segments, 4u);
+	static std::map<uint32_t, std::weak_ptr<Mesh>> cachedStones;
+	std::weak_ptr<Mesh>& cachedStone = cachedStones[segments];
+	std::shared_ptr<Mesh> stone = cachedStone.lock();
+	if (stone != nullptr) {
+		return stone;
+	}
+
+	const uint32_t rings = segments / 2;
+	const float halfThickness = 0.5f;
+	const float pi = 3.14159265358979f;
+
+	// The rings go from the top to the bottom. The first and last columns are at the same place, so the seam gets its own vertices.
+	std::vector<Vertex> vertices;
+	for (uint32_t ring = 0; ring <= rings; ++ring) {
+		float latitude = pi * ring / rings;
+		for (uint32_t segment = 0; segment <= segments; ++segment) {
+			float longitude = 2.0f * pi * segment / segments;
+			glm::vec3 position(std::sin(latitude) * std::cos(longitude), halfThickness * std::cos(latitude), std::sin(latitude) * std::sin(longitude));
+			// The normal of a squashed sphere is stretched the opposite way to the surface.
+			glm::vec3 normal = glm::normalize(glm::vec3(position.x, position.y / (halfThickness * halfThickness), position.z));
+			vertices.push_back(Vertex{position, normal});
+		}
+	}
+
+	std::vector<uint32_t> indices;
+	for (uint32_t ring = 0; ring < rings; ++ring) {
+		for (uint32_t segment = 0; segment < segments; ++segment) {
+			uint32_t topLeft = ring * (segments + 1) + segment;
+			uint32_t bottomLeft = topLeft + segments + 1;
+			// The triangles that would touch a pole with two corners have no area, so they're left out.
+			if (ring != 0) {
+				indices.insert(indices.end(), {topLeft, topLeft + 1, bottomLeft});
+			}
+			if (ring != rings - 1) {
+				indices.insert(indices.end(), {topLeft + 1, bottomLeft + 1, bottomLeft});
+			}
+		}
+	}
+
+	stone = std::make_shared<Mesh>(vertices, indices);
+	cachedStone = stone;
+	return stone;
+}
+
+void Mesh::Restore() {
+	bool wasUploaded = uploaded;
+	uploaded = false;
+	vertexBuffer = 0;
+	indexBuffer = 0;
+	vertexArray = 0;
+	if (wasUploaded) {
+		Upload();
+	}
+}
+
+void Mesh::Upload() {
+	uploaded = true;
+	if (!GLExtensions::HasBuffers()) {
+		return;
+	}
+
+	GLExtensions::GenBuffers(1, &vertexBuffer);
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	GLExtensions::BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+
+	GLExtensions::GenBuffers(1, &indexBuffer);
+	GLExtensions::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	GLExtensions::BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+
+	GLExtensions::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (GLExtensions::HasVertexArrays()) {
+		CreateVertexArray();
+	}
+}
+
+void Mesh::CreateVertexArray() {
+	// The vertex array captures the bound buffers and the pointers, so drawing only needs to bind it.
+	GLExtensions::GenVertexArrays(1, &vertexArray);
+	vertexArrayGeneration = GLExtensions::GetContextGeneration();
+	GLExtensions::BindVertexArray(vertexArray);
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	GLExtensions::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	SetVertexPointers();
+	GLExtensions::BindVertexArray(0);
+	GLExtensions::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Mesh::SetVertexPointers() {
+	const void* position = &vertices[0].position;
+	const void* normal = &vertices[0].normal;
+	if (vertexBuffer != 0) {
+		position = reinterpret_cast<const void*>(offsetof(Vertex, position));
+		normal = reinterpret_cast<const void*>(offsetof(Vertex, normal));
+	}
+
+	usesAttributes = GLExtensions::HasShaderPipeline();
+	if (usesAttributes) {
+		GLExtensions::EnableVertexAttribArray(Shader::EPosition);
+		GLExtensions::EnableVertexAttribArray(Shader::ENormal);
+		GLExtensions::VertexAttribPointer(Shader::EPosition, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), position);
+		GLExtensions::VertexAttribPointer(Shader::ENormal, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), normal);
+	} else {
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glVertexPointer(3, GL_FLOAT, sizeof(Vertex), position);
+		glNormalPointer(GL_FLOAT, sizeof(Vertex), normal);
+	}
+}
+
+void Mesh::DisableVertexPointers() {
+	if (usesAttributes) {
+		GLExtensions::DisableVertexAttribArray(Shader::ENormal);
+		GLExtensions::DisableVertexAttribArray(Shader::EPosition);
+	} else {
+		glDisableClientState(GL_NORMAL_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+	}
+}
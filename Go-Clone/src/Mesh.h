@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "GPUResource.h"
+
+/// <summary>
+/// A single point of a mesh. This is laid out exactly how it is uploaded to the graphics card.
+/// </summary>
+struct Vertex {
+	glm::vec3 position;
+	glm::vec3 normal;
+};
+
+/// <summary>
+/// A piece of geometry that lives on the graphics card. The vertex and index data are uploaded once, and every draw after that
+/// just binds the buffers again. Meshes should be shared between renderers using shared pointers rather than copied.
+/// </summary>
+class Mesh : public GPUResource, public std::enable_shared_from_this<Mesh> {
+	public:
+	/// <summary>
+	/// Creates a mesh from the given data. Nothing is uploaded until the first draw, so this can be made before a context exists.
+	/// </summary>
+	/// <param name="vertices">The vertices of the mesh.</param>
+	/// <param name="indices">The indices of the mesh, every three of which make a triangle.</param>
+	Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+	~Mesh();
+
+	/// <summary>
+	/// Draws the mesh using whatever state is currently set. The buffers are uploaded here if they haven't been already.
+	/// </summary>
+	void Draw();
+
+	/// <summary>
+	/// Uploads the mesh now if it hasn't been already, rather than waiting for the first draw. This needs a current context.
+	/// </summary>
+	void Prepare();
+
+	/// <summary>
+	/// Returns how many bytes the mesh takes up on the graphics card.
+	/// </summary>
+	/// <returns>The size of the vertex and index data.</returns>
+	size_t GetUploadSize() const;
+
+	/// <summary>
+	/// Binds the mesh's vertex data so that DrawElements() can be called, possibly more than once.
+	/// The buffers are uploaded here if they haven't been already.
+	/// </summary>
+	void Bind();
+
+	/// <summary>
+	/// Draws the bound mesh the given number of times. Anything more than one needs instancing support and a shader that reads
+	/// per-instance data, otherwise every copy lands in the same place.
+	/// </summary>
+	/// <param name="instances">How many copies to draw.</param>
+	void DrawElements(size_t instances);
+
+	/// <summary>
+	/// Unbinds the mesh's vertex data. This should be called once drawing with Bind() is done.
+	/// </summary>
+	void Unbind();
+
+	/// <summary>
+	/// Returns the mesh's ID. This is unique between live meshes, and IDs are reused once a mesh is gone,
+	/// so it stays small enough to be put in a sort key.
+	/// </summary>
+	/// <returns>The mesh's ID.</returns>
+	uint32_t GetID() const;
+
+	/// <summary>
+	/// Returns the number of indices in the mesh.
+	/// </summary>
+	/// <returns>The number of indices in the mesh.</returns>
+	size_t GetIndexCount() const;
+
+	/// <summary>
+	/// Returns the centre of a sphere that holds every vertex of the mesh.
+	/// </summary>
+	/// <returns>The centre of the bounding sphere.</returns>
+	glm::vec3 GetBoundsCenter() const;
+
+	/// <summary>
+	/// Returns the radius of a sphere that holds every vertex of the mesh.
+	/// </summary>
+	/// <returns>The radius of the bounding sphere.</returns>
+	float GetBoundsRadius() const;
+
+	/// <summary>
+	/// Returns a 2x2x2 cube centred on the origin. The same mesh is given to everyone who asks while it's still alive.
+	/// </summary>
+	/// <returns>The shared cube mesh.</returns>
+	static std::shared_ptr<Mesh> Cube();
+
+	/// <summary>
+	/// The number of segments around a stone if Stone() isn't told otherwise.
+	/// </summary>
+	static const uint32_t defaultStoneSegments = 16;
+
+	/// <summary>
+	/// Returns a Go stone: a flattened sphere 2 units across and 1 unit thick, centred on the origin with its flat sides facing up and down.
+	/// The same mesh is given to everyone who asks for the same detail while it's still alive.
+	/// </summary>
+	/// <param name="segments">How many segments go around the stone. It has half as many rings from top to bottom. At least 4.</param>
+	/// <returns>The shared stone mesh.</returns>
+	static std::shared_ptr<Mesh> Stone(uint32_t segments = defaultStoneSegments);
+
+	protected:
+	void Restore() override;
+
+	private:
+	/// <summary>
+	/// Sends the vertex and index data to the graphics card. If buffer objects aren't supported, this does nothing and the data is
+	/// drawn from client memory instead.
+	/// </summary>
+	void Upload();
+
+	/// <summary>
+	/// Makes the vertex array for the current context. Vertex arrays aren't shared between contexts, so this is redone whenever the window is remade.
+	/// </summary>
+	void CreateVertexArray();
+
+	/// <summary>
+	/// Turns on the vertex arrays and points them at the currently bound data (or the client side data if there are no buffers).
+	/// Shaders read the generic attributes and fixed function reads the old vertex and normal arrays, but never both at once,
+	/// since some drivers alias the two.
+	/// </summary>
+	void SetVertexPointers();
+
+	/// <summary>
+	/// Turns off whichever vertex arrays SetVertexPointers() turned on.
+	/// </summary>
+	void DisableVertexPointers();
+
+	/// <summary>
+	/// The mesh's ID.
+	/// </summary>
+	uint32_t ID;
+
+	/// <summary>
+	/// A copy of the vertices. This is kept around so that the mesh can be drawn without buffers.
+	/// </summary>
+	std::vector<Vertex> vertices;
+
+	/// <summary>
+	/// A copy of the indices. This is kept around so that the mesh can be drawn without buffers.
+	/// </summary>
+	std::vector<uint32_t> indices;
+
+	/// <summary>
+	/// Whether Upload() has been called yet.
+	/// </summary>
+	bool uploaded;
+
+	/// <summary>
+	/// The buffer holding the vertices. 0 if there isn't one.
+	/// </summary>
+	unsigned int vertexBuffer;
+
+	/// <summary>
+	/// The buffer holding the indices. 0 if there isn't one.
+	/// </summary>
+	unsigned int indexBuffer;
+
+	/// <summary>
+	/// The vertex array that remembers the vertex layout. 0 if there isn't one.
+	/// </summary>
+	unsigned int vertexArray;
+
+	/// <summary>
+	/// The context generation the vertex array was made in.
+	/// </summary>
+	unsigned int vertexArrayGeneration;
+
+	/// <summary>
+	/// Whether the vertex layout was last given through generic attributes rather than the fixed function arrays.
+	/// </summary>
+	bool usesAttributes;
+
+	/// <summary>
+	/// The centre of the bounding sphere.
+	/// </summary>
+	glm::vec3 boundsCenter;
+
+	/// <summary>
+	/// The radius of the bounding sphere.
+	/// </summary>
+	float boundsRadius;
+};
@@ -0,0 +1,63 @@
+#include "MeshLOD.h"
+
+MeshLOD::MeshLOD(float hysteresis) : hysteresis(hysteresis) {
+}
+
+MeshLOD::~MeshLOD() {
+}
+
+void MeshLOD::AddLevel(std::shared_ptr<Mesh> mesh, float minScreenSize) {
+	levels.push_back(Level{mesh, minScreenSize});
+}
+
+size_t MeshLOD::GetLevelCount() const {
+	return levels.size();
+}
+
+const MeshLOD::Level& MeshLOD::GetLevel(size_t index) const {
+	return levels[index];
+}
+
+uint32_t MeshLOD::Select(float screenSize, uint32_t current) const {
+	if (levels.empty()) {
+		return 0;
+	}
+	uint32_t last = static_cast<uint32_t>(levels.size() - 1);
+	if (current > last) {
+		current = last;
+	}
+
+	uint32_t wanted = last;
+	for (uint32_t level = 0; level < last; ++level) {
+		if (screenSize >= levels[level].minScreenSize) {
+			wanted = level;
+			break;
+		}
+	}
+
+	// Dropping detail has to get a margin below the current level's boundary, and adding it a margin above the next one up.
+	if (wanted > current && screenSize > levels[current].minScreenSize * (1.0f - hysteresis)) {
+		return current;
+	}
+	if (wanted < current && screenSize < levels[current - 1].minScreenSize * (1.0f + hysteresis)) {
+		return current;
+	}
+	return wanted;
+}
+
+std::shared_ptr<MeshLOD> MeshLOD::Stone() {
+	static std::weak_ptr<MeshLOD> cachedStone;
+	std::shared_ptr<MeshLOD> stone = cachedStone.lock();
+	if (stone != nullptr) {
+		return stone;
+	}
+
+	// Each level has about a quarter of the triangles of the one before, and takes over once the extra ones are only a few pixels big.
+	stone = std::make_shared<MeshLOD>();
+	stone->AddLevel(Mesh::Stone(64), 0.25f);
+	stone->AddLevel(Mesh::Stone(32), 0.08f);
+	stone->AddLevel(Mesh::Stone(16), 0.03f);
+	stone->AddLevel(Mesh::Stone(8), 0.0f);
+	cachedStone = stone;
+	return stone;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Mesh.h"
+
+/// <summary>
+/// A set of meshes of the same thing at different levels of detail. Each renderer picks the one to draw from how big the object
+/// looks on screen, so objects far away (or in a zoomed out view) don't spend triangles on detail smaller than a pixel.
+/// To stop objects flicking between two levels when they sit near the boundary, a level is only left once the size is a margin
+/// past the boundary.
+/// </summary>
+class MeshLOD {
+	public:
+	/// <summary>
+	/// A single level of detail.
+	/// </summary>
+	struct Level {
+		/// <summary>
+		/// The mesh drawn at this level.
+		/// </summary>
+		std::shared_ptr<Mesh> mesh;
+
+		/// <summary>
+		/// The smallest size on screen this level is drawn at, as a fraction of the height of the view.
+		/// </summary>
+		float minScreenSize;
+	};
+
+	/// <summary>
+	/// Creates an empty set of levels.
+	/// </summary>
+	/// <param name="hysteresis">How far past a boundary the size has to go before the level changes, as a fraction of the boundary.</param>
+	MeshLOD(float hysteresis = 0.15f);
+	~MeshLOD();
+
+	/// <summary>
+	/// Adds a level. Levels must be added from the most detailed to the least, with smaller sizes each time. The last level is used
+	/// however small the object gets.
+	/// </summary>
+	/// <param name="mesh">The mesh for the level.</param>
+	/// <param name="minScreenSize">The smallest size on screen this level is drawn at, as a fraction of the height of the view.</param>
+	void AddLevel(std::shared_ptr<Mesh> mesh, float minScreenSize);
+
+	/// <summary>
+	/// Returns the number of levels.
+	/// </summary>
+	/// <returns>The number of levels.</returns>
+	size_t GetLevelCount() const;
+
+	/// <summary>
+	/// Returns a level, where 0 is the most detailed.
+	/// </summary>
+	/// <param name="index">The level.</param>
+	/// <returns>The level.</returns>
+	const Level& GetLevel(size_t index) const;
+
+	/// <summary>
+	/// Picks the level to draw at, given the one that was drawn last time.
+	/// </summary>
+	/// <param name="screenSize">The size of the object on screen, as a fraction of the height of the view.</param>
+	/// <param name="current">The level the object was drawn at last time.</param>
+	/// <returns>The level to draw at now.</returns>
+	uint32_t Select(float screenSize, uint32_t current) const;
+
+	/// <summary>
+	/// Returns the levels for a Go stone, from a smooth stone for close ups down to a handful of triangles for overviews.
+	/// The same levels are given to everyone who asks while they're still alive.
+	/// </summary>
+	/// <returns>The shared stone levels.</returns>
+	static std::shared_ptr<MeshLOD> Stone();
+
+	private:
+	std::vector<Level> levels;
+
+	float hysteresis;
+};
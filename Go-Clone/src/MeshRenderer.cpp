@@ -0,0 +1,147 @@
+#include "MeshRenderer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <glm/geometric.hpp>
+#include <SFML/OpenGL.hpp>
+
+/// <summary>
+/// Every renderer with a mesh asset it's waiting on. This is only touched on the render thread.
+/// </summary>
+static std::vector<MeshRenderer*>& Waiting() {
+	static std::vector<MeshRenderer*> waiting;
+	return waiting;
+}
+
+MeshRenderer::MeshRenderer(GameObject* gameObject) : Renderable(gameObject) {
+	color = glm::vec3(0.5f, 0.5f, 0.5f);
+	currentLevel = 0;
+	waitingIndex = 0;
+	material = Material::Default();
+}
+
+MeshRenderer::~MeshRenderer() {
+	SetMeshAsset(nullptr);
+	instance.Release();
+}
+
+void MeshRenderer::Render() {
+	if (mesh == nullptr) {
+		return;
+	}
+
+	// Meshes are always queued with their mesh, so this is only reached when drawing one by hand, with whatever state the caller set.
+	glColor3f(color.r, color.g, color.b);
+	mesh->Draw();
+}
+
+void MeshRenderer::Submit(RenderQueue& queue, const glm::mat4& model) {
+	// This can be on a traversal thread, so the mesh is only read here. Loaded assets are swapped in by ResolveMeshAssets().
+	Mesh* drawn = lod != nullptr && lod->GetLevelCount() != 0 ? lod->GetLevel(0).mesh.get() : mesh.get();
+	if (drawn == nullptr) {
+		return;
+	}
+
+	// The sphere is scaled by the largest axis, so it still holds the mesh under uneven scales.
+	// Every level is the same shape, so the most detailed one's bounds are used for all of them.
+	glm::vec3 center = glm::vec3(model * glm::vec4(drawn->GetBoundsCenter(), 1.0f));
+	float scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+	float radius = drawn->GetBoundsRadius() * scale;
+	if (!queue.IsVisible(center, radius)) {
+		return;
+	}
+	if (lod != nullptr && lod->GetLevelCount() != 0) {
+		// Only this renderer's own level changes, so this is safe on a traversal thread.
+		currentLevel = lod->Select(queue.GetScreenSize(center, radius), currentLevel);
+		drawn = lod->GetLevel(currentLevel).mesh.get();
+	}
+
+	DrawCommand command;
+	command.sortKey = queue.MakeKey(RenderQueue::EOpaque, material != nullptr ? material->GetID() : 0, drawn->GetID(), model);
+	command.mesh = drawn;
+	command.material = material.get();
+	command.instance = &instance;
+	command.renderable = this;
+	command.model = model;
+	command.color = glm::vec4(color, 1.0f);
+	queue.Push(command);
+}
+
+std::shared_ptr<Mesh> MeshRenderer::GetMesh() const {
+	return mesh;
+}
+
+void MeshRenderer::SetMesh(std::shared_ptr<Mesh> newMesh) {
+	if (newMesh != mesh) {
+		instance.Release();
+	}
+	this->mesh = newMesh;
+}
+
+void MeshRenderer::SetMeshAsset(std::shared_ptr<Asset> asset) {
+	std::vector<MeshRenderer*>& waiting = Waiting();
+	if (meshAsset == nullptr && asset != nullptr) {
+		waitingIndex = waiting.size();
+		waiting.push_back(this);
+	} else if (meshAsset != nullptr && asset == nullptr) {
+		// The last renderer takes this one's place so that nothing needs to shift down.
+		waiting[waitingIndex] = waiting.back();
+		waiting[waitingIndex]->waitingIndex = waitingIndex;
+		waiting.pop_back();
+	}
+	meshAsset = asset;
+}
+
+size_t MeshRenderer::ResolveMeshAssets() {
+	std::vector<MeshRenderer*>& waiting = Waiting();
+	size_t resolved = 0;
+	// Going backwards means a renderer that stops waiting is only ever replaced by one that's already been looked at.
+	for (size_t i = waiting.size(); i-- > 0;) {
+		MeshRenderer* renderer = waiting[i];
+		if (renderer->meshAsset->GetState() < Asset::EReady) {
+			continue;
+		}
+		if (renderer->meshAsset->IsReady()) {
+			renderer->SetMesh(renderer->meshAsset->GetMesh());
+		}
+		renderer->SetMeshAsset(nullptr);
+		++resolved;
+	}
+	return resolved;
+}
+
+std::shared_ptr<MeshLOD> MeshRenderer::GetLOD() const {
+	return lod;
+}
+
+void MeshRenderer::SetLOD(std::shared_ptr<MeshLOD> newLOD) {
+	if (newLOD != lod) {
+		instance.Release();
+	}
+	lod = newLOD;
+	currentLevel = 0;
+}
+
+uint32_t MeshRenderer::GetCurrentLevel() const {
+	return currentLevel;
+}
+
+std::shared_ptr<Material> MeshRenderer::GetMaterial() const {
+	return material;
+}
+
+void MeshRenderer::SetMaterial(std::shared_ptr<Material> newMaterial) {
+	if (newMaterial != material) {
+		instance.Release();
+	}
+	this->material = newMaterial;
+}
+
+glm::vec3 MeshRenderer::GetColor() const {
+	return color;
+}
+
+void MeshRenderer::SetColor(const glm::vec3& newColor) {
+	this->color = newColor;
+}
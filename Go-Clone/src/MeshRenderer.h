@@ -0,0 +1,138 @@
+#pragma once
+
+#include <memory>
+
+#include <glm/vec3.hpp>
+
+#include "Asset.h"
+#include "ComponentTypes.h"
+#include "InstanceBatch.h"
+#include "Material.h"
+#include "Mesh.h"
+#include "MeshLOD.h"
+
+/// <summary>
+/// Draws a mesh at the object's transform. The mesh is only referenced, so many renderers can point at the same one.
+/// If the material can be instanced, the renderer puts it in the batch for that mesh and material, so every renderer sharing them
+/// costs one draw call between them.
+/// </summary>
+class MeshRenderer : public Renderable {
+	public:
+	MeshRenderer(class GameObject* gameObject);
+	~MeshRenderer();
+
+	void Render() override;
+
+	void Submit(RenderQueue& queue, const glm::mat4& model) override;
+
+	/// <summary>
+	/// Returns the mesh that is drawn. This can be nullptr, in which case nothing is drawn.
+	/// </summary>
+	/// <returns>The mesh that is drawn.</returns>
+	std::shared_ptr<Mesh> GetMesh() const;
+
+	/// <summary>
+	/// Sets the mesh that is drawn.
+	/// </summary>
+	/// <param name="newMesh">The new mesh.</param>
+	void SetMesh(std::shared_ptr<Mesh> newMesh);
+
+	/// <summary>
+	/// Swaps the mesh for the one in the given asset once it's loaded. Until then, the current mesh is drawn, so something cheap can be
+	/// shown straight away and replaced with the detailed version when it arrives. If the asset fails, the current mesh is kept.
+	/// The swap happens in ResolveMeshAssets().
+	/// </summary>
+	/// <param name="asset">A mesh asset, or nullptr to stop waiting for one.</param>
+	void SetMeshAsset(std::shared_ptr<Asset> asset);
+
+	/// <summary>
+	/// Swaps in the mesh of every renderer whose mesh asset has finished loading. This should be called once per frame on the render
+	/// thread, after AssetLoader::UploadPending(), since dropping the old mesh can delete its buffers.
+	/// </summary>
+	/// <returns>How many renderers stopped waiting on their asset.</returns>
+	static size_t ResolveMeshAssets();
+
+	/// <summary>
+	/// Returns the levels of detail the renderer picks from, if it has them.
+	/// </summary>
+	/// <returns>The levels of detail, or nullptr.</returns>
+	std::shared_ptr<MeshLOD> GetLOD() const;
+
+	/// <summary>
+	/// Gives the renderer levels of detail to pick from, by how big the object looks on screen. While it has them, they're drawn
+	/// instead of the mesh.
+	/// </summary>
+	/// <param name="newLOD">The levels of detail, or nullptr to go back to the mesh.</param>
+	void SetLOD(std::shared_ptr<MeshLOD> newLOD);
+
+	/// <summary>
+	/// Returns the level of detail that was last drawn, where 0 is the most detailed.
+	/// </summary>
+	/// <returns>The level of detail that was last drawn.</returns>
+	uint32_t GetCurrentLevel() const;
+
+	/// <summary>
+	/// Returns the material the mesh is drawn with.
+	/// </summary>
+	/// <returns>The material the mesh is drawn with.</returns>
+	std::shared_ptr<Material> GetMaterial() const;
+
+	/// <summary>
+	/// Sets the material the mesh is drawn with. If nullptr, the mesh is always drawn with fixed function.
+	/// </summary>
+	/// <param name="newMaterial">The new material.</param>
+	void SetMaterial(std::shared_ptr<Material> newMaterial);
+
+	/// <summary>
+	/// Returns the colour the mesh is drawn with.
+	/// </summary>
+	/// <returns>The colour the mesh is drawn with.</returns>
+	glm::vec3 GetColor() const;
+
+	/// <summary>
+	/// Sets the colour the mesh is drawn with.
+	/// </summary>
+	/// <param name="newColor">The new colour.</param>
+	void SetColor(const glm::vec3& newColor);
+
+	private:
+	/// <summary>
+	/// The mesh that is drawn.
+	/// </summary>
+	std::shared_ptr<Mesh> mesh;
+
+	/// <summary>
+	/// The asset that will replace the mesh once it's ready. nullptr if there isn't one.
+	/// </summary>
+	std::shared_ptr<Asset> meshAsset;
+
+	/// <summary>
+	/// Where this renderer is in the list of those waiting on a mesh asset, while it has one.
+	/// </summary>
+	size_t waitingIndex;
+
+	/// <summary>
+	/// The levels of detail that are drawn instead of the mesh. nullptr if there aren't any.
+	/// </summary>
+	std::shared_ptr<MeshLOD> lod;
+
+	/// <summary>
+	/// The level of detail that was last drawn. This is kept so that the level only changes once the size is clearly past a boundary.
+	/// </summary>
+	uint32_t currentLevel;
+
+	/// <summary>
+	/// The colour the mesh is drawn with.
+	/// </summary>
+	glm::vec3 color;
+
+	/// <summary>
+	/// The material the mesh is drawn with.
+	/// </summary>
+	std::shared_ptr<Material> material;
+
+	/// <summary>
+	/// Where this renderer is in its instance batch, if it's drawn instanced.
+	/// </summary>
+	InstanceHandle instance;
+};
@@ -0,0 +1,156 @@
+#include "OffscreenContext.h"
+
+#if defined(GO_CLONE_HEADLESS_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#elif defined(GO_CLONE_HEADLESS_OSMESA)
+#include <GL/osmesa.h>
+#endif
+
+#include "Log.h"
+
+#if defined(GO_CLONE_HEADLESS_EGL)
+OffscreenContext::OffscreenContext(uint32_t width, uint32_t height) : width(width), height(height) {
+	valid = false;
+	display = EGL_NO_DISPLAY;
+	surface = EGL_NO_SURFACE;
+	context = EGL_NO_CONTEXT;
+
+	// Mesa's surfaceless platform doesn't need a display server. If it isn't there, the default display is the next best thing.
+	EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+	if (getPlatformDisplay != nullptr) {
+		eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+	}
+#endif
+	if (eglDisplay == EGL_NO_DISPLAY) {
+		eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+	if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, nullptr, nullptr)) {
+		LOG_ERROR("Couldn't open an EGL display.");
+		return;
+	}
+	display = eglDisplay;
+
+	const EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_ALPHA_SIZE, 8,
+		EGL_DEPTH_SIZE, 24,
+		EGL_NONE
+	};
+	EGLConfig config;
+	EGLint configCount = 0;
+	if (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) || configCount == 0) {
+		LOG_ERROR("Couldn't find an EGL config that can render offscreen.");
+		return;
+	}
+
+	const EGLint surfaceAttributes[] = {
+		EGL_WIDTH, static_cast<EGLint>(width),
+		EGL_HEIGHT, static_cast<EGLint>(height),
+		EGL_NONE
+	};
+	surface = eglCreatePbufferSurface(eglDisplay, config, surfaceAttributes);
+	eglBindAPI(EGL_OPENGL_API);
+	context = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, nullptr);
+	if (surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT) {
+		LOG_ERROR("Couldn't create an EGL pbuffer context.");
+		return;
+	}
+	valid = SetActive();
+}
+
+OffscreenContext::~OffscreenContext() {
+	if (display == EGL_NO_DISPLAY) {
+		return;
+	}
+	eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (context != EGL_NO_CONTEXT) {
+		eglDestroyContext(display, context);
+	}
+	if (surface != EGL_NO_SURFACE) {
+		eglDestroySurface(display, surface);
+	}
+	eglTerminate(display);
+}
+
+bool OffscreenContext::SetActive() {
+	return eglMakeCurrent(display, surface, surface, context) == EGL_TRUE;
+}
+
+std::string OffscreenContext::GetBackendName() {
+	return "EGL";
+}
+
+const void* OffscreenContext::GetFunction(const char* name) {
+	return reinterpret_cast<const void*>(eglGetProcAddress(name));
+}
+#elif defined(GO_CLONE_HEADLESS_OSMESA)
+OffscreenContext::OffscreenContext(uint32_t width, uint32_t height) : width(width), height(height), buffer(width * height * 4) {
+	context = OSMesaCreateContextExt(OSMESA_RGBA, 24, 0, 0, nullptr);
+	if (context == nullptr) {
+		LOG_ERROR("Couldn't create an OSMesa context.");
+		valid = false;
+		return;
+	}
+	valid = SetActive();
+}
+
+OffscreenContext::~OffscreenContext() {
+	if (context != nullptr) {
+		OSMesaDestroyContext(static_cast<OSMesaContext>(context));
+	}
+}
+
+bool OffscreenContext::SetActive() {
+	return OSMesaMakeCurrent(static_cast<OSMesaContext>(context), buffer.data(), GL_UNSIGNED_BYTE, width, height) == GL_TRUE;
+}
+
+std::string OffscreenContext::GetBackendName() {
+	return "OSMesa";
+}
+
+const void* OffscreenContext::GetFunction(const char* name) {
+	return reinterpret_cast<const void*>(OSMesaGetProcAddress(name));
+}
+#else
+OffscreenContext::OffscreenContext(uint32_t width, uint32_t height) : width(width), height(height) {
+	sf::ContextSettings settings;
+	settings.depthBits = 24;
+	context = new sf::Context(settings, width, height);
+	valid = SetActive();
+}
+
+OffscreenContext::~OffscreenContext() {
+	delete context;
+}
+
+bool OffscreenContext::SetActive() {
+	return context->setActive(true);
+}
+
+std::string OffscreenContext::GetBackendName() {
+	return "SFML";
+}
+
+const void* OffscreenContext::GetFunction(const char* name) {
+	return reinterpret_cast<const void*>(sf::Context::getFunction(name));
+}
+#endif
+
+bool OffscreenContext::IsValid() const {
+	return valid;
+}
+
+uint32_t OffscreenContext::GetWidth() const {
+	return width;
+}
+
+uint32_t OffscreenContext::GetHeight() const {
+	return height;
+}
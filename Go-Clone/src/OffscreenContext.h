@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SFML/Window/Context.hpp>
+
+/// <summary>
+/// An OpenGL context that renders into an offscreen buffer instead of a window, so the game can run on machines without a display.
+/// Which backend is used is picked when building:
+/// GO_CLONE_HEADLESS_EGL uses an EGL pbuffer (on Mesa this works with no display server at all),
+/// GO_CLONE_HEADLESS_OSMESA uses Mesa's off-screen software renderer,
+/// and anything else falls back to an SFML context, which still needs a display on some platforms.
+/// </summary>
+class OffscreenContext {
+	public:
+	/// <summary>
+	/// Creates the context and makes it current.
+	/// </summary>
+	/// <param name="width">The width of the buffer.</param>
+	/// <param name="height">The height of the buffer.</param>
+	OffscreenContext(uint32_t width, uint32_t height);
+	~OffscreenContext();
+
+	OffscreenContext(const OffscreenContext&) = delete;
+	OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+	/// <summary>
+	/// Returns whether the context was created successfully.
+	/// </summary>
+	/// <returns>Whether the context was created successfully.</returns>
+	bool IsValid() const;
+
+	/// <summary>
+	/// Makes this the current context on the calling thread.
+	/// </summary>
+	/// <returns>Whether it worked.</returns>
+	bool SetActive();
+
+	/// <summary>
+	/// Returns the width of the buffer.
+	/// </summary>
+	/// <returns>The width of the buffer.</returns>
+	uint32_t GetWidth() const;
+
+	/// <summary>
+	/// Returns the height of the buffer.
+	/// </summary>
+	/// <returns>The height of the buffer.</returns>
+	uint32_t GetHeight() const;
+
+	/// <summary>
+	/// Returns the name of the backend that was built in, for reporting.
+	/// </summary>
+	/// <returns>The name of the backend.</returns>
+	static std::string GetBackendName();
+
+	/// <summary>
+	/// Looks up an OpenGL function through the backend. This can be given to GLExtensions::Load().
+	/// </summary>
+	/// <param name="name">The name of the function.</param>
+	/// <returns>The function, or nullptr if it doesn't exist.</returns>
+	static const void* GetFunction(const char* name);
+
+	private:
+	/// <summary>
+	/// The width of the buffer.
+	/// </summary>
+	uint32_t width;
+
+	/// <summary>
+	/// The height of the buffer.
+	/// </summary>
+	uint32_t height;
+
+	/// <summary>
+	/// Whether the context was created successfully.
+	/// </summary>
+	bool valid;
+
+#if defined(GO_CLONE_HEADLESS_EGL)
+	// These are the EGL handles. They're kept as void* so that the EGL headers don't leak out of this class.
+	void* display;
+	void* surface;
+	void* context;
+#elif defined(GO_CLONE_HEADLESS_OSMESA)
+	/// <summary>
+	/// The OSMesa context.
+	/// </summary>
+	void* context;
+
+	/// <summary>
+	/// The colour buffer OSMesa renders into.
+	/// </summary>
+	std::vector<uint8_t> buffer;
+#else
+	/// <summary>
+	/// The SFML context.
+	/// </summary>
+	sf::Context* context;
+#endif
+};
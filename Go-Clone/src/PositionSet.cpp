@@ -0,0 +1,91 @@
+#include "PositionSet.h"
+
+#include <algorithm>
+
+PositionSet::PositionSet(size_t capacity) {
+	size_t rounded = 16;
+	while (rounded < capacity) {
+		rounded *= 2;
+	}
+	slots.assign(rounded, 0);
+	size = 0;
+}
+
+PositionSet::~PositionSet() {
+}
+
+bool PositionSet::Insert(uint64_t hash) {
+	if ((size + 1) * 2 > slots.size()) {
+		Grow();
+	}
+	uint64_t stored = Stored(hash);
+	size_t mask = slots.size() - 1;
+	// The hashes are already random, so the low bits pick the slot as well as anything would.
+	for (size_t slot = static_cast<size_t>(stored) & mask;; slot = (slot + 1) & mask) {
+		if (slots[slot] == stored) {
+			return false;
+		}
+		if (slots[slot] == 0) {
+			slots[slot] = stored;
+			++size;
+			return true;
+		}
+	}
+}
+
+bool PositionSet::Erase(uint64_t hash) {
+	uint64_t stored = Stored(hash);
+	size_t mask = slots.size() - 1;
+	size_t gap = static_cast<size_t>(stored) & mask;
+	while (slots[gap] != stored) {
+		if (slots[gap] == 0) {
+			return false;
+		}
+		gap = (gap + 1) & mask;
+	}
+	// A hash further on can fill the gap if the gap is no further from its home slot than where it is now, so it's still found.
+	for (size_t slot = (gap + 1) & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+		size_t home = static_cast<size_t>(slots[slot]) & mask;
+		if (((slot - home) & mask) >= ((slot - gap) & mask)) {
+			slots[gap] = slots[slot];
+			gap = slot;
+		}
+	}
+	slots[gap] = 0;
+	--size;
+	return true;
+}
+
+bool PositionSet::Contains(uint64_t hash) const {
+	uint64_t stored = Stored(hash);
+	size_t mask = slots.size() - 1;
+	for (size_t slot = static_cast<size_t>(stored) & mask;; slot = (slot + 1) & mask) {
+		if (slots[slot] == stored) {
+			return true;
+		}
+		if (slots[slot] == 0) {
+			return false;
+		}
+	}
+}
+
+void PositionSet::Clear() {
+	std::fill(slots.begin(), slots.end(), 0);
+	size = 0;
+}
+
+size_t PositionSet::GetSize() const {
+	return size;
+}
+
+void PositionSet::Grow() {
+	std::vector<uint64_t> old;
+	old.swap(slots);
+	slots.assign(old.size() * 2, 0);
+	size = 0;
+	for (uint64_t stored : old) {
+		if (stored != 0) {
+			Insert(stored);
+		}
+	}
+}
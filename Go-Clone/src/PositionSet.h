@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// A set of position hashes, for telling whether a position has come up before. The hashes are kept in one flat array and looked
+/// up by linear probing from a slot picked by the hash itself, so checking a position is usually a single cache miss. The array
+/// doubles once it's half full.
+/// </summary>
+class PositionSet {
+	public:
+	/// <summary>
+	/// Makes an empty set.
+	/// </summary>
+	/// <param name="capacity">How many slots to start with. This is rounded up to a power of two.</param>
+	PositionSet(size_t capacity = 1024);
+	~PositionSet();
+
+	/// <summary>
+	/// Adds a hash.
+	/// </summary>
+	/// <param name="hash">The hash of the position.</param>
+	/// <returns>Whether it was added, which is false if it was already there.</returns>
+	bool Insert(uint64_t hash);
+
+	/// <summary>
+	/// Takes a hash out. The hashes after it in its run are shifted back over the gap, rather than leaving a marker, so lookups stay
+	/// as short as if it had never been added.
+	/// </summary>
+	/// <param name="hash">The hash of the position.</param>
+	/// <returns>Whether it was taken out, which is false if it wasn't there.</returns>
+	bool Erase(uint64_t hash);
+
+	/// <summary>
+	/// Returns whether a hash has been added.
+	/// </summary>
+	/// <param name="hash">The hash of the position.</param>
+	/// <returns>Whether the hash is in the set.</returns>
+	bool Contains(uint64_t hash) const;
+
+	/// <summary>
+	/// Takes every hash out, keeping the memory.
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Returns how many hashes are in the set.
+	/// </summary>
+	/// <returns>The number of hashes.</returns>
+	size_t GetSize() const;
+
+	private:
+	/// <summary>
+	/// Empty slots hold 0, so a hash of 0 is stored as this instead.
+	/// </summary>
+	static uint64_t Stored(uint64_t hash) {
+		return hash != 0 ? hash : 1;
+	}
+
+	void Grow();
+
+	std::vector<uint64_t> slots;
+	size_t size;
+};
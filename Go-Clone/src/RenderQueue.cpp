@@ -0,0 +1,155 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+
+#include <glm/geometric.hpp>
+
+/// <summary>
+/// The furthest depth that still gets its own key. Anything further away is treated as being this far.
+/// </summary>
+static const float maxSortDepth = 500.0f;
+
+RenderQueue::RenderQueue() {
+	view = glm::mat4(1.0f);
+	projectionScale = 1.0f;
+	perspective = false;
+	frustumPlanes.fill(glm::vec4(0.0f));
+}
+
+RenderQueue::~RenderQueue() {
+}
+
+void RenderQueue::Clear(const glm::mat4& newView, const glm::mat4& projection) {
+	commands.clear();
+	entries.clear();
+	texts.clear();
+	view = newView;
+	projectionScale = projection[1][1];
+	perspective = projection[2][3] != 0.0f;
+
+	// Each plane is the last row of the view projection matrix plus or minus one of the others.
+	glm::mat4 viewProjection = projection * view;
+	glm::vec4 rows[4];
+	for (int row = 0; row < 4; ++row) {
+		rows[row] = glm::vec4(viewProjection[0][row], viewProjection[1][row], viewProjection[2][row], viewProjection[3][row]);
+	}
+	for (int axis = 0; axis < 3; ++axis) {
+		frustumPlanes[axis * 2] = rows[3] + rows[axis];
+		frustumPlanes[axis * 2 + 1] = rows[3] - rows[axis];
+	}
+	for (glm::vec4& plane : frustumPlanes) {
+		plane /= glm::length(glm::vec3(plane));
+	}
+}
+
+void RenderQueue::Push(const DrawCommand& command) {
+	entries.push_back(SortEntry{command.sortKey, static_cast<uint32_t>(commands.size())});
+	commands.push_back(command);
+}
+
+void RenderQueue::PushText(const TextCommand& command) {
+	texts.push_back(command);
+}
+
+float RenderQueue::GetScreenSize(const glm::vec3& center, float radius) const {
+	// The view is 2 units tall in clip space, which cancels out with the sphere's diameter.
+	if (!perspective) {
+		return radius * projectionScale;
+	}
+	float depth = -(view[0][2] * center.x + view[1][2] * center.y + view[2][2] * center.z + view[3][2]);
+	if (depth <= radius) {
+		// The camera is inside or right up against the sphere, so it fills the view.
+		return 1.0f;
+	}
+	return radius * projectionScale / depth;
+}
+
+uint64_t RenderQueue::MakeKey(ELayer layer, uint32_t materialID, uint32_t meshID, const glm::mat4& model) const {
+	// The camera looks down -Z, so the depth is how far along that the object's origin is.
+	float depth = -(view[0][2] * model[3][0] + view[1][2] * model[3][1] + view[2][2] * model[3][2] + view[3][2]);
+	depth = std::min(std::max(depth, 0.0f), maxSortDepth);
+	uint64_t depthBits = static_cast<uint64_t>(depth / maxSortDepth * 0xFFFFFF);
+	if (layer == ETransparent) {
+		depthBits = 0xFFFFFF - depthBits;
+	} else if (layer == ECustom) {
+		// Custom commands may rely on being drawn in scene graph order, which the stable sort keeps as long as the keys match.
+		depthBits = 0;
+	}
+
+	// [63:56] layer, [55:40] material, [39:24] mesh, [23:0] depth. Mesh and material IDs are reused, so they only overflow 16 bits
+	// with more than 65535 alive at once.
+	return (static_cast<uint64_t>(layer) << 56)
+		| (static_cast<uint64_t>(materialID & 0xFFFF) << 40)
+		| (static_cast<uint64_t>(meshID & 0xFFFF) << 24)
+		| depthBits;
+}
+
+void RenderQueue::Sort() {
+	// This is a least significant digit radix sort, a byte at a time. It's stable, so equal keys stay in push order.
+	// Every byte's histogram is counted in one go, so the entries are only read once before the scatter passes.
+	const int digitCount = 8;
+	std::array<std::array<uint32_t, 256>, digitCount> counts = {};
+	for (const SortEntry& entry : entries) {
+		for (int digit = 0; digit < digitCount; ++digit) {
+			++counts[digit][(entry.key >> (digit * 8)) & 0xFF];
+		}
+	}
+
+	scratch.resize(entries.size());
+	for (int digit = 0; digit < digitCount; ++digit) {
+		std::array<uint32_t, 256>& digitCounts = counts[digit];
+		// If every key has the same byte here, this pass wouldn't move anything.
+		if (entries.empty() || digitCounts[(entries[0].key >> (digit * 8)) & 0xFF] == entries.size()) {
+			continue;
+		}
+		uint32_t total = 0;
+		for (uint32_t& count : digitCounts) {
+			uint32_t current = count;
+			count = total;
+			total += current;
+		}
+		for (const SortEntry& entry : entries) {
+			scratch[digitCounts[(entry.key >> (digit * 8)) & 0xFF]++] = entry;
+		}
+		entries.swap(scratch);
+	}
+}
+
+size_t RenderQueue::GetSize() const {
+	return commands.size();
+}
+
+size_t RenderQueue::GetTextCount() const {
+	return texts.size();
+}
+
+const TextCommand& RenderQueue::GetText(size_t index) const {
+	return texts[index];
+}
+
+void RenderQueue::Append(const RenderQueue& other) {
+	uint32_t offset = static_cast<uint32_t>(commands.size());
+	commands.insert(commands.end(), other.commands.begin(), other.commands.end());
+	for (const SortEntry& entry : other.entries) {
+		entries.push_back(SortEntry{entry.key, entry.index + offset});
+	}
+	texts.insert(texts.end(), other.texts.begin(), other.texts.end());
+}
+
+bool RenderQueue::IsVisible(const glm::vec3& center, float radius) const {
+	for (const glm::vec4& plane : frustumPlanes) {
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+const DrawCommand& RenderQueue::GetSorted(size_t index) const {
+	return commands[entries[index].index];
+}
+
+const glm::mat4& RenderQueue::GetView() const {
+	return view;
+}
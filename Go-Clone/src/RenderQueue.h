@@ -0,0 +1,238 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+/// <summary>
+/// A single thing to draw, collected while walking the scene graph and executed once everything has been sorted.
+/// Commands only hold raw pointers, since everything they point at is kept alive by the scene for the rest of the frame.
+/// </summary>
+struct DrawCommand {
+	/// <summary>
+	/// Decides the order commands are drawn in. Use RenderQueue::MakeKey() to build this.
+	/// </summary>
+	uint64_t sortKey;
+
+	/// <summary>
+	/// The mesh to draw, or nullptr if the renderable draws itself.
+	/// </summary>
+	class Mesh* mesh;
+
+	/// <summary>
+	/// The material to draw the mesh with. This can be nullptr for fixed function.
+	/// </summary>
+	class Material* material;
+
+	/// <summary>
+	/// Where the command's instance lives if it gets drawn instanced. This can be nullptr if it never should be.
+	/// </summary>
+	struct InstanceHandle* instance;
+
+	/// <summary>
+	/// The renderable to call Render() on if there isn't a mesh.
+	/// </summary>
+	class Renderable* renderable;
+
+	/// <summary>
+	/// The world matrix to draw with.
+	/// </summary>
+	glm::mat4 model;
+
+	/// <summary>
+	/// The colour to draw with.
+	/// </summary>
+	glm::vec4 color;
+};
+
+/// <summary>
+/// A string to draw, collected alongside the draw commands. All of a frame's text is drawn together after everything else.
+/// </summary>
+struct TextCommand {
+	/// <summary>
+	/// The text. Like the draw commands, this points at something the scene keeps alive for the rest of the frame.
+	/// </summary>
+	const std::string* text;
+
+	/// <summary>
+	/// Where the text goes. The text lies in the matrix's XY plane, centred on its origin, facing +Z.
+	/// </summary>
+	glm::mat4 model;
+
+	/// <summary>
+	/// The colour of the text.
+	/// </summary>
+	glm::vec4 color;
+
+	/// <summary>
+	/// The size of the font (the height of an em), in the matrix's units.
+	/// </summary>
+	float size;
+
+	/// <summary>
+	/// Whether the text turns to face the camera instead of following the matrix's rotation. Billboards ignore the matrix's scale too, so their size is in world units.
+	/// </summary>
+	bool billboard;
+};
+
+/// <summary>
+/// Collects the draw commands for a frame, then sorts them so that commands sharing state end up next to each other.
+/// The storage is kept between frames, so a steady scene doesn't allocate.
+/// </summary>
+class RenderQueue {
+	public:
+	/// <summary>
+	/// The broad groups commands are drawn in, from first to last.
+	/// </summary>
+	enum ELayer {
+		EOpaque = 0,
+		ECustom = 1,
+		ETransparent = 2
+	};
+
+	RenderQueue();
+	~RenderQueue();
+
+	/// <summary>
+	/// Empties the queue for a new frame, keeping its storage.
+	/// </summary>
+	/// <param name="newView">The view matrix of the camera, used to work out depths.</param>
+	/// <param name="projection">The projection matrix of the camera, used to work out what's visible.</param>
+	void Clear(const glm::mat4& newView, const glm::mat4& projection);
+
+	/// <summary>
+	/// Adds a command to the queue.
+	/// </summary>
+	/// <param name="command">The command to add.</param>
+	void Push(const DrawCommand& command);
+
+	/// <summary>
+	/// Adds a string to the queue.
+	/// </summary>
+	/// <param name="command">The string to add.</param>
+	void PushText(const TextCommand& command);
+
+	/// <summary>
+	/// Adds every command from another queue to the end of this one. Used to merge queues that were filled on other threads.
+	/// </summary>
+	/// <param name="other">The queue to take commands from.</param>
+	void Append(const RenderQueue& other);
+
+	/// <summary>
+	/// Returns whether a sphere is at least partly inside the camera's view, so that anything outside it can be skipped.
+	/// </summary>
+	/// <param name="center">The centre of the sphere in world space.</param>
+	/// <param name="radius">The radius of the sphere.</param>
+	/// <returns>Whether the sphere might be visible.</returns>
+	bool IsVisible(const glm::vec3& center, float radius) const;
+
+	/// <summary>
+	/// Returns how big a sphere looks on screen, which is what levels of detail are picked by.
+	/// </summary>
+	/// <param name="center">The centre of the sphere in world space.</param>
+	/// <param name="radius">The radius of the sphere.</param>
+	/// <returns>The height of the sphere on screen, as a fraction of the height of the view.</returns>
+	float GetScreenSize(const glm::vec3& center, float radius) const;
+
+	/// <summary>
+	/// Builds a sort key. From most to least important, commands are ordered by layer, material, mesh and then depth.
+	/// Opaque commands go front to back and transparent ones back to front. Custom commands ignore depth and stay in push order.
+	/// </summary>
+	/// <param name="layer">The layer the command is drawn in.</param>
+	/// <param name="materialID">The ID of the material (or 0).</param>
+	/// <param name="meshID">The ID of the mesh (or 0).</param>
+	/// <param name="model">The world matrix of the command, used to work out its depth.</param>
+	/// <returns>The sort key.</returns>
+	uint64_t MakeKey(ELayer layer, uint32_t materialID, uint32_t meshID, const glm::mat4& model) const;
+
+	/// <summary>
+	/// Sorts the commands by their keys. Commands with equal keys keep the order they were pushed in.
+	/// </summary>
+	void Sort();
+
+	/// <summary>
+	/// Returns the number of commands in the queue.
+	/// </summary>
+	/// <returns>The number of commands in the queue.</returns>
+	size_t GetSize() const;
+
+	/// <summary>
+	/// Returns the command at the given position in sorted order. Sort() should be called first.
+	/// </summary>
+	/// <param name="index">The position in sorted order.</param>
+	/// <returns>The command.</returns>
+	const DrawCommand& GetSorted(size_t index) const;
+
+	/// <summary>
+	/// Returns the number of strings in the queue.
+	/// </summary>
+	/// <returns>The number of strings in the queue.</returns>
+	size_t GetTextCount() const;
+
+	/// <summary>
+	/// Returns a string in the order it was pushed.
+	/// </summary>
+	/// <param name="index">The position of the string.</param>
+	/// <returns>The string.</returns>
+	const TextCommand& GetText(size_t index) const;
+
+	/// <summary>
+	/// Returns the view matrix the queue was cleared with.
+	/// </summary>
+	/// <returns>The view matrix.</returns>
+	const glm::mat4& GetView() const;
+
+	private:
+	/// <summary>
+	/// A key and the command it came from. These are what actually get sorted, since they're much smaller than the commands.
+	/// </summary>
+	struct SortEntry {
+		uint64_t key;
+		uint32_t index;
+	};
+
+	/// <summary>
+	/// The commands in the order they were pushed.
+	/// </summary>
+	std::vector<DrawCommand> commands;
+
+	/// <summary>
+	/// The strings in the order they were pushed. Text isn't sorted, since it's all drawn at once anyway.
+	/// </summary>
+	std::vector<TextCommand> texts;
+
+	/// <summary>
+	/// The keys of the commands, sorted by Sort().
+	/// </summary>
+	std::vector<SortEntry> entries;
+
+	/// <summary>
+	/// Scratch space for the radix sort.
+	/// </summary>
+	std::vector<SortEntry> scratch;
+
+	/// <summary>
+	/// The view matrix of the camera.
+	/// </summary>
+	glm::mat4 view;
+
+	/// <summary>
+	/// How much the projection scales heights by, before dividing by depth.
+	/// </summary>
+	float projectionScale;
+
+	/// <summary>
+	/// Whether the projection divides by depth (so things get smaller further away).
+	/// </summary>
+	bool perspective;
+
+	/// <summary>
+	/// The planes of the camera's view, in world space. Each is a normal pointing inwards and a distance.
+	/// </summary>
+	std::array<glm::vec4, 6> frustumPlanes;
+};
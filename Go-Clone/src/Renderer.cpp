@@ -0,0 +1,330 @@
+#include "Renderer.h"
+
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/matrix.hpp>
+#include <SFML/OpenGL.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include "ComponentTypes.h"
+#include "GameObject.h"
+#include "GLExtensions.h"
+
+/// <summary>
+/// How many subtrees to aim for per thread. Having more than one each evens out subtrees of different sizes.
+/// </summary>
+static const size_t subtreesPerThread = 4;
+
+Renderer::Renderer() : workers(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0) {
+	view = glm::mat4(1.0f);
+	projection = glm::mat4(1.0f);
+	drawCalls = 0;
+	lastDrawCalls = 0;
+	triangles = 0;
+	lastTriangles = 0;
+	lights = LightUniforms();
+	frameUniformBuffer = 0;
+	lightUniformBuffer = 0;
+}
+
+Renderer::~Renderer() {
+}
+
+void Renderer::BeginFrame(const glm::mat4& newView, const glm::mat4& newProjection) {
+	view = newView;
+	projection = newProjection;
+	queue.Clear(view, projection);
+	drawCalls = 0;
+	triangles = 0;
+	lights.count.x = 0;
+}
+
+void Renderer::SetAmbientLight(const glm::vec3& color) {
+	lights.ambient = glm::vec4(color, 1.0f);
+}
+
+bool Renderer::AddLight(const glm::vec3& direction, const glm::vec3& color) {
+	if (lights.count.x >= LightUniforms::maxLights) {
+		return false;
+	}
+	lights.directions[lights.count.x] = glm::vec4(glm::normalize(direction), 0.0f);
+	lights.colors[lights.count.x] = glm::vec4(color, 1.0f);
+	++lights.count.x;
+	return true;
+}
+
+void Renderer::CollectDrawCommands(std::shared_ptr<GameObject> root) {
+	sf::Clock clock;
+	if (workers.GetThreadCount() == 1) {
+		root->CollectDrawCommands(queue, glm::mat4(1.0f));
+		traversalTime = clock.getElapsedTime();
+		return;
+	}
+
+	// The top of the graph is walked breadth first on this thread until there are enough subtrees to go around.
+	subtrees.clear();
+	subtrees.push_back(Subtree{root, glm::mat4(1.0f)});
+	size_t target = workers.GetThreadCount() * subtreesPerThread;
+	size_t first = 0;
+	while (first < subtrees.size() && subtrees.size() - first < target) {
+		Subtree subtree = subtrees[first++];
+		glm::mat4 worldMatrix = subtree.object->GetWorldMatrix(subtree.parentMatrix);
+		subtree.object->SubmitDrawCommands(queue, worldMatrix);
+		for (std::shared_ptr<GameObject> child : subtree.object->GetChildren()) {
+			subtrees.push_back(Subtree{child, worldMatrix});
+		}
+	}
+
+	size_t jobCount = subtrees.size() - first;
+	if (subtreeQueues.size() < jobCount) {
+		subtreeQueues.resize(jobCount);
+	}
+	for (size_t i = 0; i < jobCount; ++i) {
+		subtreeQueues[i].Clear(view, projection);
+	}
+	workers.Run(jobCount, [this, first](size_t job) {
+		const Subtree& subtree = subtrees[first + job];
+		subtree.object->CollectDrawCommands(subtreeQueues[job], subtree.parentMatrix);
+	});
+	for (size_t i = 0; i < jobCount; ++i) {
+		queue.Append(subtreeQueues[i]);
+	}
+	traversalTime = clock.getElapsedTime();
+}
+
+RenderQueue& Renderer::GetQueue() {
+	return queue;
+}
+
+GLStateCache& Renderer::GetState() {
+	return state;
+}
+
+TextRenderer& Renderer::GetText() {
+	return text;
+}
+
+void Renderer::EndFrame() {
+	sf::Clock clock;
+	queue.Sort();
+
+	// Custom renderables still read the camera from the matrix stack, whichever way the meshes are drawn.
+	state.Projection(projection);
+	if (GLExtensions::HasShaderPipeline()) {
+		UploadUniforms();
+	} else {
+		SetFixedFunctionLights();
+	}
+
+	size_t count = queue.GetSize();
+	size_t begin = 0;
+	while (begin < count) {
+		const DrawCommand& command = queue.GetSorted(begin);
+		if (command.mesh == nullptr) {
+			state.UseProgram(0);
+			glLoadMatrixf(glm::value_ptr(view * command.model));
+			command.renderable->Render();
+			// There's no telling what a custom renderable changed.
+			state.Invalidate();
+			++begin;
+			continue;
+		}
+
+		// Sorting put everything with the same mesh and material next to each other.
+		size_t end = begin + 1;
+		while (end < count && queue.GetSorted(end).mesh == command.mesh && queue.GetSorted(end).material == command.material) {
+			++end;
+		}
+		if (command.material != nullptr && command.instance != nullptr && command.material->CanInstance()) {
+			DrawInstanced(begin, end);
+		} else {
+			DrawIndividually(begin, end);
+		}
+		begin = end;
+	}
+
+	// Text goes last, so it can blend over everything it's in front of.
+	if (text.Draw(queue, view, projection, state)) {
+		++drawCalls;
+	}
+
+	state.UseProgram(0);
+
+	// Batches that nobody uses any more are dropped so they don't keep their mesh alive.
+	for (auto it = batches.begin(); it != batches.end();) {
+		if (it->second->GetSlotCount() == 0) {
+			it = batches.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	lastDrawCalls = drawCalls;
+	lastTriangles = triangles;
+	state.NewFrame();
+	drawTime = clock.getElapsedTime();
+}
+
+std::shared_ptr<InstanceBatch> Renderer::GetBatch(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material) {
+	auto key = std::make_pair(mesh.get(), material.get());
+	auto it = batches.find(key);
+	if (it != batches.end()) {
+		return it->second;
+	}
+	auto batch = std::make_shared<InstanceBatch>(mesh, material);
+	batches.insert(std::make_pair(key, batch));
+	return batch;
+}
+
+void Renderer::CountDrawCall() {
+	++drawCalls;
+}
+
+size_t Renderer::GetDrawCalls() const {
+	return lastDrawCalls;
+}
+
+size_t Renderer::GetTriangleCount() const {
+	return lastTriangles;
+}
+
+sf::Time Renderer::GetTraversalTime() const {
+	return traversalTime;
+}
+
+sf::Time Renderer::GetDrawTime() const {
+	return drawTime;
+}
+
+void Renderer::Clear() {
+	batches.clear();
+	text.Clear();
+	ShaderLibrary::Clear();
+	if (frameUniformBuffer != 0) {
+		GLExtensions::DeleteBuffers(1, &frameUniformBuffer);
+		frameUniformBuffer = 0;
+	}
+	if (lightUniformBuffer != 0) {
+		GLExtensions::DeleteBuffers(1, &lightUniformBuffer);
+		lightUniformBuffer = 0;
+	}
+}
+
+void Renderer::Restore() {
+	// The uniform buffers are remade on the next frame.
+	frameUniformBuffer = 0;
+	lightUniformBuffer = 0;
+	state.Invalidate();
+}
+
+void Renderer::UploadUniforms() {
+	FrameUniforms frame;
+	frame.view = view;
+	frame.projection = projection;
+	frame.cameraPosition = glm::inverse(view)[3];
+
+	// Both blocks are small enough that replacing them whole every frame is cheaper than working out what changed.
+	if (frameUniformBuffer == 0) {
+		GLExtensions::GenBuffers(1, &frameUniformBuffer);
+		GLExtensions::BindBuffer(GL_UNIFORM_BUFFER, frameUniformBuffer);
+		GLExtensions::BufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), &frame, GL_DYNAMIC_DRAW);
+	} else {
+		GLExtensions::BindBuffer(GL_UNIFORM_BUFFER, frameUniformBuffer);
+		GLExtensions::BufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+	}
+	if (lightUniformBuffer == 0) {
+		GLExtensions::GenBuffers(1, &lightUniformBuffer);
+		GLExtensions::BindBuffer(GL_UNIFORM_BUFFER, lightUniformBuffer);
+		GLExtensions::BufferData(GL_UNIFORM_BUFFER, sizeof(LightUniforms), &lights, GL_DYNAMIC_DRAW);
+	} else {
+		GLExtensions::BindBuffer(GL_UNIFORM_BUFFER, lightUniformBuffer);
+		GLExtensions::BufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightUniforms), &lights);
+	}
+	GLExtensions::BindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	GLExtensions::BindBufferBase(GL_UNIFORM_BUFFER, Shader::EFrameBlock, frameUniformBuffer);
+	GLExtensions::BindBufferBase(GL_UNIFORM_BUFFER, Shader::ELightBlock, lightUniformBuffer);
+}
+
+void Renderer::SetFixedFunctionLights() {
+	state.Enable(GL_LIGHTING);
+	state.Enable(GL_COLOR_MATERIAL);
+	state.Enable(GL_NORMALIZE);
+	glLightModelfv(GL_LIGHT_MODEL_AMBIENT, glm::value_ptr(lights.ambient));
+
+	if (lights.count.x == 0) {
+		state.Disable(GL_LIGHT0);
+		return;
+	}
+	state.Enable(GL_LIGHT0);
+	// Light positions are transformed by the modelview when they're set, so the camera has to be loaded first.
+	// A w of 0 makes it directional, pointing back towards where the light comes from.
+	glLoadMatrixf(glm::value_ptr(view));
+	glm::vec4 towardsLight = -lights.directions[0];
+	glLightfv(GL_LIGHT0, GL_POSITION, glm::value_ptr(towardsLight));
+	glLightfv(GL_LIGHT0, GL_DIFFUSE, glm::value_ptr(lights.colors[0]));
+	static const GLfloat noAmbient[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+	glLightfv(GL_LIGHT0, GL_AMBIENT, noAmbient);
+}
+
+void Renderer::DrawInstanced(size_t begin, size_t end) {
+	const DrawCommand& first = queue.GetSorted(begin);
+	std::shared_ptr<InstanceBatch> batch = GetBatch(first.mesh->shared_from_this(), first.material->shared_from_this());
+	for (size_t i = begin; i < end; ++i) {
+		const DrawCommand& command = queue.GetSorted(i);
+		InstanceHandle& instance = *command.instance;
+		// Renderers only get a slot the first time they're drawn instanced, or after their mesh or material changes.
+		if (instance.batch != batch) {
+			instance.Release();
+			instance.batch = batch;
+			instance.slot = batch->AcquireSlot();
+		}
+		batch->Submit(instance.slot, command.model, command.color);
+	}
+
+	state.Enable(GL_DEPTH_TEST);
+	state.Enable(GL_CULL_FACE);
+	state.CullFace(GL_BACK);
+	state.PolygonMode(GL_FRONT, GL_FILL);
+
+	if (batch->Draw(state)) {
+		++drawCalls;
+		triangles += (end - begin) * first.mesh->GetIndexCount() / 3;
+	}
+}
+
+void Renderer::DrawIndividually(size_t begin, size_t end) {
+	state.Enable(GL_DEPTH_TEST);
+	state.Enable(GL_CULL_FACE);
+	state.CullFace(GL_BACK);
+	state.PolygonMode(GL_FRONT, GL_FILL);
+
+	const DrawCommand& first = queue.GetSorted(begin);
+	bool useShader = false;
+	if (GLExtensions::HasShaderPipeline()) {
+		std::shared_ptr<Shader> shader = first.material != nullptr && first.material->GetShader() != nullptr ? first.material->GetShader() : ShaderLibrary::Get(ShaderLibrary::ELit);
+		useShader = shader->Bind(state);
+	}
+	if (!useShader) {
+		state.UseProgram(0);
+	}
+
+	Mesh* mesh = first.mesh;
+	mesh->Bind();
+	for (size_t i = begin; i < end; ++i) {
+		const DrawCommand& command = queue.GetSorted(i);
+		if (useShader) {
+			// With the instance arrays turned off, every vertex reads the same constant values instead.
+			for (GLuint column = 0; column < 4; ++column) {
+				GLExtensions::VertexAttrib4fv(Shader::EInstanceModel + column, glm::value_ptr(command.model[column]));
+			}
+			GLExtensions::VertexAttrib4fv(Shader::EInstanceColor, glm::value_ptr(command.color));
+		} else {
+			glLoadMatrixf(glm::value_ptr(view * command.model));
+			state.Color(command.color);
+		}
+		mesh->DrawElements(1);
+		++drawCalls;
+		triangles += mesh->GetIndexCount() / 3;
+	}
+	mesh->Unbind();
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <SFML/System/Time.hpp>
+
+#include "GLStateCache.h"
+#include "GPUResource.h"
+#include "InstanceBatch.h"
+#include "RenderQueue.h"
+#include "ShaderLibrary.h"
+#include "TextRenderer.h"
+#include "WorkerPool.h"
+
+class GameObject;
+
+/// <summary>
+/// Owns the per-frame rendering state of the engine. The scene graph is walked into a queue of draw commands first, then the queue
+/// is sorted and drawn in one pass, so that commands sharing a mesh and material are drawn together (instanced where possible).
+/// </summary>
+class Renderer : public GPUResource {
+	public:
+	Renderer();
+	~Renderer();
+
+	/// <summary>
+	/// Starts a new frame with the given camera. This empties the queue.
+	/// </summary>
+	/// <param name="newView">The view matrix of the camera.</param>
+	/// <param name="newProjection">The projection matrix of the camera.</param>
+	void BeginFrame(const glm::mat4& newView, const glm::mat4& newProjection);
+
+	/// <summary>
+	/// Sets the light that reaches everything, no matter which way it faces.
+	/// </summary>
+	/// <param name="color">The colour of the ambient light.</param>
+	void SetAmbientLight(const glm::vec3& color);
+
+	/// <summary>
+	/// Adds a directional light to this frame. Lights only last for the frame they're added in.
+	/// Without the shader pipeline, only the first light is used.
+	/// </summary>
+	/// <param name="direction">The direction the light travels in world space.</param>
+	/// <param name="color">The colour of the light.</param>
+	/// <returns>Whether the light was added. This fails once there are already LightUniforms::maxLights lights.</returns>
+	bool AddLight(const glm::vec3& direction, const glm::vec3& color);
+
+	/// <summary>
+	/// Walks the scene graph from the given object and queues everything that's visible. Once the top of the graph has been split into
+	/// enough subtrees, they're walked on the worker threads into their own queues, which are then merged into this frame's queue.
+	/// </summary>
+	/// <param name="root">The object to start from.</param>
+	void CollectDrawCommands(std::shared_ptr<GameObject> root);
+
+	/// <summary>
+	/// Returns the queue that draw commands are collected into this frame.
+	/// </summary>
+	/// <returns>The queue for this frame.</returns>
+	RenderQueue& GetQueue();
+
+	/// <summary>
+	/// Returns the state cache that all GL state should be changed through while drawing.
+	/// </summary>
+	/// <returns>The state cache.</returns>
+	GLStateCache& GetState();
+
+	/// <summary>
+	/// Returns the text renderer, which draws the queue's text and any screen text after everything else each frame.
+	/// </summary>
+	/// <returns>The text renderer.</returns>
+	TextRenderer& GetText();
+
+	/// <summary>
+	/// Sorts and draws everything that was queued during the frame. This should be called once the scene graph has been walked.
+	/// Meshes are drawn with shaders when the context supports them. Custom renderables are still given the camera and model
+	/// through the fixed function matrix stack.
+	/// </summary>
+	void EndFrame();
+
+	/// <summary>
+	/// Returns the batch that draws the given mesh with the given material, creating it if it doesn't exist yet.
+	/// </summary>
+	/// <param name="mesh">The mesh of the batch.</param>
+	/// <param name="material">The material of the batch.</param>
+	/// <returns>The batch for the mesh and material.</returns>
+	std::shared_ptr<InstanceBatch> GetBatch(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material);
+
+	/// <summary>
+	/// Lets the renderer know that a draw call was made outside of it, so that it can be counted.
+	/// </summary>
+	void CountDrawCall();
+
+	/// <summary>
+	/// Returns the number of draw calls made during the last frame.
+	/// </summary>
+	/// <returns>The number of draw calls made during the last frame.</returns>
+	size_t GetDrawCalls() const;
+
+	/// <summary>
+	/// Returns the number of triangles drawn during the last frame.
+	/// </summary>
+	/// <returns>The number of triangles drawn during the last frame.</returns>
+	size_t GetTriangleCount() const;
+
+	/// <summary>
+	/// Returns how long the last call to CollectDrawCommands() took.
+	/// </summary>
+	/// <returns>How long the scene graph took to walk.</returns>
+	sf::Time GetTraversalTime() const;
+
+	/// <summary>
+	/// Returns how long the last call to EndFrame() took. This is only the time taken to issue the GL calls, not for them to finish.
+	/// </summary>
+	/// <returns>How long the queue took to sort and draw.</returns>
+	sf::Time GetDrawTime() const;
+
+	/// <summary>
+	/// Drops every batch, shader and buffer. This should be called before the context goes away.
+	/// </summary>
+	void Clear();
+
+	protected:
+	void Restore() override;
+
+	private:
+	/// <summary>
+	/// Sends the camera and lights to the uniform buffers and binds them to their blocks.
+	/// </summary>
+	void UploadUniforms();
+
+	/// <summary>
+	/// Sets up fixed function lighting to match the first light, for when there's no shader pipeline.
+	/// </summary>
+	void SetFixedFunctionLights();
+
+	/// <summary>
+	/// Draws a run of sorted commands that share a mesh and material in a single instanced call.
+	/// </summary>
+	/// <param name="begin">The position of the first command in sorted order.</param>
+	/// <param name="end">One past the position of the last command in sorted order.</param>
+	void DrawInstanced(size_t begin, size_t end);
+
+	/// <summary>
+	/// Draws a run of sorted commands that share a mesh and material one at a time, binding the mesh only once.
+	/// With the shader pipeline, each command's matrix and colour are given as constant instance attributes.
+	/// Otherwise they go through fixed function.
+	/// </summary>
+	/// <param name="begin">The position of the first command in sorted order.</param>
+	/// <param name="end">One past the position of the last command in sorted order.</param>
+	void DrawIndividually(size_t begin, size_t end);
+
+	/// <summary>
+	/// A part of the scene graph that's walked as one job.
+	/// </summary>
+	struct Subtree {
+		std::shared_ptr<GameObject> object;
+		glm::mat4 parentMatrix;
+	};
+
+	/// <summary>
+	/// The view matrix of the camera this frame.
+	/// </summary>
+	glm::mat4 view;
+
+	/// <summary>
+	/// The projection matrix of the camera this frame.
+	/// </summary>
+	glm::mat4 projection;
+
+	/// <summary>
+	/// The lights this frame, in the same layout as the Lights block.
+	/// </summary>
+	LightUniforms lights;
+
+	/// <summary>
+	/// The buffer that holds the Frame block. 0 if it hasn't been made.
+	/// </summary>
+	unsigned int frameUniformBuffer;
+
+	/// <summary>
+	/// The buffer that holds the Lights block. 0 if it hasn't been made.
+	/// </summary>
+	unsigned int lightUniformBuffer;
+
+	/// <summary>
+	/// The draw commands for this frame.
+	/// </summary>
+	RenderQueue queue;
+
+	/// <summary>
+	/// Draws all of the frame's text in one go.
+	/// </summary>
+	TextRenderer text;
+
+	/// <summary>
+	/// The shadow copy of the GL state.
+	/// </summary>
+	GLStateCache state;
+
+	/// <summary>
+	/// The threads that walk the scene graph.
+	/// </summary>
+	WorkerPool workers;
+
+	/// <summary>
+	/// The subtrees being walked this frame. This is kept between frames so it doesn't need to allocate.
+	/// </summary>
+	std::vector<Subtree> subtrees;
+
+	/// <summary>
+	/// A queue for each subtree, which are merged in order so that the result doesn't depend on which thread walked what.
+	/// </summary>
+	std::vector<RenderQueue> subtreeQueues;
+
+	/// <summary>
+	/// Every instance batch, keyed by the mesh and material they draw.
+	/// </summary>
+	std::map<std::pair<Mesh*, Material*>, std::shared_ptr<InstanceBatch>> batches;
+
+	/// <summary>
+	/// The number of draw calls made so far this frame.
+	/// </summary>
+	size_t drawCalls;
+
+	/// <summary>
+	/// The number of draw calls made during the last frame.
+	/// </summary>
+	size_t lastDrawCalls;
+
+	/// <summary>
+	/// The number of triangles drawn so far this frame.
+	/// </summary>
+	size_t triangles;
+
+	/// <summary>
+	/// The number of triangles drawn during the last frame.
+	/// </summary>
+	size_t lastTriangles;
+
+	/// <summary>
+	/// How long the last call to CollectDrawCommands() took.
+	/// </summary>
+	sf::Time traversalTime;
+
+	/// <summary>
+	/// How long the last call to EndFrame() took.
+	/// </summary>
+	sf::Time drawTime;
+};
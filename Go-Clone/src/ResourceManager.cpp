@@ -0,0 +1,81 @@
+#include "ResourceManager.h"
+
+#include "GLExtensions.h"
+
+ResourceManager::ResourceManager() {
+	sharedContext = nullptr;
+	canaryBuffer = 0;
+	hadContext = false;
+}
+
+ResourceManager::~ResourceManager() {
+	delete sharedContext;
+}
+
+void ResourceManager::HoldSharedContext() {
+	if (sharedContext == nullptr) {
+		sharedContext = new sf::Context();
+	}
+}
+
+size_t ResourceManager::ContextChanged() {
+	size_t restored = 0;
+	if (hadContext) {
+		// Without a canary to look for, there's no way to tell, so it's safer to assume everything went.
+		bool kept = canaryBuffer != 0 && GLExtensions::IsBuffer != nullptr && GLExtensions::IsBuffer(canaryBuffer) == GL_TRUE;
+		if (!kept) {
+			canaryBuffer = 0;
+			restored = GPUResource::RestoreAll();
+		}
+	}
+	hadContext = true;
+
+	if (canaryBuffer == 0 && GLExtensions::HasBuffers()) {
+		// A buffer name only counts as a buffer once it's been bound.
+		GLExtensions::GenBuffers(1, &canaryBuffer);
+		GLExtensions::BindBuffer(GL_ARRAY_BUFFER, canaryBuffer);
+		GLExtensions::BufferData(GL_ARRAY_BUFFER, 1, nullptr, GL_STATIC_DRAW);
+		GLExtensions::BindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+	return restored;
+}
+
+void ResourceManager::AddMesh(const std::string& name, std::shared_ptr<Mesh> mesh) {
+	meshes[name] = mesh;
+}
+
+std::shared_ptr<Mesh> ResourceManager::GetMesh(const std::string& name) const {
+	auto it = meshes.find(name);
+	return it != meshes.end() ? it->second : nullptr;
+}
+
+void ResourceManager::AddTexture(const std::string& name, std::shared_ptr<Texture> texture) {
+	textures[name] = texture;
+}
+
+std::shared_ptr<Texture> ResourceManager::GetTexture(const std::string& name) const {
+	auto it = textures.find(name);
+	return it != textures.end() ? it->second : nullptr;
+}
+
+void ResourceManager::AddShader(const std::string& name, std::shared_ptr<Shader> shader) {
+	shaders[name] = shader;
+}
+
+std::shared_ptr<Shader> ResourceManager::GetShader(const std::string& name) const {
+	auto it = shaders.find(name);
+	return it != shaders.end() ? it->second : nullptr;
+}
+
+void ResourceManager::Clear() {
+	meshes.clear();
+	textures.clear();
+	shaders.clear();
+	if (canaryBuffer != 0) {
+		GLExtensions::DeleteBuffers(1, &canaryBuffer);
+		canaryBuffer = 0;
+	}
+	hadContext = false;
+	delete sharedContext;
+	sharedContext = nullptr;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <SFML/Window/Context.hpp>
+
+#include "Mesh.h"
+#include "Shader.h"
+#include "Texture.h"
+
+/// <summary>
+/// Owns the meshes, textures and shaders that are shared across the game, and keeps them on the graphics card when the window is remade.
+/// A hidden context is held for the whole game, and every context SFML makes shares objects with it, so a new window sees the same
+/// buffers, textures and programs as the old one. If the objects are gone anyway (such as after a driver reset), every resource is
+/// remade from its CPU copy in one go.
+/// </summary>
+class ResourceManager {
+	public:
+	ResourceManager();
+	~ResourceManager();
+
+	/// <summary>
+	/// Keeps a hidden context alive until Clear() is called. This should be called before the first window is made.
+	/// The hidden context is current afterwards, so the window should be activated once it's made.
+	/// </summary>
+	void HoldSharedContext();
+
+	/// <summary>
+	/// Checks whether the objects from before are still there in the current context, and restores every resource if they aren't.
+	/// This should be called whenever a new context is made current, after GLExtensions::Load().
+	/// </summary>
+	/// <returns>How many resources were restored. This is 0 if nothing was lost.</returns>
+	size_t ContextChanged();
+
+	/// <summary>
+	/// Keeps a mesh under the given name, replacing whatever was there.
+	/// </summary>
+	/// <param name="name">The name to keep it under.</param>
+	/// <param name="mesh">The mesh.</param>
+	void AddMesh(const std::string& name, std::shared_ptr<Mesh> mesh);
+
+	/// <summary>
+	/// Returns the mesh kept under the given name.
+	/// </summary>
+	/// <param name="name">The name it was kept under.</param>
+	/// <returns>The mesh, or nullptr if there isn't one.</returns>
+	std::shared_ptr<Mesh> GetMesh(const std::string& name) const;
+
+	/// <summary>
+	/// Keeps a texture under the given name, replacing whatever was there.
+	/// </summary>
+	/// <param name="name">The name to keep it under.</param>
+	/// <param name="texture">The texture.</param>
+	void AddTexture(const std::string& name, std::shared_ptr<Texture> texture);
+
+	/// <summary>
+	/// Returns the texture kept under the given name.
+	/// </summary>
+	/// <param name="name">The name it was kept under.</param>
+	/// <returns>The texture, or nullptr if there isn't one.</returns>
+	std::shared_ptr<Texture> GetTexture(const std::string& name) const;
+
+	/// <summary>
+	/// Keeps a shader under the given name, replacing whatever was there.
+	/// </summary>
+	/// <param name="name">The name to keep it under.</param>
+	/// <param name="shader">The shader.</param>
+	void AddShader(const std::string& name, std::shared_ptr<Shader> shader);
+
+	/// <summary>
+	/// Returns the shader kept under the given name.
+	/// </summary>
+	/// <param name="name">The name it was kept under.</param>
+	/// <returns>The shader, or nullptr if there isn't one.</returns>
+	std::shared_ptr<Shader> GetShader(const std::string& name) const;
+
+	/// <summary>
+	/// Drops every resource and the hidden context. This should be called while a context is still current.
+	/// </summary>
+	void Clear();
+
+	private:
+	/// <summary>
+	/// The hidden context that keeps the shared objects alive. nullptr if HoldSharedContext() hasn't been called.
+	/// </summary>
+	sf::Context* sharedContext;
+
+	/// <summary>
+	/// A tiny buffer that's checked for after a context change. If it's gone, so is everything else.
+	/// </summary>
+	unsigned int canaryBuffer;
+
+	/// <summary>
+	/// Whether ContextChanged() has been called before.
+	/// </summary>
+	bool hadContext;
+
+	std::map<std::string, std::shared_ptr<Mesh>> meshes;
+	std::map<std::string, std::shared_ptr<Texture>> textures;
+	std::map<std::string, std::shared_ptr<Shader>> shaders;
+};
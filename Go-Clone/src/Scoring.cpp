@@ -0,0 +1,172 @@
+#include "Scoring.h"
+
+#include <vector>
+
+/// <summary>
+/// Returns the open points that can only reach the given colour's stones, and none of the other's.
+/// </summary>
+static Bitboard OnlyReaches(const Board& board, const Bitboard& open, const Bitboard& own, const Bitboard& other) {
+	Bitboard reachesOwn = board.Fill(board.Neighbours(own), open);
+	Bitboard reachesOther = board.Fill(board.Neighbours(other), open);
+	return reachesOwn.AndNot(reachesOther);
+}
+
+/// <summary>
+/// What FindPassAlive() works with, kept from one call to the next so it only grows to the most chains and regions seen, and is
+/// never cleared out point by point.
+/// </summary>
+struct PassAliveScratch {
+	struct Chain {
+		Bitboard liberties;
+		uint32_t vitalCount;
+	};
+
+	struct Region {
+		Bitboard points;
+
+		/// <summary>
+		/// The IDs of the chains next to the region.
+		/// </summary>
+		Bitboard bordering;
+
+		/// <summary>
+		/// The IDs of the chains the region is vital to.
+		/// </summary>
+		Bitboard vitalTo;
+
+		bool healthy;
+	};
+
+	std::vector<Chain> chains;
+	std::vector<Region> regions;
+
+	/// <summary>
+	/// Where each chain is in chains, under its ID. Only the entries for chains on the board are ever read.
+	/// </summary>
+	uint16_t chainIndex[Bitboard::maxPoints];
+};
+
+/// <summary>
+/// Returns the calling thread's scratch space, so playouts on different threads don't share one.
+/// </summary>
+static PassAliveScratch& GetPassAliveScratch() {
+	thread_local PassAliveScratch scratch;
+	return scratch;
+}
+
+Score Scoring::Area(const Board& board, float komi, const Bitboard& dead) {
+	Bitboard black = board.GetStones(EPlayer::EBlack).AndNot(dead);
+	Bitboard white = board.GetStones(EPlayer::EWhite).AndNot(dead);
+	Bitboard open = board.GetPoints().AndNot(black | white);
+
+	Score score;
+	score.black = static_cast<float>(black.Count() + OnlyReaches(board, open, black, white).Count());
+	score.white = static_cast<float>(white.Count() + OnlyReaches(board, open, white, black).Count()) + komi;
+	return score;
+}
+
+Score Scoring::Territory(const GameState& state, float komi, const Bitboard& dead) {
+	const Board& board = state.GetBoard();
+	Bitboard deadBlack = board.GetStones(EPlayer::EBlack) & dead;
+	Bitboard deadWhite = board.GetStones(EPlayer::EWhite) & dead;
+	Bitboard black = board.GetStones(EPlayer::EBlack).AndNot(dead);
+	Bitboard white = board.GetStones(EPlayer::EWhite).AndNot(dead);
+	Bitboard open = board.GetPoints().AndNot(black | white);
+
+	// Dead stones are taken off as prisoners, and the points they were on count as territory like any other empty point.
+	Score score;
+	score.black = static_cast<float>(OnlyReaches(board, open, black, white).Count() + state.GetCaptures(EPlayer::EBlack) + deadWhite.Count());
+	score.white = static_cast<float>(OnlyReaches(board, open, white, black).Count() + state.GetCaptures(EPlayer::EWhite) + deadBlack.Count()) + komi;
+	return score;
+}
+
+PassAlive Scoring::FindPassAlive(const Board& board, EPlayer player) {
+	PassAliveScratch& scratch = GetPassAliveScratch();
+	const Bitboard& own = board.GetStones(player);
+	Bitboard empty = board.GetEmpty();
+
+	// Sets of chains are bitboards of their IDs, and what's kept about each chain is found through its index.
+	scratch.chains.clear();
+	Bitboard alive;
+	Bitboard remaining = own;
+	while (!remaining.IsEmpty()) {
+		uint32_t chain = board.GetChainID(remaining.First());
+		Bitboard stones = board.GetChain(chain);
+		scratch.chainIndex[chain] = static_cast<uint16_t>(scratch.chains.size());
+		scratch.chains.push_back({ board.Neighbours(stones) & empty, 0 });
+		alive.Set(chain);
+		remaining = remaining.AndNot(stones);
+	}
+
+	scratch.regions.clear();
+	remaining = board.GetPoints().AndNot(own);
+	while (!remaining.IsEmpty()) {
+		scratch.regions.emplace_back();
+		PassAliveScratch::Region& region = scratch.regions.back();
+		Bitboard seed;
+		seed.Set(remaining.First());
+		region.points = board.Fill(seed, remaining);
+		region.healthy = true;
+		remaining = remaining.AndNot(region.points);
+
+		Bitboard regionEmpty = region.points & empty;
+		(board.Neighbours(region.points) & own).ForEach([&](uint32_t point) {
+			uint32_t chain = board.GetChainID(point);
+			if (region.bordering.Get(chain)) {
+				return;
+			}
+			region.bordering.Set(chain);
+			PassAliveScratch::Chain& chainScratch = scratch.chains[scratch.chainIndex[chain]];
+			if (regionEmpty.AndNot(chainScratch.liberties).IsEmpty()) {
+				region.vitalTo.Set(chain);
+				++chainScratch.vitalCount;
+			}
+		});
+	}
+
+	// Each pass can only kill chains, so this ends after at most one pass per chain, and usually after one or two.
+	while (true) {
+		Bitboard dying;
+		alive.ForEach([&](uint32_t chain) {
+			if (scratch.chains[scratch.chainIndex[chain]].vitalCount < 2) {
+				dying.Set(chain);
+			}
+		});
+		if (dying.IsEmpty()) {
+			break;
+		}
+		alive = alive.AndNot(dying);
+		for (PassAliveScratch::Region& region : scratch.regions) {
+			if (region.healthy && region.bordering.Intersects(dying)) {
+				region.healthy = false;
+				region.vitalTo.ForEach([&](uint32_t chain) {
+					--scratch.chains[scratch.chainIndex[chain]].vitalCount;
+				});
+			}
+		}
+	}
+
+	// Chains of the same colour are never next to each other, so filling from the IDs within the stones gives back just those chains.
+	PassAlive result;
+	result.stones = board.Fill(alive, own);
+	Bitboard aliveLiberties = board.Neighbours(result.stones);
+	for (const PassAliveScratch::Region& region : scratch.regions) {
+		if (region.healthy && !region.bordering.IsEmpty() && region.bordering.AndNot(alive).IsEmpty() && (region.points & empty).AndNot(aliveLiberties).IsEmpty()) {
+			result.territory |= region.points;
+		}
+	}
+	return result;
+}
+
+bool Scoring::IsSettled(const Board& board, float komi, Score& score) {
+	PassAlive black = FindPassAlive(board, EPlayer::EBlack);
+	PassAlive white = FindPassAlive(board, EPlayer::EWhite);
+	Bitboard blackPoints = black.stones | black.territory;
+	Bitboard whitePoints = white.stones | white.territory;
+	if ((blackPoints | whitePoints) != board.GetPoints()) {
+		return false;
+	}
+	score.black = static_cast<float>(blackPoints.Count());
+	score.white = static_cast<float>(whitePoints.Count()) + komi;
+	return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Bitboard.h"
+#include "Board.h"
+#include "Constants.h"
+#include "GameState.h"
+
+/// <summary>
+/// The result of scoring a game.
+/// </summary>
+struct Score {
+	/// <summary>
+	/// Black's points.
+	/// </summary>
+	float black;
+
+	/// <summary>
+	/// White's points, including komi.
+	/// </summary>
+	float white;
+
+	/// <summary>
+	/// Returns who has more points.
+	/// </summary>
+	/// <returns>The winner, or ENone if it's a draw.</returns>
+	EPlayer GetWinner() const {
+		return black > white ? EPlayer::EBlack : white > black ? EPlayer::EWhite : EPlayer::ENone;
+	}
+
+	/// <summary>
+	/// Returns how many more points black has than white, which is negative if white is ahead.
+	/// </summary>
+	/// <returns>The margin.</returns>
+	float GetMargin() const {
+		return black - white;
+	}
+};
+
+/// <summary>
+/// The stones and points a player keeps no matter what the other player does, even if they only ever pass.
+/// </summary>
+struct PassAlive {
+	/// <summary>
+	/// Chains that can't be captured.
+	/// </summary>
+	Bitboard stones;
+
+	/// <summary>
+	/// Regions surrounded by those chains that the other player can't live in, including any of their stones already there.
+	/// </summary>
+	Bitboard territory;
+};
+
+/// <summary>
+/// Scores boards at the end of a game. Everything works on whole regions at once with bitboard flood fills, so scoring a board takes
+/// a couple of fills rather than one per region, which matters when it happens at the end of every playout.
+/// </summary>
+class Scoring {
+	public:
+	/// <summary>
+	/// Scores by area, as in the Tromp-Taylor and Chinese rules. Each player gets a point for each of their stones, and for each
+	/// empty point that can only reach their stones.
+	/// </summary>
+	/// <param name="board">The board.</param>
+	/// <param name="komi">The points given to white.</param>
+	/// <param name="dead">Stones agreed to be dead, which are taken off before scoring. Tromp-Taylor scoring leaves this empty.</param>
+	/// <returns>The score.</returns>
+	static Score Area(const Board& board, float komi, const Bitboard& dead = Bitboard());
+
+	/// <summary>
+	/// Scores by territory, as in the Japanese rules. Each player gets a point for each empty point only their living stones reach,
+	/// each stone they've captured, and each of the other player's dead stones.
+	/// </summary>
+	/// <param name="state">The game, which has the board and how many stones each player has captured.</param>
+	/// <param name="komi">The points given to white.</param>
+	/// <param name="dead">Stones agreed to be dead.</param>
+	/// <returns>The score.</returns>
+	static Score Territory(const GameState& state, float komi, const Bitboard& dead);
+
+	/// <summary>
+	/// Finds a player's pass-alive chains and territory with Benson's algorithm. Every chain starts off alive and every region of
+	/// points that aren't the player's stones starts off healthy. A region is vital to a chain next to it if every empty point in it
+	/// is a liberty of that chain. Chains with fewer than two healthy vital regions die, regions next to a dead chain stop being
+	/// healthy, and this repeats until nothing changes.
+	/// </summary>
+	/// <param name="board">The board.</param>
+	/// <param name="player">The player. This mustn't be ENone.</param>
+	/// <returns>The player's pass-alive stones and territory.</returns>
+	static PassAlive FindPassAlive(const Board& board, EPlayer player);
+
+	/// <summary>
+	/// Checks whether every point on the board is already decided, meaning it's pass-alive for one player or the other, in which
+	/// case a playout can stop early since playing on can't change the result.
+	/// </summary>
+	/// <param name="board">The board.</param>
+	/// <param name="komi">The points given to white.</param>
+	/// <param name="score">Set to the area score the game will end with, if it's decided.</param>
+	/// <returns>Whether every point is decided.</returns>
+	static bool IsSettled(const Board& board, float komi, Score& score);
+};
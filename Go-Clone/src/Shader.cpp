@@ -0,0 +1,114 @@
+#include "Shader.h"
+
+#include <vector>
+
+#include "GLExtensions.h"
+#include "Log.h"
+
+Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource) : vertexSource(vertexSource), fragmentSource(fragmentSource) {
+	compiled = false;
+	program = 0;
+}
+
+Shader::~Shader() {
+	if (program != 0) {
+		GLExtensions::DeleteProgram(program);
+	}
+}
+
+bool Shader::Bind(GLStateCache& state) {
+	if (!Prepare()) {
+		return false;
+	}
+	state.UseProgram(program);
+	return true;
+}
+
+bool Shader::Prepare() {
+	if (!compiled) {
+		Compile();
+	}
+	return program != 0;
+}
+
+void Shader::Restore() {
+	bool wasLinked = program != 0;
+	program = 0;
+	compiled = false;
+	if (wasLinked) {
+		Compile();
+	}
+}
+
+void Shader::Compile() {
+	compiled = true;
+	if (!GLExtensions::HasShaders()) {
+		return;
+	}
+
+	unsigned int vertexShader = CompileStage(GL_VERTEX_SHADER, vertexSource);
+	unsigned int fragmentShader = CompileStage(GL_FRAGMENT_SHADER, fragmentSource);
+	if (vertexShader != 0 && fragmentShader != 0) {
+		program = GLExtensions::CreateProgram();
+		GLExtensions::AttachShader(program, vertexShader);
+		GLExtensions::AttachShader(program, fragmentShader);
+		GLExtensions::BindAttribLocation(program, EPosition, "position");
+		GLExtensions::BindAttribLocation(program, ENormal, "normal");
+		GLExtensions::BindAttribLocation(program, EInstanceModel, "instanceModel");
+		GLExtensions::BindAttribLocation(program, EInstanceColor, "instanceColor");
+		GLExtensions::BindAttribLocation(program, ETexCoord, "texCoord");
+		GLExtensions::BindAttribLocation(program, EVertexColor, "vertexColor");
+		GLExtensions::LinkProgram(program);
+
+		GLint status = GL_FALSE;
+		GLExtensions::GetProgramiv(program, GL_LINK_STATUS, &status);
+		if (status != GL_TRUE) {
+			GLint length = 0;
+			GLExtensions::GetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+			std::vector<char> log(length + 1, '\0');
+			GLExtensions::GetProgramInfoLog(program, length, nullptr, log.data());
+			LOG_ERROR("Shader failed to link: {}", log.data());
+			GLExtensions::DeleteProgram(program);
+			program = 0;
+		} else if (GLExtensions::HasUniformBuffers()) {
+			BindUniformBlock("Frame", EFrameBlock);
+			BindUniformBlock("Lights", ELightBlock);
+		}
+	}
+
+	// The program keeps what it needs, so the stages can go straight away.
+	if (vertexShader != 0) {
+		GLExtensions::DeleteShader(vertexShader);
+	}
+	if (fragmentShader != 0) {
+		GLExtensions::DeleteShader(fragmentShader);
+	}
+}
+
+void Shader::BindUniformBlock(const char* name, EUniformBlock binding) {
+	// Shaders that don't use a block just don't have it.
+	GLuint index = GLExtensions::GetUniformBlockIndex(program, name);
+	if (index != GL_INVALID_INDEX) {
+		GLExtensions::UniformBlockBinding(program, index, binding);
+	}
+}
+
+unsigned int Shader::CompileStage(unsigned int type, const std::string& source) {
+	unsigned int shader = GLExtensions::CreateShader(type);
+	const char* sourcePointer = source.c_str();
+	GLExtensions::ShaderSource(shader, 1, &sourcePointer, nullptr);
+	GLExtensions::CompileShader(shader);
+
+	GLint status = GL_FALSE;
+	GLExtensions::GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (status != GL_TRUE) {
+		GLint length = 0;
+		GLExtensions::GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+		std::vector<char> log(length + 1, '\0');
+		GLExtensions::GetShaderInfoLog(shader, length, nullptr, log.data());
+		LOG_ERROR("Shader failed to compile: {}", log.data());
+		GLExtensions::DeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "GLStateCache.h"
+#include "GPUResource.h"
+
+/// <summary>
+/// A linked vertex and fragment shader program. The sources are kept on the CPU and compiled the first time the program is bound,
+/// so shaders can be made before a context exists.
+/// </summary>
+class Shader : public GPUResource {
+	public:
+	/// <summary>
+	/// The attribute slots that the engine streams vertex and per-instance data into. These are bound before linking, so every shader
+	/// agrees on them. Shaders name them position, normal, instanceModel, instanceColor, texCoord and vertexColor.
+	/// </summary>
+	enum EAttribute {
+		EPosition = 0,
+		ENormal = 1,
+		EInstanceModel = 2,
+		EInstanceColor = 6,
+		ETexCoord = 7,
+		EVertexColor = 8
+	};
+
+	/// <summary>
+	/// The binding points of the uniform blocks that the renderer fills once per frame. Shaders name them Frame and Lights.
+	/// </summary>
+	enum EUniformBlock {
+		EFrameBlock = 0,
+		ELightBlock = 1
+	};
+
+	/// <summary>
+	/// Creates a shader from the given sources.
+	/// </summary>
+	/// <param name="vertexSource">The GLSL source of the vertex shader.</param>
+	/// <param name="fragmentSource">The GLSL source of the fragment shader.</param>
+	Shader(const std::string& vertexSource, const std::string& fragmentSource);
+	~Shader();
+
+	/// <summary>
+	/// Makes this the current program, compiling it first if it hasn't been.
+	/// The program is left bound afterwards; use GLStateCache::UseProgram(0) to go back to fixed function.
+	/// </summary>
+	/// <param name="state">The state cache to bind the program through.</param>
+	/// <returns>Whether the program is usable. If it failed to compile, nothing is bound.</returns>
+	bool Bind(GLStateCache& state);
+
+	/// <summary>
+	/// Compiles the program if it hasn't been already. This needs a current context.
+	/// </summary>
+	/// <returns>Whether the program compiled and linked successfully.</returns>
+	bool Prepare();
+
+	protected:
+	void Restore() override;
+
+	private:
+	/// <summary>
+	/// Compiles and links the program.
+	/// </summary>
+	void Compile();
+
+	/// <summary>
+	/// Points one of the program's uniform blocks at its binding point, if the program has it.
+	/// </summary>
+	/// <param name="name">The name of the block in the shader.</param>
+	/// <param name="binding">The binding point.</param>
+	void BindUniformBlock(const char* name, EUniformBlock binding);
+
+	/// <summary>
+	/// Compiles a single stage of the program.
+	/// </summary>
+	/// <param name="type">The stage type (GL_VERTEX_SHADER or GL_FRAGMENT_SHADER).</param>
+	/// <param name="source">The source code.</param>
+	/// <returns>The compiled shader, or 0 if it failed.</returns>
+	static unsigned int CompileStage(unsigned int type, const std::string& source);
+
+	/// <summary>
+	/// The source of the vertex shader.
+	/// </summary>
+	std::string vertexSource;
+
+	/// <summary>
+	/// The source of the fragment shader.
+	/// </summary>
+	std::string fragmentSource;
+
+	/// <summary>
+	/// Whether compiling has been attempted yet.
+	/// </summary>
+	bool compiled;
+
+	/// <summary>
+	/// The linked program, or 0 if it doesn't exist.
+	/// </summary>
+	unsigned int program;
+};
@@ -0,0 +1,150 @@
+#include "ShaderLibrary.h"
+
+#include <string>
+
+std::array<std::shared_ptr<Shader>, ShaderLibrary::EProgramCount> ShaderLibrary::programs;
+
+/// <summary>
+/// The camera block. This has to match FrameUniforms.
+/// </summary>
+static const char* frameBlockSource =
+	"layout(std140) uniform Frame {\n"
+	"	mat4 view;\n"
+	"	mat4 projection;\n"
+	"	vec4 cameraPosition;\n"
+	"};\n";
+
+/// <summary>
+/// The light block and the functions that light a surface with it. This has to match LightUniforms.
+/// </summary>
+static const char* lightingSource =
+	"layout(std140) uniform Lights {\n"
+	"	vec4 ambientLight;\n"
+	"	vec4 lightDirections[4];\n"
+	"	vec4 lightColors[4];\n"
+	"	ivec4 lightCount;\n"
+	"};\n"
+	"vec3 Diffuse(vec3 normal) {\n"
+	"	vec3 light = ambientLight.rgb;\n"
+	"	for (int i = 0; i < lightCount.x; ++i) {\n"
+	"		light += lightColors[i].rgb * max(dot(normal, -lightDirections[i].xyz), 0.0);\n"
+	"	}\n"
+	"	return light;\n"
+	"}\n"
+	"vec3 Specular(vec3 normal, vec3 toCamera, float shininess) {\n"
+	"	vec3 light = vec3(0.0);\n"
+	"	for (int i = 0; i < lightCount.x; ++i) {\n"
+	"		vec3 halfway = normalize(toCamera - lightDirections[i].xyz);\n"
+	"		light += lightColors[i].rgb * pow(max(dot(normal, halfway), 0.0), shininess);\n"
+	"	}\n"
+	"	return light;\n"
+	"}\n";
+
+/// <summary>
+/// The vertex shader every program shares. Each instance brings its own model matrix and colour.
+/// </summary>
+static const char* vertexBodySource =
+	"in vec3 position;\n"
+	"in vec3 normal;\n"
+	"in mat4 instanceModel;\n"
+	"in vec4 instanceColor;\n"
+	"out vec3 worldPosition;\n"
+	"out vec3 worldNormal;\n"
+	"out vec4 color;\n"
+	"void main() {\n"
+	"	vec4 world = instanceModel * vec4(position, 1.0);\n"
+	"	worldPosition = world.xyz;\n"
+	"	worldNormal = mat3(instanceModel) * normal;\n"
+	"	color = instanceColor;\n"
+	"	gl_Position = projection * view * world;\n"
+	"}\n";
+
+/// <summary>
+/// What every fragment shader starts with.
+/// </summary>
+static const char* fragmentHeaderSource =
+	"in vec3 worldPosition;\n"
+	"in vec3 worldNormal;\n"
+	"in vec4 color;\n"
+	"out vec4 fragColor;\n";
+
+static const char* litSource =
+	"void main() {\n"
+	"	vec3 normal = normalize(worldNormal);\n"
+	"	fragColor = vec4(color.rgb * Diffuse(normal), color.a);\n"
+	"}\n";
+
+static const char* stoneSource =
+	"void main() {\n"
+	"	vec3 normal = normalize(worldNormal);\n"
+	"	vec3 toCamera = normalize(cameraPosition.xyz - worldPosition);\n"
+	"	fragColor = vec4(color.rgb * Diffuse(normal) + 0.35 * Specular(normal, toCamera, 40.0), color.a);\n"
+	"}\n";
+
+static const char* boardSource =
+	"void main() {\n"
+	"	vec3 normal = normalize(worldNormal);\n"
+	"	vec3 toCamera = normalize(cameraPosition.xyz - worldPosition);\n"
+	"	float grain = sin((worldPosition.x + 0.15 * sin(worldPosition.z * 3.0)) * 60.0) * 0.5 + 0.5;\n"
+	"	vec3 wood = color.rgb * (0.85 + 0.15 * grain);\n"
+	"	fragColor = vec4(wood * Diffuse(normal) + 0.1 * Specular(normal, toCamera, 16.0), color.a);\n"
+	"}\n";
+
+static const char* markerSource =
+	"void main() {\n"
+	"	fragColor = color;\n"
+	"}\n";
+
+/// <summary>
+/// Text is already in clip space, so it's just passed through.
+/// </summary>
+static const char* textVertexSource =
+	"in vec4 position;\n"
+	"in vec2 texCoord;\n"
+	"in vec4 vertexColor;\n"
+	"out vec2 glyphCoord;\n"
+	"out vec4 color;\n"
+	"void main() {\n"
+	"	glyphCoord = texCoord;\n"
+	"	color = vertexColor;\n"
+	"	gl_Position = position;\n"
+	"}\n";
+
+/// <summary>
+/// The atlas stores the distance to the glyph's edge, with 0.5 on the edge. Blending over about a pixel either side of it keeps
+/// the edge smooth at any size.
+/// </summary>
+static const char* textFragmentSource =
+	"uniform sampler2D glyphs;\n"
+	"in vec2 glyphCoord;\n"
+	"in vec4 color;\n"
+	"out vec4 fragColor;\n"
+	"void main() {\n"
+	"	float distance = texture(glyphs, glyphCoord).r;\n"
+	"	float edge = max(fwidth(distance) * 0.75, 0.0001);\n"
+	"	fragColor = vec4(color.rgb, color.a * smoothstep(0.5 - edge, 0.5 + edge, distance));\n"
+	"}\n";
+
+std::shared_ptr<Shader> ShaderLibrary::Get(EProgram program) {
+	if (programs[program] != nullptr) {
+		return programs[program];
+	}
+
+	std::string version = "#version 140\n";
+	if (program == EText) {
+		programs[program] = std::make_shared<Shader>(version + textVertexSource, version + textFragmentSource);
+		return programs[program];
+	}
+
+	static const char* fragmentBodies[EProgramCount] = {litSource, stoneSource, boardSource, markerSource, nullptr};
+	std::string vertexSource = version + frameBlockSource + vertexBodySource;
+	std::string fragmentSource = version + frameBlockSource + lightingSource + fragmentHeaderSource + fragmentBodies[program];
+	programs[program] = std::make_shared<Shader>(vertexSource, fragmentSource);
+	return programs[program];
+}
+
+void ShaderLibrary::Clear() {
+	for (std::shared_ptr<Shader>& program : programs) {
+		program.reset();
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "Shader.h"
+
+/// <summary>
+/// The camera data every shader reads, laid out the same as the Frame uniform block (std140).
+/// </summary>
+struct FrameUniforms {
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::vec4 cameraPosition;
+};
+
+/// <summary>
+/// The lights every lit shader reads, laid out the same as the Lights uniform block (std140).
+/// Directions are the way the light travels in world space.
+/// </summary>
+struct LightUniforms {
+	static const int maxLights = 4;
+
+	glm::vec4 ambient;
+	glm::vec4 directions[maxLights];
+	glm::vec4 colors[maxLights];
+	// Only x is used, but std140 pads the count out to a full vec4 anyway.
+	glm::ivec4 count;
+};
+
+/// <summary>
+/// Every shader program the game draws with. Each program is only made (and compiled) once, and then shared by everything that uses it.
+/// Apart from text, they all take the same vertex and instance attributes, and read the camera and lights from the per-frame uniform blocks.
+/// </summary>
+class ShaderLibrary {
+	public:
+	/// <summary>
+	/// The programs in the library.
+	/// </summary>
+	enum EProgram {
+		/// <summary>
+		/// Plain diffuse lighting, for anything without a more specific look.
+		/// </summary>
+		ELit = 0,
+		/// <summary>
+		/// Glossy diffuse and specular lighting for the stones.
+		/// </summary>
+		EStone,
+		/// <summary>
+		/// Lit wood with a grain worked out from the world position, for the board.
+		/// </summary>
+		EBoard,
+		/// <summary>
+		/// Flat, unlit colour, for markers drawn on top of the board.
+		/// </summary>
+		EMarker,
+		/// <summary>
+		/// Text from the glyph atlas. This doesn't draw meshes, so it's only for TextRenderer: it takes clip space positions,
+		/// texture coordinates and colours per vertex.
+		/// </summary>
+		EText,
+		EProgramCount
+	};
+
+	/// <summary>
+	/// Returns the given program, making it if this is the first time it's been asked for.
+	/// </summary>
+	/// <param name="program">The program.</param>
+	/// <returns>The shared program.</returns>
+	static std::shared_ptr<Shader> Get(EProgram program);
+
+	/// <summary>
+	/// Drops every program. This should be called before the context goes away, since the library otherwise keeps them forever.
+	/// </summary>
+	static void Clear();
+
+	private:
+	/// <summary>
+	/// The programs that have been made so far.
+	/// </summary>
+	static std::array<std::shared_ptr<Shader>, EProgramCount> programs;
+};
@@ -0,0 +1,86 @@
+#include "TextLabel.h"
+
+#include <algorithm>
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+TextLabel::TextLabel(GameObject* gameObject) : Renderable(gameObject) {
+	size = 1.0f;
+	color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	offset = glm::vec3(0.0f, 0.0f, 0.0f);
+	billboard = false;
+}
+
+TextLabel::~TextLabel() {
+}
+
+void TextLabel::Render() {
+}
+
+void TextLabel::Submit(RenderQueue& queue, const glm::mat4& model) {
+	if (text.empty() || color.a <= 0.0f) {
+		return;
+	}
+
+	// Billboards only take the object's position and scale, so the text doesn't swing around with the object as it turns.
+	float scale = std::max(glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])));
+	glm::mat4 placed = model;
+	if (billboard) {
+		placed[3] += glm::vec4(offset * scale, 0.0f);
+	} else {
+		placed = glm::translate(model, offset);
+	}
+	// No glyph is wider than an em, so this sphere holds the whole string.
+	if (!queue.IsVisible(glm::vec3(placed[3]), size * scale * text.size())) {
+		return;
+	}
+
+	TextCommand command;
+	command.text = &text;
+	command.model = placed;
+	command.color = color;
+	command.size = billboard ? size * scale : size;
+	command.billboard = billboard;
+	queue.PushText(command);
+}
+
+const std::string& TextLabel::GetText() const {
+	return text;
+}
+
+void TextLabel::SetText(const std::string& newText) {
+	text = newText;
+}
+
+float TextLabel::GetSize() const {
+	return size;
+}
+
+void TextLabel::SetSize(float newSize) {
+	size = newSize;
+}
+
+glm::vec4 TextLabel::GetColor() const {
+	return color;
+}
+
+void TextLabel::SetColor(const glm::vec4& newColor) {
+	color = newColor;
+}
+
+glm::vec3 TextLabel::GetOffset() const {
+	return offset;
+}
+
+void TextLabel::SetOffset(const glm::vec3& newOffset) {
+	offset = newOffset;
+}
+
+bool TextLabel::IsBillboard() const {
+	return billboard;
+}
+
+void TextLabel::SetBillboard(bool newBillboard) {
+	billboard = newBillboard;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "ComponentTypes.h"
+
+/// <summary>
+/// Draws a string at the object's transform, such as a move number on a stone or a coordinate beside the board. The text is centred on
+/// the object and lies in its XY plane, unless it's a billboard, in which case it always faces the camera.
+/// All labels are drawn together by the renderer's TextRenderer, so they cost one draw call between them.
+/// </summary>
+class TextLabel : public Renderable {
+	public:
+	TextLabel(class GameObject* gameObject);
+	~TextLabel();
+
+	/// <summary>
+	/// Labels are only drawn through the render queue, so this does nothing.
+	/// </summary>
+	void Render() override;
+
+	void Submit(RenderQueue& queue, const glm::mat4& model) override;
+
+	/// <summary>
+	/// Returns the text that is drawn.
+	/// </summary>
+	/// <returns>The text that is drawn.</returns>
+	const std::string& GetText() const;
+
+	/// <summary>
+	/// Sets the text that is drawn. Lines can be split with '\n'.
+	/// </summary>
+	/// <param name="newText">The new text.</param>
+	void SetText(const std::string& newText);
+
+	/// <summary>
+	/// Returns the size of the font, in the object's units.
+	/// </summary>
+	/// <returns>The size of the font.</returns>
+	float GetSize() const;
+
+	/// <summary>
+	/// Sets the size of the font (the height of an em), in the object's units.
+	/// </summary>
+	/// <param name="newSize">The new size of the font.</param>
+	void SetSize(float newSize);
+
+	/// <summary>
+	/// Returns the colour of the text.
+	/// </summary>
+	/// <returns>The colour of the text.</returns>
+	glm::vec4 GetColor() const;
+
+	/// <summary>
+	/// Sets the colour of the text. The alpha makes it see-through.
+	/// </summary>
+	/// <param name="newColor">The new colour.</param>
+	void SetColor(const glm::vec4& newColor);
+
+	/// <summary>
+	/// Returns where the text is centred, relative to the object.
+	/// </summary>
+	/// <returns>The offset of the text.</returns>
+	glm::vec3 GetOffset() const;
+
+	/// <summary>
+	/// Sets where the text is centred, relative to the object. This is useful for putting text on a surface of the object's mesh.
+	/// Billboards don't turn the offset with the object, so it stays on the same side of the object however it's rotated.
+	/// </summary>
+	/// <param name="newOffset">The new offset.</param>
+	void SetOffset(const glm::vec3& newOffset);
+
+	/// <summary>
+	/// Returns whether the text always faces the camera.
+	/// </summary>
+	/// <returns>Whether the text is a billboard.</returns>
+	bool IsBillboard() const;
+
+	/// <summary>
+	/// Sets whether the text always faces the camera.
+	/// </summary>
+	/// <param name="newBillboard">Whether the text should be a billboard.</param>
+	void SetBillboard(bool newBillboard);
+
+	private:
+	std::string text;
+
+	float size;
+
+	glm::vec4 color;
+
+	glm::vec3 offset;
+
+	bool billboard;
+};
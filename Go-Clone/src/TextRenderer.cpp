@@ -0,0 +1,178 @@
+#include "TextRenderer.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "GLExtensions.h"
+#include "Shader.h"
+#include "ShaderLibrary.h"
+
+/// <summary>
+/// How many layouts are cached before the cache is emptied.
+/// </summary>
+static const size_t maxCachedLayouts = 1024;
+
+TextRenderer::TextRenderer() : screenSize(1.0f) {
+	vertexBuffer = 0;
+	bufferCapacity = 0;
+}
+
+TextRenderer::~TextRenderer() {
+	Clear();
+}
+
+void TextRenderer::SetAtlas(std::shared_ptr<GlyphAtlas> newAtlas) {
+	atlas = newAtlas;
+	layouts.clear();
+}
+
+bool TextRenderer::IsReady() const {
+	return atlas != nullptr && atlas->IsReady() && GLExtensions::HasShaderPipeline();
+}
+
+void TextRenderer::SetScreenSize(const glm::vec2& size) {
+	screenSize = glm::max(size, glm::vec2(1.0f));
+}
+
+void TextRenderer::AddScreenText(const std::string& text, const glm::vec2& position, float size, const glm::vec4& color) {
+	screenTexts.push_back(ScreenText{text, position, size, color});
+}
+
+bool TextRenderer::Draw(const RenderQueue& queue, const glm::mat4& view, const glm::mat4& projection, GLStateCache& state) {
+	if (!IsReady()) {
+		screenTexts.clear();
+		return false;
+	}
+
+	vertices.clear();
+	glm::mat4 viewProjection = projection * view;
+	for (size_t i = 0; i < queue.GetTextCount(); ++i) {
+		const TextCommand& command = queue.GetText(i);
+		const Layout& layout = GetLayout(*command.text);
+		glm::mat4 toClip;
+		if (command.billboard) {
+			// The text is laid out in view space around where the origin ends up, so it always faces the camera.
+			glm::vec3 anchor = glm::vec3(view * command.model[3]);
+			toClip = glm::scale(glm::translate(projection, anchor), glm::vec3(command.size));
+		} else {
+			toClip = glm::scale(viewProjection * command.model, glm::vec3(command.size));
+		}
+		AddQuads(layout, toClip, glm::vec2(-layout.size.x, layout.size.y) * 0.5f, command.color);
+	}
+
+	for (const ScreenText& screenText : screenTexts) {
+		// Pixels from the top left are moved into clip space, which goes from -1 to 1 with y up.
+		glm::mat4 toClip = glm::translate(glm::mat4(1.0f), glm::vec3(-1.0f, 1.0f, -1.0f));
+		toClip = glm::scale(toClip, glm::vec3(2.0f / screenSize.x, -2.0f / screenSize.y, 1.0f));
+		toClip = glm::translate(toClip, glm::vec3(screenText.position, 0.0f));
+		toClip = glm::scale(toClip, glm::vec3(screenText.size, -screenText.size, 1.0f));
+		AddQuads(GetLayout(screenText.text), toClip, glm::vec2(0.0f), screenText.color);
+	}
+	screenTexts.clear();
+
+	std::shared_ptr<Shader> shader = ShaderLibrary::Get(ShaderLibrary::EText);
+	if (vertices.empty() || !shader->Bind(state)) {
+		return false;
+	}
+
+	// The buffer is given fresh storage each frame, so the driver doesn't have to wait for last frame's draw to finish with it.
+	size_t bytes = vertices.size() * sizeof(Vertex);
+	if (vertexBuffer == 0) {
+		GLExtensions::GenBuffers(1, &vertexBuffer);
+	}
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	if (bytes > bufferCapacity) {
+		bufferCapacity = std::max(bytes, bufferCapacity * 2);
+	}
+	GLExtensions::BufferData(GL_ARRAY_BUFFER, bufferCapacity, nullptr, GL_DYNAMIC_DRAW);
+	GLExtensions::BufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices.data());
+
+	GLExtensions::EnableVertexAttribArray(Shader::EPosition);
+	GLExtensions::EnableVertexAttribArray(Shader::ETexCoord);
+	GLExtensions::EnableVertexAttribArray(Shader::EVertexColor);
+	GLExtensions::VertexAttribPointer(Shader::EPosition, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, position)));
+	GLExtensions::VertexAttribPointer(Shader::ETexCoord, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, texCoord)));
+	GLExtensions::VertexAttribPointer(Shader::EVertexColor, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, color)));
+	atlas->GetTexture()->Bind();
+
+	// Text is tested against the scene but doesn't hide anything behind it, so overlapping labels blend properly.
+	// Screen text is flipped to put y downwards, which turns its quads around, so nothing is culled.
+	state.Disable(GL_CULL_FACE);
+	state.Enable(GL_BLEND);
+	state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	state.DepthMask(false);
+	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+	state.DepthMask(true);
+	state.Disable(GL_BLEND);
+
+	GLExtensions::DisableVertexAttribArray(Shader::EPosition);
+	GLExtensions::DisableVertexAttribArray(Shader::ETexCoord);
+	GLExtensions::DisableVertexAttribArray(Shader::EVertexColor);
+	GLExtensions::BindBuffer(GL_ARRAY_BUFFER, 0);
+	return true;
+}
+
+size_t TextRenderer::GetCachedLayoutCount() const {
+	return layouts.size();
+}
+
+void TextRenderer::Clear() {
+	if (vertexBuffer != 0) {
+		GLExtensions::DeleteBuffers(1, &vertexBuffer);
+		vertexBuffer = 0;
+	}
+	bufferCapacity = 0;
+}
+
+void TextRenderer::Restore() {
+	vertexBuffer = 0;
+	bufferCapacity = 0;
+}
+
+const TextRenderer::Layout& TextRenderer::GetLayout(const std::string& text) {
+	auto it = layouts.find(text);
+	if (it != layouts.end()) {
+		return it->second;
+	}
+	if (layouts.size() >= maxCachedLayouts) {
+		layouts.clear();
+	}
+
+	Layout& layout = layouts[text];
+	glm::vec2 pen(0.0f, -atlas->GetAscender());
+	float widest = 0.0f;
+	for (char character : text) {
+		if (character == '\n') {
+			pen.x = 0.0f;
+			pen.y -= atlas->GetLineHeight();
+			continue;
+		}
+		const GlyphAtlas::Glyph& glyph = atlas->GetGlyph(static_cast<unsigned char>(character));
+		if (glyph.planeMax.x > glyph.planeMin.x) {
+			layout.glyphs.push_back(PlacedGlyph{pen + glyph.planeMin, pen + glyph.planeMax, glyph.uvMin, glyph.uvMax});
+		}
+		pen.x += glyph.advance;
+		widest = std::max(widest, pen.x);
+	}
+	layout.size = glm::vec2(widest, -pen.y - atlas->GetDescender());
+	return layout;
+}
+
+void TextRenderer::AddQuads(const Layout& layout, const glm::mat4& toClip, const glm::vec2& origin, const glm::vec4& color) {
+	for (const PlacedGlyph& glyph : layout.glyphs) {
+		glm::vec2 low = origin + glyph.planeMin;
+		glm::vec2 high = origin + glyph.planeMax;
+		Vertex bottomLeft{toClip * glm::vec4(low.x, low.y, 0.0f, 1.0f), glyph.uvMin, color};
+		Vertex bottomRight{toClip * glm::vec4(high.x, low.y, 0.0f, 1.0f), glm::vec2(glyph.uvMax.x, glyph.uvMin.y), color};
+		Vertex topLeft{toClip * glm::vec4(low.x, high.y, 0.0f, 1.0f), glm::vec2(glyph.uvMin.x, glyph.uvMax.y), color};
+		Vertex topRight{toClip * glm::vec4(high.x, high.y, 0.0f, 1.0f), glyph.uvMax, color};
+		vertices.push_back(bottomLeft);
+		vertices.push_back(bottomRight);
+		vertices.push_back(topLeft);
+		vertices.push_back(topLeft);
+		vertices.push_back(bottomRight);
+		vertices.push_back(topRight);
+	}
+}
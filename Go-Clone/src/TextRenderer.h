@@ -0,0 +1,158 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "GLStateCache.h"
+#include "GlyphAtlas.h"
+#include "GPUResource.h"
+#include "RenderQueue.h"
+
+/// <summary>
+/// Draws all of a frame's text at once. Every glyph of every string is put into one vertex buffer, already moved into clip space,
+/// so the whole lot takes a single draw call with the glyph atlas. The layout of each string is worked out once and cached, since the
+/// same labels are drawn frame after frame.
+/// </summary>
+class TextRenderer : public GPUResource {
+	public:
+	TextRenderer();
+	~TextRenderer();
+
+	/// <summary>
+	/// Sets the glyphs to draw text with. Nothing is drawn until this has been given a built atlas.
+	/// </summary>
+	/// <param name="newAtlas">The atlas.</param>
+	void SetAtlas(std::shared_ptr<GlyphAtlas> newAtlas);
+
+	/// <summary>
+	/// Returns whether text can be drawn. This needs an atlas and the shader pipeline.
+	/// </summary>
+	/// <returns>Whether text can be drawn.</returns>
+	bool IsReady() const;
+
+	/// <summary>
+	/// Sets the size of the window, which screen text is positioned in.
+	/// </summary>
+	/// <param name="size">The size of the window in pixels.</param>
+	void SetScreenSize(const glm::vec2& size);
+
+	/// <summary>
+	/// Adds text to draw over the top of the scene this frame.
+	/// </summary>
+	/// <param name="text">The text. This is copied.</param>
+	/// <param name="position">Where the top left of the text goes, in pixels from the top left of the window.</param>
+	/// <param name="size">The size of the font in pixels.</param>
+	/// <param name="color">The colour of the text.</param>
+	void AddScreenText(const std::string& text, const glm::vec2& position, float size, const glm::vec4& color);
+
+	/// <summary>
+	/// Draws the queue's text and this frame's screen text, then forgets the screen text.
+	/// </summary>
+	/// <param name="queue">The queue holding the text in the scene.</param>
+	/// <param name="view">The view matrix of the camera.</param>
+	/// <param name="projection">The projection matrix of the camera.</param>
+	/// <param name="state">The state cache to change state through.</param>
+	/// <returns>Whether anything was drawn (which is always one draw call).</returns>
+	bool Draw(const RenderQueue& queue, const glm::mat4& view, const glm::mat4& projection, GLStateCache& state);
+
+	/// <summary>
+	/// Returns the number of strings whose layouts are cached.
+	/// </summary>
+	/// <returns>The number of cached layouts.</returns>
+	size_t GetCachedLayoutCount() const;
+
+	/// <summary>
+	/// Deletes the vertex buffer. This should be called before the context goes away.
+	/// </summary>
+	void Clear();
+
+	protected:
+	void Restore() override;
+
+	private:
+	/// <summary>
+	/// A glyph placed in a string, in ems from the top left of the string.
+	/// </summary>
+	struct PlacedGlyph {
+		glm::vec2 planeMin;
+		glm::vec2 planeMax;
+		glm::vec2 uvMin;
+		glm::vec2 uvMax;
+	};
+
+	/// <summary>
+	/// Where every glyph of a string goes. Lines go down from the top, so y is negative.
+	/// </summary>
+	struct Layout {
+		std::vector<PlacedGlyph> glyphs;
+		glm::vec2 size;
+	};
+
+	/// <summary>
+	/// Text added with AddScreenText().
+	/// </summary>
+	struct ScreenText {
+		std::string text;
+		glm::vec2 position;
+		float size;
+		glm::vec4 color;
+	};
+
+	/// <summary>
+	/// The layout of a vertex in the buffer. Positions are already in clip space.
+	/// </summary>
+	struct Vertex {
+		glm::vec4 position;
+		glm::vec2 texCoord;
+		glm::vec4 color;
+	};
+
+	/// <summary>
+	/// Returns the layout of a string, working it out if it isn't cached.
+	/// </summary>
+	/// <param name="text">The string.</param>
+	/// <returns>The layout. This is only valid until the next call.</returns>
+	const Layout& GetLayout(const std::string& text);
+
+	/// <summary>
+	/// Adds the quads of a string to the vertex list.
+	/// </summary>
+	/// <param name="layout">The layout of the string.</param>
+	/// <param name="toClip">Moves a point from the string's space (where 1 is the font size) into clip space.</param>
+	/// <param name="origin">Where the top left of the string goes, in ems.</param>
+	/// <param name="color">The colour of the string.</param>
+	void AddQuads(const Layout& layout, const glm::mat4& toClip, const glm::vec2& origin, const glm::vec4& color);
+
+	std::shared_ptr<GlyphAtlas> atlas;
+
+	/// <summary>
+	/// The layout of every string drawn recently. This is emptied whenever it gets too big, so strings that change every frame
+	/// can't grow it forever.
+	/// </summary>
+	std::unordered_map<std::string, Layout> layouts;
+
+	std::vector<ScreenText> screenTexts;
+
+	glm::vec2 screenSize;
+
+	/// <summary>
+	/// The vertices of this frame's text. This is kept between frames so it doesn't need to allocate.
+	/// </summary>
+	std::vector<Vertex> vertices;
+
+	/// <summary>
+	/// The buffer the vertices are streamed into. 0 if it hasn't been made.
+	/// </summary>
+	unsigned int vertexBuffer;
+
+	/// <summary>
+	/// The size of the vertex buffer in bytes.
+	/// </summary>
+	size_t bufferCapacity;
+};
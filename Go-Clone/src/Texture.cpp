@@ -0,0 +1,81 @@
+#include "Texture.h"
+
+#include <cstring>
+
+#include "GLExtensions.h"
+
+Texture::Texture(uint32_t width, uint32_t height, EFormat format, const std::vector<uint8_t>& pixels) : width(width), height(height), format(format), pixels(pixels) {
+	texture = 0;
+	this->pixels.resize(static_cast<size_t>(width) * height * GetPixelSize());
+}
+
+Texture::~Texture() {
+	if (texture != 0) {
+		glDeleteTextures(1, &texture);
+	}
+}
+
+void Texture::Prepare() {
+	if (texture == 0) {
+		Upload();
+	}
+}
+
+void Texture::Bind() {
+	Prepare();
+	glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void Texture::Update(uint32_t x, uint32_t y, uint32_t areaWidth, uint32_t areaHeight, const uint8_t* areaPixels) {
+	uint32_t pixelSize = GetPixelSize();
+	for (uint32_t row = 0; row < areaHeight; ++row) {
+		std::memcpy(&pixels[((y + row) * width + x) * pixelSize], areaPixels + row * areaWidth * pixelSize, areaWidth * pixelSize);
+	}
+	if (texture != 0) {
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, areaWidth, areaHeight, format == ERGBA ? GL_RGBA : GL_RED, GL_UNSIGNED_BYTE, areaPixels);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+}
+
+uint32_t Texture::GetWidth() const {
+	return width;
+}
+
+uint32_t Texture::GetHeight() const {
+	return height;
+}
+
+const std::vector<uint8_t>& Texture::GetPixels() const {
+	return pixels;
+}
+
+void Texture::Restore() {
+	bool wasUploaded = texture != 0;
+	texture = 0;
+	if (wasUploaded) {
+		Upload();
+	}
+}
+
+void Texture::Upload() {
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	// Single channel rows aren't always a multiple of 4 bytes.
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	if (format == ERGBA) {
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	} else {
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+uint32_t Texture::GetPixelSize() const {
+	return format == ERGBA ? 4 : 1;
+}
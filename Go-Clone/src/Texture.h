@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GPUResource.h"
+
+/// <summary>
+/// A 2D image on the graphics card. Like meshes, the pixels are kept on the CPU and uploaded on first use, so textures can be made
+/// before a context exists and remade if it's lost.
+/// </summary>
+class Texture : public GPUResource {
+	public:
+	/// <summary>
+	/// The layout of the pixels.
+	/// </summary>
+	enum EFormat {
+		/// <summary>
+		/// One byte per pixel, read by shaders as the red channel.
+		/// </summary>
+		ESingleChannel,
+		/// <summary>
+		/// Four bytes per pixel: red, green, blue and alpha.
+		/// </summary>
+		ERGBA
+	};
+
+	/// <summary>
+	/// Creates a texture from the given pixels. Nothing is uploaded until the first bind.
+	/// </summary>
+	/// <param name="width">The width in pixels.</param>
+	/// <param name="height">The height in pixels.</param>
+	/// <param name="format">The layout of the pixels.</param>
+	/// <param name="pixels">The pixels, row by row from the bottom.</param>
+	Texture(uint32_t width, uint32_t height, EFormat format, const std::vector<uint8_t>& pixels);
+	~Texture();
+
+	/// <summary>
+	/// Uploads the texture now if it hasn't been already, rather than waiting for the first bind. This needs a current context.
+	/// </summary>
+	void Prepare();
+
+	/// <summary>
+	/// Binds the texture to the current texture unit, uploading it first if it hasn't been.
+	/// </summary>
+	void Bind();
+
+	/// <summary>
+	/// Replaces part of the texture. The CPU copy is updated too, so the change survives a lost context.
+	/// </summary>
+	/// <param name="x">The left of the area to replace.</param>
+	/// <param name="y">The bottom of the area to replace.</param>
+	/// <param name="areaWidth">The width of the area to replace.</param>
+	/// <param name="areaHeight">The height of the area to replace.</param>
+	/// <param name="areaPixels">The new pixels, row by row from the bottom, in the texture's format.</param>
+	void Update(uint32_t x, uint32_t y, uint32_t areaWidth, uint32_t areaHeight, const uint8_t* areaPixels);
+
+	/// <summary>
+	/// Returns the width in pixels.
+	/// </summary>
+	/// <returns>The width in pixels.</returns>
+	uint32_t GetWidth() const;
+
+	/// <summary>
+	/// Returns the height in pixels.
+	/// </summary>
+	/// <returns>The height in pixels.</returns>
+	uint32_t GetHeight() const;
+
+	/// <summary>
+	/// Returns the CPU copy of the pixels.
+	/// </summary>
+	/// <returns>The pixels.</returns>
+	const std::vector<uint8_t>& GetPixels() const;
+
+	protected:
+	void Restore() override;
+
+	private:
+	/// <summary>
+	/// Sends the pixels to the graphics card.
+	/// </summary>
+	void Upload();
+
+	/// <summary>
+	/// Returns how many bytes each pixel takes up.
+	/// </summary>
+	/// <returns>How many bytes each pixel takes up.</returns>
+	uint32_t GetPixelSize() const;
+
+	uint32_t width;
+	uint32_t height;
+	EFormat format;
+
+	/// <summary>
+	/// The CPU copy of the pixels.
+	/// </summary>
+	std::vector<uint8_t> pixels;
+
+	/// <summary>
+	/// The texture object, or 0 if it hasn't been uploaded.
+	/// </summary>
+	unsigned int texture;
+};
@@ -1,5 +1,7 @@
 #include "Transform.h"
 
+#include <glm/gtc/matrix_transform.hpp>
+
 
 
 Transform::Transform(GameObject* gameObject) : Component(gameObject) {
@@ -24,3 +26,11 @@ glm::vec3& Transform::Rotate() {
 glm::vec3& Transform::Scale() {
 	return scale;
 }
+
+glm::mat4 Transform::GetMatrix() const {
+	glm::mat4 matrix = glm::translate(glm::mat4(1.0f), translate);
+	matrix = glm::rotate(matrix, rotate.x, glm::vec3(1.0f, 0.0f, 0.0f));
+	matrix = glm::rotate(matrix, rotate.y, glm::vec3(0.0f, 1.0f, 0.0f));
+	matrix = glm::rotate(matrix, rotate.z, glm::vec3(0.0f, 0.0f, 1.0f));
+	return glm::scale(matrix, scale);
+}
\ No newline at end of file
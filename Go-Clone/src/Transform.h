@@ -1,5 +1,6 @@
 #pragma once
 
+#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 
 #include "Component.h"
@@ -31,6 +32,13 @@ class Transform : public Component {
 	/// <returns>The scale of the object.</returns>
 	glm::vec3& Scale();
 
+	/// <summary>
+	/// Returns the matrix that takes the object's local space into its parent's space.
+	/// This is translation, then rotation around X, Y and Z in that order, then scale.
+	/// </summary>
+	/// <returns>The local matrix of the object.</returns>
+	glm::mat4 GetMatrix() const;
+
 	//TODO: Add support for getting global positions.
 
 	static const bool unique = true;
@@ -0,0 +1,359 @@
+#include "TrueTypeFont.h"
+
+#include <cstring>
+
+/// <summary>
+/// How many straight lines each curve is split into.
+/// </summary>
+static const int curveSteps = 8;
+
+/// <summary>
+/// How deep composite glyphs can nest before giving up, so a broken font can't recurse forever.
+/// </summary>
+static const int maxCompositeDepth = 8;
+
+TrueTypeFont::TrueTypeFont() {
+	glyfTable = 0;
+	locaTable = 0;
+	hmtxTable = 0;
+	cmapSubtable = 0;
+	cmapFormat = 0;
+	longLoca = false;
+	glyphCount = 0;
+	horizontalMetricCount = 0;
+	unitsPerEm = 1.0f;
+	ascender = 0.0f;
+	descender = 0.0f;
+	lineGap = 0.0f;
+}
+
+bool TrueTypeFont::Load(const std::vector<uint8_t>& fontData) {
+	data = fontData;
+	if (data.size() < 12) {
+		return false;
+	}
+
+	uint32_t head = FindTable("head");
+	uint32_t maxp = FindTable("maxp");
+	uint32_t hhea = FindTable("hhea");
+	uint32_t cmap = FindTable("cmap");
+	glyfTable = FindTable("glyf");
+	locaTable = FindTable("loca");
+	hmtxTable = FindTable("hmtx");
+	// Fonts with CFF outlines don't have glyf and loca, and aren't supported.
+	if (head == 0 || maxp == 0 || hhea == 0 || cmap == 0 || glyfTable == 0 || locaTable == 0 || hmtxTable == 0) {
+		return false;
+	}
+
+	unitsPerEm = ReadU16(head + 18);
+	longLoca = ReadS16(head + 50) != 0;
+	glyphCount = ReadU16(maxp + 4);
+	ascender = ReadS16(hhea + 4);
+	descender = ReadS16(hhea + 6);
+	lineGap = ReadS16(hhea + 8);
+	horizontalMetricCount = ReadU16(hhea + 34);
+	if (unitsPerEm == 0.0f || horizontalMetricCount == 0) {
+		return false;
+	}
+
+	// The Windows Unicode maps are preferred, with the full repertoire one first.
+	uint16_t subtableCount = ReadU16(cmap + 2);
+	int bestScore = 0;
+	for (uint16_t i = 0; i < subtableCount; ++i) {
+		uint32_t record = cmap + 4 + i * 8;
+		uint16_t platform = ReadU16(record);
+		uint16_t encoding = ReadU16(record + 2);
+		uint32_t subtable = cmap + ReadU32(record + 4);
+		uint16_t format = ReadU16(subtable);
+		int score = 0;
+		if (format == 12 && (platform == 0 || (platform == 3 && encoding == 10))) {
+			score = 3;
+		} else if (format == 4 && platform == 3 && encoding == 1) {
+			score = 2;
+		} else if (format == 4 && platform == 0) {
+			score = 1;
+		}
+		if (score > bestScore) {
+			bestScore = score;
+			cmapSubtable = subtable;
+			cmapFormat = format;
+		}
+	}
+	return cmapSubtable != 0;
+}
+
+uint32_t TrueTypeFont::GetGlyphIndex(uint32_t codepoint) const {
+	if (cmapFormat == 4) {
+		if (codepoint > 0xFFFF) {
+			return 0;
+		}
+		uint16_t segmentCount = ReadU16(cmapSubtable + 6) / 2;
+		uint32_t endCodes = cmapSubtable + 14;
+		uint32_t startCodes = endCodes + segmentCount * 2 + 2;
+		uint32_t deltas = startCodes + segmentCount * 2;
+		uint32_t rangeOffsets = deltas + segmentCount * 2;
+		for (uint16_t segment = 0; segment < segmentCount; ++segment) {
+			if (codepoint > ReadU16(endCodes + segment * 2)) {
+				continue;
+			}
+			uint16_t start = ReadU16(startCodes + segment * 2);
+			if (codepoint < start) {
+				return 0;
+			}
+			uint16_t delta = ReadU16(deltas + segment * 2);
+			uint16_t rangeOffset = ReadU16(rangeOffsets + segment * 2);
+			if (rangeOffset == 0) {
+				return static_cast<uint16_t>(codepoint + delta);
+			}
+			// The offset is relative to where it's stored, which is how the format was designed.
+			uint16_t glyph = ReadU16(rangeOffsets + segment * 2 + rangeOffset + (codepoint - start) * 2);
+			return glyph == 0 ? 0 : static_cast<uint16_t>(glyph + delta);
+		}
+	} else if (cmapFormat == 12) {
+		uint32_t groupCount = ReadU32(cmapSubtable + 12);
+		for (uint32_t group = 0; group < groupCount; ++group) {
+			uint32_t record = cmapSubtable + 16 + group * 12;
+			uint32_t start = ReadU32(record);
+			uint32_t end = ReadU32(record + 4);
+			if (codepoint >= start && codepoint <= end) {
+				return ReadU32(record + 8) + (codepoint - start);
+			}
+		}
+	}
+	return 0;
+}
+
+std::vector<TrueTypeFont::Contour> TrueTypeFont::GetGlyphShape(uint32_t glyph) const {
+	std::vector<Contour> contours;
+	AddGlyphShape(glyph, glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f), glm::vec2(0.0f), 0, contours);
+	return contours;
+}
+
+float TrueTypeFont::GetAdvance(uint32_t glyph) const {
+	// Glyphs past the end of the table all share the last advance (which is how monospaced fonts save space).
+	uint32_t metric = glyph < horizontalMetricCount ? glyph : horizontalMetricCount - 1;
+	return ReadU16(hmtxTable + metric * 4);
+}
+
+float TrueTypeFont::GetUnitsPerEm() const {
+	return unitsPerEm;
+}
+
+float TrueTypeFont::GetAscender() const {
+	return ascender;
+}
+
+float TrueTypeFont::GetDescender() const {
+	return descender;
+}
+
+float TrueTypeFont::GetLineGap() const {
+	return lineGap;
+}
+
+void TrueTypeFont::AddGlyphShape(uint32_t glyph, const glm::vec2& xAxis, const glm::vec2& yAxis, const glm::vec2& offset, int depth, std::vector<Contour>& contours) const {
+	uint32_t start;
+	uint32_t length;
+	if (depth > maxCompositeDepth || !GetGlyphRange(glyph, start, length) || length < 10) {
+		return;
+	}
+
+	int16_t contourCount = ReadS16(start);
+	if (contourCount < 0) {
+		// A composite glyph is made of other glyphs, each with its own transform.
+		uint32_t cursor = start + 10;
+		uint16_t flags;
+		do {
+			flags = ReadU16(cursor);
+			uint16_t part = ReadU16(cursor + 2);
+			cursor += 4;
+			float dx;
+			float dy;
+			if (flags & 0x0001) {
+				dx = ReadS16(cursor);
+				dy = ReadS16(cursor + 2);
+				cursor += 4;
+			} else {
+				dx = static_cast<int8_t>(ReadU8(cursor));
+				dy = static_cast<int8_t>(ReadU8(cursor + 1));
+				cursor += 2;
+			}
+			// Without this flag the arguments are point numbers to line up, which is rare enough to just not move the part.
+			if (!(flags & 0x0002)) {
+				dx = 0.0f;
+				dy = 0.0f;
+			}
+			glm::vec2 partX(1.0f, 0.0f);
+			glm::vec2 partY(0.0f, 1.0f);
+			if (flags & 0x0008) {
+				float scale = ReadS16(cursor) / 16384.0f;
+				partX.x = scale;
+				partY.y = scale;
+				cursor += 2;
+			} else if (flags & 0x0040) {
+				partX.x = ReadS16(cursor) / 16384.0f;
+				partY.y = ReadS16(cursor + 2) / 16384.0f;
+				cursor += 4;
+			} else if (flags & 0x0080) {
+				partX = glm::vec2(ReadS16(cursor), ReadS16(cursor + 2)) / 16384.0f;
+				partY = glm::vec2(ReadS16(cursor + 4), ReadS16(cursor + 6)) / 16384.0f;
+				cursor += 8;
+			}
+			// The part's transform is applied first, then this glyph's.
+			glm::vec2 combinedX = xAxis * partX.x + yAxis * partX.y;
+			glm::vec2 combinedY = xAxis * partY.x + yAxis * partY.y;
+			glm::vec2 combinedOffset = offset + xAxis * dx + yAxis * dy;
+			AddGlyphShape(part, combinedX, combinedY, combinedOffset, depth + 1, contours);
+		} while (flags & 0x0020);
+		return;
+	}
+
+	// A simple glyph lists where each contour ends, then the flags and coordinates of every point.
+	uint32_t endPoints = start + 10;
+	uint16_t pointCount = contourCount > 0 ? ReadU16(endPoints + (contourCount - 1) * 2) + 1 : 0;
+	uint32_t cursor = endPoints + contourCount * 2;
+	cursor += 2 + ReadU16(cursor);
+
+	std::vector<uint8_t> flags(pointCount);
+	for (uint16_t i = 0; i < pointCount;) {
+		uint8_t flag = ReadU8(cursor++);
+		uint8_t repeats = (flag & 0x08) ? ReadU8(cursor++) : 0;
+		for (int repeat = 0; repeat <= repeats && i < pointCount; ++repeat) {
+			flags[i++] = flag;
+		}
+	}
+
+	std::vector<glm::vec2> points(pointCount);
+	// The coordinates are stored as changes from the last point, as either a byte (with the sign in the flags) or a short.
+	for (int axis = 0; axis < 2; ++axis) {
+		uint8_t shortBit = axis == 0 ? 0x02 : 0x04;
+		uint8_t sameBit = axis == 0 ? 0x10 : 0x20;
+		float value = 0.0f;
+		for (uint16_t i = 0; i < pointCount; ++i) {
+			if (flags[i] & shortBit) {
+				float change = ReadU8(cursor++);
+				value += (flags[i] & sameBit) ? change : -change;
+			} else if (!(flags[i] & sameBit)) {
+				value += ReadS16(cursor);
+				cursor += 2;
+			}
+			points[i][axis] = value;
+		}
+	}
+
+	uint16_t first = 0;
+	for (int16_t contour = 0; contour < contourCount; ++contour) {
+		uint16_t last = ReadU16(endPoints + contour * 2);
+		if (last < first || last >= pointCount) {
+			break;
+		}
+		uint16_t count = last - first + 1;
+
+		// Two curve points in a row have an implied point on the curve halfway between them. The contour is started from a
+		// point on the curve, which may have to be one of those.
+		glm::vec2 startPoint;
+		uint16_t startIndex = 0;
+		if (flags[first] & 0x01) {
+			startPoint = points[first];
+			startIndex = 1;
+		} else if (flags[last] & 0x01) {
+			startPoint = points[last];
+		} else {
+			startPoint = (points[first] + points[last]) * 0.5f;
+		}
+
+		Contour outline;
+		outline.push_back(startPoint);
+		glm::vec2 previous = startPoint;
+		bool hasControl = false;
+		glm::vec2 control;
+		for (uint16_t step = 0; step <= count; ++step) {
+			uint16_t index = first + (startIndex + step) % count;
+			bool closing = step == count;
+			glm::vec2 point = closing ? startPoint : points[index];
+			bool onCurve = closing || (flags[index] & 0x01);
+			if (onCurve) {
+				if (hasControl) {
+					for (int i = 1; i <= curveSteps; ++i) {
+						float t = static_cast<float>(i) / curveSteps;
+						outline.push_back((1.0f - t) * (1.0f - t) * previous + 2.0f * (1.0f - t) * t * control + t * t * point);
+					}
+				} else {
+					outline.push_back(point);
+				}
+				previous = point;
+				hasControl = false;
+			} else {
+				if (hasControl) {
+					glm::vec2 middle = (control + point) * 0.5f;
+					for (int i = 1; i <= curveSteps; ++i) {
+						float t = static_cast<float>(i) / curveSteps;
+						outline.push_back((1.0f - t) * (1.0f - t) * previous + 2.0f * (1.0f - t) * t * control + t * t * middle);
+					}
+					previous = middle;
+				}
+				control = point;
+				hasControl = true;
+			}
+		}
+		// The loop ends back at the start, which doesn't need to be stored twice.
+		outline.pop_back();
+
+		for (glm::vec2& point : outline) {
+			point = offset + xAxis * point.x + yAxis * point.y;
+		}
+		if (outline.size() >= 3) {
+			contours.push_back(outline);
+		}
+		first = last + 1;
+	}
+}
+
+bool TrueTypeFont::GetGlyphRange(uint32_t glyph, uint32_t& offset, uint32_t& length) const {
+	if (glyph >= glyphCount) {
+		return false;
+	}
+	uint32_t begin;
+	uint32_t end;
+	if (longLoca) {
+		begin = ReadU32(locaTable + glyph * 4);
+		end = ReadU32(locaTable + glyph * 4 + 4);
+	} else {
+		begin = ReadU16(locaTable + glyph * 2) * 2u;
+		end = ReadU16(locaTable + glyph * 2 + 2) * 2u;
+	}
+	if (end < begin) {
+		return false;
+	}
+	offset = glyfTable + begin;
+	length = end - begin;
+	return true;
+}
+
+uint32_t TrueTypeFont::FindTable(const char* tag) const {
+	uint16_t tableCount = ReadU16(4);
+	for (uint16_t i = 0; i < tableCount; ++i) {
+		uint32_t record = 12 + i * 16;
+		if (record + 16 <= data.size() && std::memcmp(&data[record], tag, 4) == 0) {
+			return ReadU32(record + 8);
+		}
+	}
+	return 0;
+}
+
+// Reads past the end give 0 rather than crashing, so a broken font just gives broken glyphs.
+uint8_t TrueTypeFont::ReadU8(uint32_t offset) const {
+	return offset < data.size() ? data[offset] : 0;
+}
+
+uint16_t TrueTypeFont::ReadU16(uint32_t offset) const {
+	return static_cast<uint16_t>((ReadU8(offset) << 8) | ReadU8(offset + 1));
+}
+
+int16_t TrueTypeFont::ReadS16(uint32_t offset) const {
+	return static_cast<int16_t>(ReadU16(offset));
+}
+
+uint32_t TrueTypeFont::ReadU32(uint32_t offset) const {
+	return (static_cast<uint32_t>(ReadU16(offset)) << 16) | ReadU16(offset + 2);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+/// <summary>
+/// Reads glyph outlines out of a TrueType font file. Only what the glyph atlas needs is read: the character map, the outlines
+/// (including composite glyphs) and the horizontal metrics. Everything is in font units; use GetUnitsPerEm() to scale it.
+/// </summary>
+class TrueTypeFont {
+	public:
+	/// <summary>
+	/// A closed outline, flattened into straight lines. The last point joins back up with the first.
+	/// </summary>
+	typedef std::vector<glm::vec2> Contour;
+
+	TrueTypeFont();
+
+	/// <summary>
+	/// Reads the font's tables. The data is copied, so it doesn't need to outlive the font.
+	/// </summary>
+	/// <param name="fontData">The contents of a .ttf file.</param>
+	/// <returns>Whether the font could be read.</returns>
+	bool Load(const std::vector<uint8_t>& fontData);
+
+	/// <summary>
+	/// Returns the glyph for a character.
+	/// </summary>
+	/// <param name="codepoint">The Unicode codepoint.</param>
+	/// <returns>The glyph index, or 0 (the missing glyph) if the font doesn't have it.</returns>
+	uint32_t GetGlyphIndex(uint32_t codepoint) const;
+
+	/// <summary>
+	/// Returns the outline of a glyph. Curves are split into straight lines.
+	/// </summary>
+	/// <param name="glyph">The glyph index.</param>
+	/// <returns>The contours of the glyph. Spaces and the like have none.</returns>
+	std::vector<Contour> GetGlyphShape(uint32_t glyph) const;
+
+	/// <summary>
+	/// Returns how far to move along after a glyph.
+	/// </summary>
+	/// <param name="glyph">The glyph index.</param>
+	/// <returns>The advance width in font units.</returns>
+	float GetAdvance(uint32_t glyph) const;
+
+	float GetUnitsPerEm() const;
+	float GetAscender() const;
+	float GetDescender() const;
+	float GetLineGap() const;
+
+	private:
+	/// <summary>
+	/// Adds a glyph's contours to the list, moved by the given transform. Composite glyphs call this for each of their parts.
+	/// </summary>
+	void AddGlyphShape(uint32_t glyph, const glm::vec2& xAxis, const glm::vec2& yAxis, const glm::vec2& offset, int depth, std::vector<Contour>& contours) const;
+
+	/// <summary>
+	/// Returns where a glyph's outline is in the glyf table, and how long it is.
+	/// </summary>
+	bool GetGlyphRange(uint32_t glyph, uint32_t& offset, uint32_t& length) const;
+
+	/// <summary>
+	/// Returns where a table starts, or 0 if the font doesn't have it.
+	/// </summary>
+	uint32_t FindTable(const char* tag) const;
+
+	uint8_t ReadU8(uint32_t offset) const;
+	uint16_t ReadU16(uint32_t offset) const;
+	int16_t ReadS16(uint32_t offset) const;
+	uint32_t ReadU32(uint32_t offset) const;
+
+	std::vector<uint8_t> data;
+
+	uint32_t glyfTable;
+	uint32_t locaTable;
+	uint32_t hmtxTable;
+	uint32_t cmapSubtable;
+	uint16_t cmapFormat;
+	bool longLoca;
+	uint32_t glyphCount;
+	uint32_t horizontalMetricCount;
+
+	float unitsPerEm;
+	float ascender;
+	float descender;
+	float lineGap;
+};
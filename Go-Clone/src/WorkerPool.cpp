@@ -0,0 +1,82 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(size_t workerCount) {
+	job = nullptr;
+	jobCount = 0;
+	nextJob = 0;
+	generation = 0;
+	busyWorkers = 0;
+	stopping = false;
+	for (size_t i = 0; i < workerCount; ++i) {
+		threads.push_back(std::thread(&WorkerPool::WorkerLoop, this));
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+void WorkerPool::Run(size_t newJobCount, const std::function<void(size_t)>& newJob) {
+	if (threads.empty() || newJobCount <= 1) {
+		for (size_t i = 0; i < newJobCount; ++i) {
+			newJob(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job = &newJob;
+		jobCount = newJobCount;
+		nextJob = 0;
+		busyWorkers = threads.size();
+		++generation;
+	}
+	wake.notify_all();
+
+	RunJobs();
+
+	// Every worker has to check in, even ones that didn't get a job, so none of them are still looking at this set when the next starts.
+	std::unique_lock<std::mutex> lock(mutex);
+	finished.wait(lock, [this]() { return busyWorkers == 0; });
+	job = nullptr;
+}
+
+size_t WorkerPool::GetThreadCount() const {
+	return threads.size() + 1;
+}
+
+void WorkerPool::WorkerLoop() {
+	uint64_t lastGeneration = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this, lastGeneration]() { return stopping || generation != lastGeneration; });
+			if (stopping) {
+				return;
+			}
+			lastGeneration = generation;
+		}
+
+		RunJobs();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--busyWorkers == 0) {
+			finished.notify_one();
+		}
+	}
+}
+
+void WorkerPool::RunJobs() {
+	size_t index;
+	while ((index = nextJob.fetch_add(1)) < jobCount) {
+		(*job)(index);
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// A fixed set of threads that share out the jobs given to Run(). The thread calling Run() helps with the jobs too,
+/// so a pool with no workers just runs everything on the calling thread.
+/// </summary>
+class WorkerPool {
+	public:
+	/// <summary>
+	/// Starts the given number of worker threads.
+	/// </summary>
+	/// <param name="workerCount">The number of threads to start, not counting the thread that calls Run().</param>
+	WorkerPool(size_t workerCount);
+
+	/// <summary>
+	/// Stops and joins every worker thread.
+	/// </summary>
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/// <summary>
+	/// Calls the job once for every index from 0 to jobCount - 1, spread across the workers and the calling thread.
+	/// This blocks until every job has finished.
+	/// </summary>
+	/// <param name="jobCount">The number of jobs.</param>
+	/// <param name="job">The job, which is given the index of the job to run. It must be safe to call from any thread.</param>
+	void Run(size_t jobCount, const std::function<void(size_t)>& job);
+
+	/// <summary>
+	/// Returns the number of threads that work on jobs, including the one that calls Run().
+	/// </summary>
+	/// <returns>The number of threads that work on jobs.</returns>
+	size_t GetThreadCount() const;
+
+	private:
+	/// <summary>
+	/// What every worker thread runs until the pool is destroyed.
+	/// </summary>
+	void WorkerLoop();
+
+	/// <summary>
+	/// Takes and runs jobs until there are none left.
+	/// </summary>
+	void RunJobs();
+
+	/// <summary>
+	/// The worker threads.
+	/// </summary>
+	std::vector<std::thread> threads;
+
+	/// <summary>
+	/// Guards everything below except nextJob.
+	/// </summary>
+	std::mutex mutex;
+
+	/// <summary>
+	/// Wakes the workers when there's a new set of jobs, or when the pool is stopping.
+	/// </summary>
+	std::condition_variable wake;
+
+	/// <summary>
+	/// Wakes Run() once every worker has finished with the current set of jobs.
+	/// </summary>
+	std::condition_variable finished;
+
+	/// <summary>
+	/// The job being run, or nullptr between calls to Run().
+	/// </summary>
+	const std::function<void(size_t)>* job;
+
+	/// <summary>
+	/// The number of jobs in the current set.
+	/// </summary>
+	size_t jobCount;
+
+	/// <summary>
+	/// The index of the next job to be taken.
+	/// </summary>
+	std::atomic<size_t> nextJob;
+
+	/// <summary>
+	/// Goes up every time Run() is called, so that workers can tell a new set of jobs from one they've already done.
+	/// </summary>
+	uint64_t generation;
+
+	/// <summary>
+	/// The number of workers that haven't finished with the current set of jobs yet.
+	/// </summary>
+	size_t busyWorkers;
+
+	/// <summary>
+	/// Whether the workers should exit.
+	/// </summary>
+	bool stopping;
+};
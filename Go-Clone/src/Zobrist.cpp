@@ -0,0 +1,3 @@
+#include "Zobrist.h"
+
+constexpr ZobristKeys Zobrist::keys;
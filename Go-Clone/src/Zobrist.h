@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Bitboard.h"
+#include "Constants.h"
+
+/// <summary>
+/// Every key, made when compiling from a SplitMix64 sequence with a fixed seed. SplitMix64 is fast and spreads its bits well enough
+/// for hashing.
+/// </summary>
+struct ZobristKeys {
+	constexpr ZobristKeys() : stones(), ko(), whiteToMove(0) {
+		uint64_t state = 0x476F2D436C6F6E65ull;
+		for (uint32_t colour = 0; colour < 2; ++colour) {
+			for (uint32_t point = 0; point < Bitboard::maxPoints; ++point) {
+				stones[colour][point] = NextKey(state);
+			}
+		}
+		for (uint32_t point = 0; point < Bitboard::maxPoints; ++point) {
+			ko[point] = NextKey(state);
+		}
+		whiteToMove = NextKey(state);
+	}
+
+	static constexpr uint64_t NextKey(uint64_t& state) {
+		uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+
+	uint64_t stones[2][Bitboard::maxPoints];
+	uint64_t ko[Bitboard::maxPoints];
+	uint64_t whiteToMove;
+};
+
+/// <summary>
+/// The random keys positions are hashed with. A position's hash is every key of what's in it XORed together, so placing or taking
+/// off a stone only XORs in one key. The keys come from a fixed seed, so the same position hashes the same in every run, and hashes
+/// can be saved alongside games and opening books.
+/// </summary>
+class Zobrist {
+	public:
+	/// <summary>
+	/// Returns the key of a stone of a colour on a point.
+	/// </summary>
+	static uint64_t GetStoneKey(EPlayer player, uint32_t point) {
+		return keys.stones[static_cast<uint32_t>(player) - 1][point];
+	}
+
+	/// <summary>
+	/// Returns the key XORed in when it's white's turn.
+	/// </summary>
+	static uint64_t GetWhiteToMoveKey() {
+		return keys.whiteToMove;
+	}
+
+	/// <summary>
+	/// Returns the key XORed in when a point can't be played on because of a ko.
+	/// </summary>
+	static uint64_t GetKoKey(uint32_t point) {
+		return keys.ko[point];
+	}
+
+	private:
+	static constexpr ZobristKeys keys = ZobristKeys();
+};